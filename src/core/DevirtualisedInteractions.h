@@ -0,0 +1,87 @@
+#ifndef RAMPACK_DEVIRTUALISEDINTERACTIONS_H
+#define RAMPACK_DEVIRTUALISEDINTERACTIONS_H
+
+#include <cstdint>
+#include <utility>
+#include "Interaction.h"
+#include "core/shapes/SphereTraits.h"
+#include "core/shapes/PolysphereTraits.h"
+#include "core/shapes/SpherocylinderTraits.h"
+#include "core/shapes/PolyspherocylinderTraits.h"
+
+
+/**
+ * @brief Concrete types of interactions, whose pair tests are final and defined inline (see
+ * visit_devirtualised_interaction).
+ */
+enum class DevirtualisedInteraction : std::uint8_t {
+    /** @brief Interaction not listed below, which is used through the virtual methods */
+    GENERIC,
+    /** @brief SphereTraits::HardInteraction */
+    SPHERE,
+    /** @brief PolysphereTraits::HardInteraction */
+    POLYSPHERE,
+    /** @brief SpherocylinderTraits */
+    SPHEROCYLINDER,
+    /** @brief PolyspherocylinderTraits */
+    POLYSPHEROCYLINDER
+};
+
+/**
+ * @brief Determines the concrete type of @a interaction using RTTI.
+ * @details The result can be computed once and then passed to visit_devirtualised_interaction for every call.
+ */
+inline DevirtualisedInteraction get_devirtualised_interaction(const Interaction &interaction) {
+    if (dynamic_cast<const SphereTraits::HardInteraction *>(&interaction) != nullptr)
+        return DevirtualisedInteraction::SPHERE;
+    if (dynamic_cast<const PolysphereTraits::HardInteraction *>(&interaction) != nullptr)
+        return DevirtualisedInteraction::POLYSPHERE;
+    if (dynamic_cast<const SpherocylinderTraits *>(&interaction) != nullptr)
+        return DevirtualisedInteraction::SPHEROCYLINDER;
+    if (dynamic_cast<const PolyspherocylinderTraits *>(&interaction) != nullptr)
+        return DevirtualisedInteraction::POLYSPHEROCYLINDER;
+    return DevirtualisedInteraction::GENERIC;
+}
+
+/**
+ * @brief Calls @a visitor with @a interaction cast to its concrete type @a type (which has to be obtained from
+ * get_devirtualised_interaction for the same @a interaction).
+ * @details Packing uses it to instantiate neighbour loops for a concrete interaction. Then pair tests are called
+ * directly and inlined together with the precomputed translation of neighbour grid cell, instead of two virtual calls
+ * per pair (Interaction::overlapBetween and BoundaryConditions::getTranslation). A visitor has to return the same type
+ * for all interactions. It should wrap a whole loop, not a single pair test. Interactions with expensive pair tests
+ * (like XenoCollide-based ones) are not listed, since the cost of the dispatch is negligible for them.
+ */
+template<typename Visitor>
+decltype(auto) visit_devirtualised_interaction(const Interaction &interaction, DevirtualisedInteraction type,
+                                               Visitor &&visitor)
+{
+    switch (type) {
+        case DevirtualisedInteraction::SPHERE:
+            return visitor(static_cast<const SphereTraits::HardInteraction &>(interaction));
+        case DevirtualisedInteraction::POLYSPHERE:
+            return visitor(static_cast<const PolysphereTraits::HardInteraction &>(interaction));
+        case DevirtualisedInteraction::SPHEROCYLINDER:
+            return visitor(static_cast<const SpherocylinderTraits &>(interaction));
+        case DevirtualisedInteraction::POLYSPHEROCYLINDER:
+            return visitor(static_cast<const PolyspherocylinderTraits &>(interaction));
+        case DevirtualisedInteraction::GENERIC:
+            break;
+    }
+    return visitor(interaction);
+}
+
+/**
+ * @brief Calls @a visitor with @a interaction cast to its concrete type if it is one of the interactions, whose pair
+ * tests are final and defined inline. Otherwise, @a visitor is called with @a interaction itself.
+ * @details The type is determined using get_devirtualised_interaction on each call. If the same interaction is
+ * visited many times, the type should be determined once and passed to the overload accepting it.
+ */
+template<typename Visitor>
+decltype(auto) visit_devirtualised_interaction(const Interaction &interaction, Visitor &&visitor) {
+    return visit_devirtualised_interaction(interaction, get_devirtualised_interaction(interaction),
+                                           std::forward<Visitor>(visitor));
+}
+
+
+#endif //RAMPACK_DEVIRTUALISEDINTERACTIONS_H
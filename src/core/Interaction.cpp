@@ -3,6 +3,30 @@
 //
 
 #include "Interaction.h"
+#include "FreeBoundaryConditions.h"
+
+std::size_t Interaction::countOverlapsInBatch(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                              std::size_t idx1, const InteractionBatch &batch, bool earlyExit) const
+{
+    // Periodic translations are already included in positions from the batch
+    FreeBoundaryConditions noTranslation;
+    double range = this->getRangeRadius();
+    double range2 = range * range;
+
+    std::size_t overlapsCounted{};
+    for (std::size_t i{}; i < batch.size(); i++) {
+        if (batch.getDistance2(i) > range2)
+            continue;
+
+        if (this->overlapBetween(pos1, orientation1, idx1, batch.getPosition(i), batch.getOrientation(i),
+                                 batch.getCentre(i), noTranslation))
+        {
+            if (earlyExit) return 1;
+            overlapsCounted++;
+        }
+    }
+    return overlapsCounted;
+}
 
 double Interaction::calculateEnergyBetweenShapes(const Shape &shape1, const Shape &shape2,
                                                  const BoundaryConditions &bc) const
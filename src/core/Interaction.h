@@ -9,6 +9,7 @@
 
 #include "Shape.h"
 #include "BoundaryConditions.h"
+#include "InteractionBatch.h"
 
 /**
  * @brief A class representing the interaction between molecules.
@@ -89,6 +90,52 @@ public:
         return false;
     }
 
+    /**
+     * @brief Returns the number of overlaps between interaction center @a idx1 of a molecule and all interaction
+     * centres in @a batch.
+     * @details The default implementation calls Interaction::overlapBetween for all entries of @a batch closer than
+     * Interaction::getRangeRadius. Interactions with cheap pair tests override it with a loop over the whole batch,
+     * which can be vectorised by the compiler.
+     * @param pos1 position of the interaction center (not the center of particle)
+     * @param orientation1 orientation of the molecule
+     * @param idx1 the index of the interaction center within a molecule
+     * @param batch interaction centres of neighbouring molecules (with boundary conditions already applied)
+     * @param earlyExit if @a true, 1 is returned on the first overlap found
+     * @return the number of overlaps (or 0/1 if @a earlyExit is @a true)
+     */
+    [[nodiscard]] virtual std::size_t countOverlapsInBatch(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                                           std::size_t idx1, const InteractionBatch &batch,
+                                                           bool earlyExit) const;
+
+    /**
+     * @brief Returns @a true, if Interaction::countOverlapsInBatch uses orientations of molecules from the batch.
+     * @details It can be @a false only if Interaction::countOverlapsInBatch is overridden. Then orientations are not
+     * copied into InteractionBatch.
+     */
+    [[nodiscard]] virtual bool needsBatchOrientations() const { return true; }
+
+    /**
+     * @brief The same as Interaction::overlapBetween, but it can use and update @a separatingDirection - a direction,
+     * which separated the same pair of interaction centres in the past.
+     * @details A zero vector means that the direction is not known. If the pair is still separated along
+     * @a separatingDirection, the full overlap test can be skipped. The default implementation ignores
+     * @a separatingDirection and calls Interaction::overlapBetween. The caller is responsible for passing a direction
+     * stored for the same pair and the same order of centres.
+     */
+    [[nodiscard]] virtual bool overlapBetweenWithHint(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                                      std::size_t idx1, const Vector<3> &pos2,
+                                                      const Matrix<3, 3> &orientation2, std::size_t idx2,
+                                                      const BoundaryConditions &bc,
+                                                      [[maybe_unused]] Vector<3> &separatingDirection) const
+    {
+        return this->overlapBetween(pos1, orientation1, idx1, pos2, orientation2, idx2, bc);
+    }
+
+    /**
+     * @brief Returns @a true, if Interaction::overlapBetweenWithHint is overridden and makes use of separating
+     * directions.
+     */
+    [[nodiscard]] virtual bool usesSeparatingDirections() const { return false; }
 
     /**
      * @brief Returns @a true, if a given interaction center overlaps a wall defined by @a wallOrigin and @a wallVector.
@@ -122,6 +169,16 @@ public:
      */
     [[nodiscard]] virtual std::vector<Vector<3>> getInteractionCentres() const { return {}; }
 
+    /**
+     * @brief Returns individual interaction ranges of interaction centres (in the same order as in
+     * Interaction::getInteractionCentres).
+     * @details Interaction centres @a i and @a j (of two different molecules) cease to interact if the distance between
+     * them is larger than the sum of their ranges. The ranges cannot be larger than half of
+     * Interaction::getRangeRadius. An empty list (default) means that all ranges are equal to the half of
+     * Interaction::getRangeRadius. The information is used to speed up neighbour searching if centres differ in size.
+     */
+    [[nodiscard]] virtual std::vector<double> getInteractionCentreRanges() const { return {}; }
+
     /**
      * @brief Returns a distance at which two molecules cease to interact (opposed to Interaction::getRangeRadius which
      * applies to a single pair of interaction centers).
@@ -0,0 +1,118 @@
+#ifndef RAMPACK_INTERACTIONBATCH_H
+#define RAMPACK_INTERACTIONBATCH_H
+
+#include <vector>
+
+#include "geometry/Vector.h"
+#include "geometry/Matrix.h"
+#include "utils/AlignedAllocator.h"
+
+
+/**
+ * @brief A packed list of interaction centres of neighbouring particles, which are tested against a single interaction
+ * centre in one call of Interaction::countOverlapsInBatch.
+ * @details Positions already include the periodic translations, so boundary conditions are not needed any more. They
+ * are stored as separate arrays of coordinates, so that squared distances to the tested centre can be calculated in a
+ * single, vectorised loop (InteractionBatch::calculateDistances2) before the batch is passed to an interaction.
+ * Orientations are stored only if the batch was reset with @a withOrientations = @a true - interactions of spherical
+ * centres do not use them (see Interaction::needsBatchOrientations).
+ */
+class InteractionBatch {
+private:
+    AlignedVector<double> x;
+    AlignedVector<double> y;
+    AlignedVector<double> z;
+    AlignedVector<double> distances2;
+    std::vector<std::size_t> centres;
+    std::vector<Matrix<3, 3>> orientations;
+    bool withOrientations = true;
+    bool commonCentre = true;
+
+public:
+    /**
+     * @brief Removes all entries, keeping the allocated memory.
+     * @param withOrientations_ if @a true, InteractionBatch::add has to be given orientations
+     */
+    void reset(bool withOrientations_) {
+        this->x.clear();
+        this->y.clear();
+        this->z.clear();
+        this->distances2.clear();
+        this->centres.clear();
+        this->orientations.clear();
+        this->withOrientations = withOrientations_;
+        this->commonCentre = true;
+    }
+
+    /**
+     * @brief Adds an interaction centre with index @a centre placed in @a position (already translated by boundary
+     * conditions). It can be used only if the batch is not storing orientations.
+     */
+    void add(const Vector<3> &position, std::size_t centre) {
+        if (!this->centres.empty() && this->centres.front() != centre)
+            this->commonCentre = false;
+        this->x.push_back(position[0]);
+        this->y.push_back(position[1]);
+        this->z.push_back(position[2]);
+        this->centres.push_back(centre);
+    }
+
+    /**
+     * @brief Adds an interaction centre with index @a centre placed in @a position (already translated by boundary
+     * conditions) of a molecule with orientation @a orientation.
+     */
+    void add(const Vector<3> &position, std::size_t centre, const Matrix<3, 3> &orientation) {
+        this->add(position, centre);
+        if (this->withOrientations)
+            this->orientations.push_back(orientation);
+    }
+
+    /**
+     * @brief Calculates squared distances between @a origin and all entries.
+     * @details It has to be called after all entries are added and before the batch is used.
+     */
+    void calculateDistances2(const Vector<3> &origin) {
+        std::size_t batchSize = this->size();
+        this->distances2.resize(batchSize);
+        const double *xs = this->x.data();
+        const double *ys = this->y.data();
+        const double *zs = this->z.data();
+        double *ds = this->distances2.data();
+        #pragma omp simd
+        for (std::size_t i = 0; i < batchSize; i++) {
+            double dx = xs[i] - origin[0];
+            double dy = ys[i] - origin[1];
+            double dz = zs[i] - origin[2];
+            ds[i] = dx*dx + dy*dy + dz*dz;
+        }
+    }
+
+    [[nodiscard]] std::size_t size() const { return this->centres.size(); }
+    [[nodiscard]] bool empty() const { return this->centres.empty(); }
+
+    /**
+     * @brief Returns @a true if orientations are stored in the batch.
+     */
+    [[nodiscard]] bool hasOrientations() const { return this->withOrientations; }
+
+    /**
+     * @brief Returns @a true if all entries have the same interaction centre index (for example if molecules have
+     * only a single interaction centre).
+     */
+    [[nodiscard]] bool hasCommonCentre() const { return this->commonCentre; }
+
+    [[nodiscard]] const double *getX() const { return this->x.data(); }
+    [[nodiscard]] const double *getY() const { return this->y.data(); }
+    [[nodiscard]] const double *getZ() const { return this->z.data(); }
+    [[nodiscard]] const double *getDistances2() const { return this->distances2.data(); }
+    [[nodiscard]] const std::size_t *getCentres() const { return this->centres.data(); }
+    [[nodiscard]] const Matrix<3, 3> *getOrientations() const { return this->orientations.data(); }
+
+    [[nodiscard]] Vector<3> getPosition(std::size_t i) const { return {this->x[i], this->y[i], this->z[i]}; }
+    [[nodiscard]] double getDistance2(std::size_t i) const { return this->distances2[i]; }
+    [[nodiscard]] std::size_t getCentre(std::size_t i) const { return this->centres[i]; }
+    [[nodiscard]] const Matrix<3, 3> &getOrientation(std::size_t i) const { return this->orientations[i]; }
+};
+
+
+#endif //RAMPACK_INTERACTIONBATCH_H
@@ -5,6 +5,9 @@
 
 #include <algorithm>
 #include <numeric>
+#include <functional>
+#include <cmath>
+#include <limits>
 
 #include "NeighbourGrid.h"
 #include "utils/Utils.h"
@@ -26,8 +29,8 @@ std::size_t NeighbourGrid::positionToCellNo(const Vector<3> &position) const {
             relativePosI = 1 - EPSILON;
         }
 
-        // +1, since first row of cells on each edges is "reflected", not "real"
-        std::size_t coord = static_cast<int>(relativePosI / this->relativeCellSize[i]) + 1;
+        // +reflectedLayers, since first rows of cells on each edges are "reflected", not "real"
+        std::size_t coord = static_cast<int>(relativePosI / this->relativeCellSize[i]) + this->reflectedLayers;
         result = this->cellDivisions[i] * result + coord;
     }
     return result;
@@ -52,27 +55,14 @@ std::size_t NeighbourGrid::coordinatesToCellNo(const std::array<std::size_t, 3>
 std::size_t NeighbourGrid::realCoordinatesToCellNo(const std::array<std::size_t, 3> &coords) const {
     std::size_t result{};
     for (int i = 2; i >= 0; i--)
-        result = this->cellDivisions[i] * result + coords[i] + 1;
-    return result;
-}
-
-std::size_t NeighbourGrid::cellNeighbourToCellNo(const std::array<std::size_t, 3> &coords,
-                                                 const std::array<int, 3> &neighbour) const
-{
-    std::size_t result{};
-    for (int i = 2; i >= 0; i--) {
-        // -1, because neighbour array goes from 0 to 2, and real offsets are from -1 to 1
-        std::size_t ix = coords[i] + neighbour[i] - 1;
-        Assert(ix < this->cellDivisions[i]);
-        result = this->cellDivisions[i] * result + ix;
-    }
+        result = this->cellDivisions[i] * result + coords[i] + this->reflectedLayers;
     return result;
 }
 
 bool NeighbourGrid::isCellReflected(std::size_t cellNo) const {
     std::array<std::size_t, 3> coords = this->cellNoToCoordinates(cellNo);
     for (std::size_t i{}; i < 3; i++)
-        if (coords[i] == 0 || coords[i] == this->cellDivisions[i] - 1)
+        if (coords[i] < this->reflectedLayers || coords[i] >= this->cellDivisions[i] - this->reflectedLayers)
             return true;
     return false;
 }
@@ -86,11 +76,12 @@ std::pair<std::size_t, std::size_t> NeighbourGrid::getReflectedCellData(std::siz
     transCoord.fill(1);
     for (std::size_t i{}; i < 3; i++) {
         std::size_t &coord = coords[i];
-        if (coord == 0) {
-            coord = this->cellDivisions[i] - 2;
+        std::size_t realCells = this->cellDivisions[i] - 2*this->reflectedLayers;
+        if (coord < this->reflectedLayers) {
+            coord += realCells;
             transCoord[i] = 0;
-        } else if (coord == this->cellDivisions[i] - 1) {
-            coord = 1;
+        } else if (coord >= this->cellDivisions[i] - this->reflectedLayers) {
+            coord -= realCells;
             transCoord[i] = 2;
         }
     }
@@ -99,37 +90,123 @@ std::pair<std::size_t, std::size_t> NeighbourGrid::getReflectedCellData(std::siz
     return std::make_pair(this->coordinatesToCellNo(coords), transIdx);
 }
 
-bool NeighbourGrid::increment(std::array<int, 3> &in) {
-    for (std::size_t i{}; i < 3; i++) {
-        in[i]++;
-        if (in[i] > 2 && i < 2)
-            in[i] = 0;
-        else
-            break;
+double NeighbourGrid::calculateMinimalCellDistance2(const std::array<int, 3> &offset) const {
+    // A difference between points from the cell (0, 0, 0) and the one shifted by offset is sum_i t_i edges[i], where
+    // t_i lies in [offset[i] - 1, offset[i] + 1]. The minimum of this convex quadratic function is inside one of 27
+    // faces of the box of t_i (including its interior and vertices), where each t_i is either free or fixed at one of
+    // the bounds. Thus, the function is minimized on each face separately and minima lying inside the box are compared
+    std::array<Vector<3>, 3> edges;
+    for (std::size_t i{}; i < 3; i++)
+        edges[i] = this->boxSides[i] * this->relativeCellSize[i];
+
+    double minDistance2 = std::numeric_limits<double>::infinity();
+    for (std::size_t face{}; face < 27; face++) {
+        // 0 - free, 1 - fixed at the lower bound, 2 - fixed at the upper bound
+        std::array<std::size_t, 3> bounds = {face % 3, (face / 3) % 3, face / 9};
+        std::array<double, 3> t{};
+        std::array<std::size_t, 3> freeIdxs{};
+        std::size_t numFree{};
+        Vector<3> fixedPart;
+        for (std::size_t i{}; i < 3; i++) {
+            if (bounds[i] == 0) {
+                freeIdxs[numFree++] = i;
+            } else {
+                t[i] = offset[i] + (bounds[i] == 1 ? -1 : 1);
+                fixedPart += t[i] * edges[i];
+            }
+        }
+
+        // Normal equations for free t_i - the matrix is positive definite, so Gaussian elimination needs no pivoting
+        std::array<std::array<double, 4>, 3> equations{};
+        for (std::size_t a{}; a < numFree; a++) {
+            for (std::size_t b{}; b < numFree; b++)
+                equations[a][b] = edges[freeIdxs[a]] * edges[freeIdxs[b]];
+            equations[a][3] = -(edges[freeIdxs[a]] * fixedPart);
+        }
+        for (std::size_t a{}; a < numFree; a++) {
+            for (std::size_t b = a + 1; b < numFree; b++) {
+                double factor = equations[b][a] / equations[a][a];
+                for (std::size_t c = a; c < 4; c++)
+                    equations[b][c] -= factor * equations[a][c];
+            }
+        }
+
+        bool insideBox = true;
+        for (std::size_t a = numFree; a-- > 0;) {
+            double rhs = equations[a][3];
+            for (std::size_t b = a + 1; b < numFree; b++)
+                rhs -= equations[a][b] * t[freeIdxs[b]];
+            std::size_t i = freeIdxs[a];
+            t[i] = rhs / equations[a][a];
+            if (t[i] < offset[i] - 1 || t[i] > offset[i] + 1)
+                insideBox = false;
+        }
+        if (!insideBox)
+            continue;
+
+        Vector<3> difference;
+        for (std::size_t i{}; i < 3; i++)
+            difference += t[i] * edges[i];
+        minDistance2 = std::min(minDistance2, difference.norm2());
     }
-    return in[2] <= 2;
+    return minDistance2;
 }
 
 void NeighbourGrid::fillNeighbouringCellsOffsets() {
-    // 3 x 3 neighbours
-    this->neighbouringCellsOffsets.clear();
-    this->neighbouringCellsOffsets.reserve(27);
-    this->positiveNeighbouringCellsOffsets.clear();
-    this->positiveNeighbouringCellsOffsets.reserve(13);
-
     // We are taking the cell somewhere in the middle and computing offsets in cell list to all of its neighbours
-    std::array<int, 3> neighbour{};
     std::array<std::size_t, 3> testCellCoords{};
-    neighbour.fill(0);
     for (std::size_t i{}; i < 3; i++)
         testCellCoords[i] = this->cellDivisions[i] / 2;
     std::size_t testCellNo = this->coordinatesToCellNo(testCellCoords);
-    do {
-        std::size_t neigbourNo = this->cellNeighbourToCellNo(testCellCoords, neighbour);
-        this->neighbouringCellsOffsets.push_back(neigbourNo - testCellNo);
-        if (9*neighbour[0] + 3*neighbour[1] + neighbour[2] > 13)
-            this->positiveNeighbouringCellsOffsets.push_back(neigbourNo - testCellNo);
-    } while(increment(neighbour));
+
+    // Cells at most 1 layer away touch the test cell, the distance to other ones is computed once for the largest cube
+    auto maxLayers = static_cast<int>(this->reflectedLayers);
+    std::size_t cubeSide = 2*maxLayers + 1;
+    auto cubeIdx = [cubeSide, maxLayers](int i, int j, int k) {
+        return ((i + maxLayers)*cubeSide + (j + maxLayers))*cubeSide + (k + maxLayers);
+    };
+    std::vector<double> distances2(cubeSide*cubeSide*cubeSide);
+    for (int i = -maxLayers; i <= maxLayers; i++)
+        for (int j = -maxLayers; j <= maxLayers; j++)
+            for (int k = -maxLayers; k <= maxLayers; k++)
+                if (std::max({std::abs(i), std::abs(j), std::abs(k)}) > 1)
+                    distances2[cubeIdx(i, j, k)] = this->calculateMinimalCellDistance2({i, j, k});
+
+    // The stencil for a given number of layers contains only the cells which may have points closer than
+    // layers * requestedCellSize / cellSubdivisions to some point of the test cell - the rest of the cube of
+    // (2*layers + 1)^3 cells is pruned. For a single layer these are all 27 nearest cells
+    static constexpr double DISTANCE_EPSILON = 1 + 1e-10;
+    double nominalCellSize = this->requestedCellSize / static_cast<double>(this->cellSubdivisions);
+    this->extendedNeighbouringCellsOffsets.clear();
+    this->neighbouringCellsOffsets.clear();
+    this->positiveNeighbouringCellsOffsets.clear();
+    for (std::size_t layers = 1; layers <= this->reflectedLayers; layers++) {
+        auto &offsets = this->extendedNeighbouringCellsOffsets.emplace_back();
+        auto range = static_cast<int>(layers);
+        double maxDistance = static_cast<double>(layers) * nominalCellSize;
+        double maxDistance2 = maxDistance * maxDistance * DISTANCE_EPSILON;
+        for (int i = -range; i <= range; i++) {
+            for (int j = -range; j <= range; j++) {
+                for (int k = -range; k <= range; k++) {
+                    if (distances2[cubeIdx(i, j, k)] >= maxDistance2)
+                        continue;
+
+                    std::array<std::size_t, 3> neighbourCoords = {testCellCoords[0] + i, testCellCoords[1] + j,
+                                                                  testCellCoords[2] + k};
+                    std::size_t offset = this->coordinatesToCellNo(neighbourCoords) - testCellNo;
+                    offsets.push_back(offset);
+                    // Neighbouring cells span cellSubdivisions layers, which gives the requested cell size. Positive
+                    // ones have the first non-zero coordinate positive
+                    if (layers != this->cellSubdivisions)
+                        continue;
+                    this->neighbouringCellsOffsets.push_back(offset);
+                    if (i > 0 || (i == 0 && j > 0) || (i == 0 && j == 0 && k > 0))
+                        this->positiveNeighbouringCellsOffsets.push_back(offset);
+                }
+            }
+        }
+        std::sort(offsets.begin(), offsets.end());
+    }
 
     // sort and erase to avoid duplicates - important for small packings
     std::sort( this->neighbouringCellsOffsets.begin(), this->neighbouringCellsOffsets.end());
@@ -142,10 +219,22 @@ void NeighbourGrid::fillNeighbouringCellsOffsets() {
                                          this->positiveNeighbouringCellsOffsets.end());
 }
 
-NeighbourGrid::NeighbourGrid(const TriclinicBox& box, double cellSize, std::size_t numParticles) : box{box} {
+NeighbourGrid::NeighbourGrid(const TriclinicBox &box, double cellSize, std::size_t numParticles)
+        : NeighbourGrid(box, cellSize, numParticles, 1, 1)
+{ }
+
+NeighbourGrid::NeighbourGrid(const TriclinicBox &box, double cellSize, std::size_t numParticles,
+                             std::size_t reflectedLayers, std::size_t cellSubdivisions)
+        : box{box}, reflectedLayers{reflectedLayers}, cellSubdivisions{cellSubdivisions}
+{
+    Expects(cellSubdivisions >= 1);
+    Expects(reflectedLayers >= cellSubdivisions);
+    ExpectsMsg(numParticles < NOT_PRESENT, "Too many objects for a neighbour grid");
     this->setupSizes(box, cellSize);
-    this->cellHeads.resize(this->numCells);
-    std::fill(this->cellHeads.begin(), this->cellHeads.end(), LIST_END);
+    this->cellOffsets.resize(this->numCells);
+    this->cellSizes.resize(this->numCells);
+    this->cellCapacities.resize(this->numCells);
+    this->overflowDirectory.resize(OVERFLOW_DIRECTORY_SIZE);
     this->translationIndices.resize(this->numCells);
     this->reflectedCells.resize(this->numCells);
 
@@ -154,12 +243,15 @@ NeighbourGrid::NeighbourGrid(const TriclinicBox& box, double cellSize, std::size
         std::fill(this->cellOwningThreads.begin(), this->cellOwningThreads.end(), LIST_END);
     #endif
 
-    this->successors.resize(numParticles);
-    std::fill(this->successors.begin(), this->successors.end(), NeighbourGrid::LIST_END);
+    this->objectCells.resize(numParticles, NOT_PRESENT);
+    this->objectSlots.resize(numParticles);
 
     // Aliasing "reflected" cell lists to real ones
-    for (std::size_t i{}; i < this->numCells; i++)
-        std::tie(this->reflectedCells[i], this->translationIndices[i]) = this->getReflectedCellData(i);
+    for (std::size_t i{}; i < this->numCells; i++) {
+        auto [reflectedCell, translationIdx] = this->getReflectedCellData(i);
+        this->reflectedCells[i] = static_cast<std::uint32_t>(reflectedCell);
+        this->translationIndices[i] = static_cast<std::uint8_t>(translationIdx);
+    }
 
     this->fillNeighbouringCellsOffsets();
 }
@@ -179,25 +271,39 @@ void NeighbourGrid::setupSizes(const TriclinicBox& newBox, double newCellSize) {
     Expects(newBox.getVolume() > 0);
     Expects(newCellSize > 0);
 
-    auto newBoxSides = newBox.getSides();
-    auto newBoxHeights = newBox.getHeights();
-
-    // 2 additional cells on both edges - "reflected" cells - are used by periodic boundary conditions
-    std::array<std::size_t, 3> cellDivisions_{};
-    for (std::size_t i{}; i < 3; i++) {
-        cellDivisions_[i] = static_cast<std::size_t>(floor(newBoxHeights[i] / newCellSize)) + 2;
-        ExpectsMsg(cellDivisions_[i] >= 3, "Neighbour grid cell too big");
-    }
+    std::array<std::size_t, 3> cellDivisions_ = NeighbourGrid::calculateCellDivisions(newBox, newCellSize,
+                                                                                      this->reflectedLayers,
+                                                                                      this->cellSubdivisions);
+    // There should be at least as many real cells as reflected layers
+    for (std::size_t i{}; i < 3; i++)
+        ExpectsMsg(cellDivisions_[i] >= 3*this->reflectedLayers, "Neighbour grid cell too big");
 
     this->box = newBox;
-    this->boxSides = newBoxSides;
+    this->boxSides = newBox.getSides();
+    this->requestedCellSize = newCellSize;
     this->cellDivisions = cellDivisions_;
     for (std::size_t i{}; i < 3; i++)
-        this->relativeCellSize[i] = 1 / static_cast<double>(this->cellDivisions[i] - 2);
+        this->relativeCellSize[i] = 1 / static_cast<double>(this->cellDivisions[i] - 2*this->reflectedLayers);
     this->calculateTranslations();
     this->numCells = static_cast<std::size_t>(
         std::accumulate(this->cellDivisions.begin(), this->cellDivisions.end(), 1., std::multiplies<>{})
     );
+    ExpectsMsg(this->numCells < NOT_PRESENT, "Too many neighbour grid cells");
+}
+
+std::array<std::size_t, 3> NeighbourGrid::calculateCellDivisions(const TriclinicBox &newBox, double newCellSize,
+                                                                 std::size_t reflectedLayers,
+                                                                 std::size_t cellSubdivisions)
+{
+    auto newBoxHeights = newBox.getHeights();
+
+    // Additional layers of cells on both edges - "reflected" cells - are used by periodic boundary conditions
+    std::array<std::size_t, 3> cellDivisions_{};
+    for (std::size_t i{}; i < 3; i++) {
+        auto realDivisions = static_cast<std::size_t>(floor(newBoxHeights[i] / newCellSize)) * cellSubdivisions;
+        cellDivisions_[i] = realDivisions + 2*reflectedLayers;
+    }
+    return cellDivisions_;
 }
 
 void NeighbourGrid::calculateTranslations() {
@@ -222,8 +328,7 @@ void NeighbourGrid::add(std::size_t idx, const Vector<3> &position) {
         this->sanitizeRaceCondition(i, "NeighbourGrid::add(idx, position)");
     #endif
 
-    this->successors[idx] = this->cellHeads[i];
-    this->cellHeads[i] = idx;
+    this->link(idx, i);
 }
 
 void NeighbourGrid::add(std::size_t idx, std::size_t cellNo) {
@@ -231,8 +336,168 @@ void NeighbourGrid::add(std::size_t idx, std::size_t cellNo) {
         this->sanitizeRaceCondition(cellNo, "NeighbourGrid::add(idx, cellNo)");
     #endif
 
-    this->successors[idx] = this->cellHeads[cellNo];
-    this->cellHeads[cellNo] = idx;
+    this->link(idx, cellNo);
+}
+
+void NeighbourGrid::link(std::size_t idx, std::size_t cellNo) {
+    if (this->cellSizes[cellNo] == this->cellCapacities[cellNo])
+        this->growCell(cellNo);
+    std::uint32_t slot = this->cellSizes[cellNo]++;
+    this->getSlot(this->cellOffsets[cellNo])[slot] = static_cast<std::uint32_t>(idx);
+    this->objectCells[idx] = static_cast<std::uint32_t>(cellNo);
+    this->objectSlots[idx] = slot;
+}
+
+void NeighbourGrid::growCell(std::size_t cellNo) {
+    std::size_t oldCapacity = this->cellCapacities[cellNo];
+    // There are less than NOT_PRESENT = MAX_CELL_CAPACITY objects, so a full cell can always grow
+    std::size_t newCapacity = std::min(std::max<std::size_t>(2*oldCapacity, 2), MAX_CELL_CAPACITY);
+
+    std::uint32_t newOffset{};
+    // Only the allocation has to be synchronized - cells being grown are distinct for different threads
+    #pragma omp critical(NeighbourGrid_allocateOverflowSlots)
+    newOffset = this->allocateOverflowSlots(newCapacity);
+
+    std::size_t size = this->cellSizes[cellNo];
+    if (size > 0) {
+        const std::uint32_t *oldBegin = this->getCellBegin(cellNo);
+        std::copy(oldBegin, oldBegin + size, this->getSlot(newOffset));
+    }
+    this->cellOffsets[cellNo] = newOffset;
+    this->cellCapacities[cellNo] = static_cast<std::uint32_t>(newCapacity);
+}
+
+std::uint32_t NeighbourGrid::allocateOverflowSlots(std::size_t numSlots) {
+    // Segments never cross page boundaries. If a segment is larger than a page, it gets a single block spanning the
+    // appropriate number of page indices.
+    // The method is run by worker threads during molecule moves, so it must not fail. The directory covers all slots
+    // addressable by 32-bit offsets, so the only limit is the slot space itself - exhausting it would require 16 GB of
+    // cell storage in a single grid, so the memory runs out earlier
+    std::size_t pageIdx = this->overflowSlotsUsed >> OVERFLOW_PAGE_BITS;
+    std::size_t pageFill = this->overflowSlotsUsed & (OVERFLOW_PAGE_SIZE - 1);
+    if (pageFill != 0 && pageFill + numSlots > OVERFLOW_PAGE_SIZE) {
+        pageIdx++;
+        pageFill = 0;
+        this->overflowSlotsUsed = pageIdx << OVERFLOW_PAGE_BITS;
+    }
+
+    if (pageFill == 0) {
+        std::size_t numPages = (numSlots + OVERFLOW_PAGE_SIZE - 1) >> OVERFLOW_PAGE_BITS;
+        auto &block = this->overflowDirectory[pageIdx >> OVERFLOW_BLOCK_BITS];
+        if (block == nullptr) {
+            block = std::make_unique<std::unique_ptr<std::uint32_t[]>[]>(OVERFLOW_BLOCK_SIZE);
+            this->overflowBlocksAllocated++;
+        }
+        block[pageIdx & (OVERFLOW_BLOCK_SIZE - 1)] = std::make_unique<std::uint32_t[]>(numPages * OVERFLOW_PAGE_SIZE);
+        this->overflowPagesAllocated += numPages;
+        if (numPages > 1) {
+            std::size_t slotIdx = this->baseStorage.size() + this->overflowSlotsUsed;
+            this->overflowSlotsUsed = (pageIdx + numPages) << OVERFLOW_PAGE_BITS;
+            return static_cast<std::uint32_t>(slotIdx);
+        }
+    }
+
+    std::size_t slotIdx = this->baseStorage.size() + this->overflowSlotsUsed;
+    this->overflowSlotsUsed += numSlots;
+    return static_cast<std::uint32_t>(slotIdx);
+}
+
+void NeighbourGrid::build(const std::vector<std::pair<std::size_t, std::size_t>> &objects, std::size_t numThreads) {
+    this->clear();
+
+    // Counting sort - count the objects in cells, lay out the cells and scatter the objects
+    std::vector<std::uint32_t> counts(this->numCells);
+    #pragma omp parallel for default(none) shared(objects, counts) num_threads(numThreads)
+    for (std::size_t i = 0; i < objects.size(); i++) {
+        auto [idx, cellNo] = objects[i];
+        Assert(cellNo < this->numCells);
+        #pragma omp atomic
+        counts[cellNo]++;
+        this->objectCells[idx] = static_cast<std::uint32_t>(cellNo);
+    }
+
+    this->layOutCells(counts);
+
+    std::fill(counts.begin(), counts.end(), 0);
+    #pragma omp parallel for default(none) shared(objects, counts) num_threads(numThreads)
+    for (std::size_t i = 0; i < objects.size(); i++) {
+        auto [idx, cellNo] = objects[i];
+        std::uint32_t memberIdx{};
+        #pragma omp atomic capture
+        memberIdx = counts[cellNo]++;
+        this->baseStorage[this->cellOffsets[cellNo] + memberIdx] = static_cast<std::uint32_t>(idx);
+    }
+
+    // The order of scattered objects is nondeterministic - sort the cells in the increasing order of identifiers,
+    // which is the order produced by sequential adding
+    #pragma omp parallel for default(none) num_threads(numThreads)
+    for (std::size_t cellNo = 0; cellNo < this->numCells; cellNo++) {
+        auto cellBegin = this->baseStorage.begin() + this->cellOffsets[cellNo];
+        std::sort(cellBegin, cellBegin + this->cellSizes[cellNo]);
+        for (std::uint32_t slot{}; slot < this->cellSizes[cellNo]; slot++)
+            this->objectSlots[cellBegin[slot]] = slot;
+    }
+}
+
+void NeighbourGrid::layOutCells(const std::vector<std::uint32_t> &newCellSizes) {
+    this->resetStorage();
+
+    // Only real cells store the objects
+    std::size_t totalCapacity{};
+    for (std::size_t cellNo{}; cellNo < this->numCells; cellNo++) {
+        std::size_t size = newCellSizes[cellNo];
+        ExpectsMsg(size <= MAX_CELL_CAPACITY, "Too many objects in a neighbour grid cell");
+        std::size_t capacity{};
+        if (this->reflectedCells[cellNo] == cellNo)
+            capacity = std::min(NeighbourGrid::calculateCapacity(size), MAX_CELL_CAPACITY);
+        this->cellOffsets[cellNo] = static_cast<std::uint32_t>(totalCapacity);
+        this->cellSizes[cellNo] = static_cast<std::uint32_t>(size);
+        this->cellCapacities[cellNo] = static_cast<std::uint32_t>(capacity);
+        totalCapacity += capacity;
+    }
+    ExpectsMsg(totalCapacity < NOT_PRESENT, "Too many objects for a neighbour grid");
+
+    this->baseStorage.resize(totalCapacity);
+}
+
+void NeighbourGrid::resetStorage() {
+    std::fill(this->cellOffsets.begin(), this->cellOffsets.end(), 0);
+    std::fill(this->cellSizes.begin(), this->cellSizes.end(), 0);
+    std::fill(this->cellCapacities.begin(), this->cellCapacities.end(), 0);
+    this->baseStorage.clear();
+    for (auto &block : this->overflowDirectory)
+        block.reset();
+    this->overflowSlotsUsed = 0;
+    this->overflowPagesAllocated = 0;
+    this->overflowBlocksAllocated = 0;
+}
+
+bool NeighbourGrid::compactIfNeeded(std::size_t numThreads) {
+    if (this->overflowSlotsUsed <= std::max(this->baseStorage.size() / 2, OVERFLOW_PAGE_SIZE))
+        return false;
+
+    // Objects are gathered into a temporary flat array, cells are laid out again and the objects are copied back
+    std::vector<std::uint32_t> counts(this->cellSizes.begin(), this->cellSizes.begin() + this->numCells);
+    std::vector<std::size_t> flatOffsets(this->numCells + 1);
+    for (std::size_t cellNo{}; cellNo < this->numCells; cellNo++)
+        flatOffsets[cellNo + 1] = flatOffsets[cellNo] + counts[cellNo];
+    std::vector<std::uint32_t> flat(flatOffsets.back());
+
+    #pragma omp parallel for default(none) shared(flat, flatOffsets) num_threads(numThreads)
+    for (std::size_t cellNo = 0; cellNo < this->numCells; cellNo++) {
+        const std::uint32_t *cellBegin = this->getCellBegin(cellNo);
+        std::copy(cellBegin, cellBegin + this->cellSizes[cellNo], flat.begin() + flatOffsets[cellNo]);
+    }
+
+    this->layOutCells(counts);
+
+    #pragma omp parallel for default(none) shared(flat, flatOffsets) num_threads(numThreads)
+    for (std::size_t cellNo = 0; cellNo < this->numCells; cellNo++) {
+        std::copy(flat.begin() + flatOffsets[cellNo], flat.begin() + flatOffsets[cellNo + 1],
+                  this->baseStorage.begin() + this->cellOffsets[cellNo]);
+    }
+
+    return true;
 }
 
 void NeighbourGrid::remove(std::size_t idx, const Vector<3> &position) {
@@ -241,41 +506,71 @@ void NeighbourGrid::remove(std::size_t idx, const Vector<3> &position) {
         this->sanitizeRaceCondition(i, "NeighbourGrid::remove(idx, position)");
     #endif
 
-    std::size_t head = this->cellHeads[i];
-    if (head == idx) {
-        this->cellHeads[i] = this->successors[idx];
-        this->successors[idx] = LIST_END;
-    } else {
-        while (head != LIST_END) {
-            if (this->successors[head] == idx) {
-                this->successors[head] = this->successors[idx];
-                this->successors[idx] = LIST_END;
-                break;
-            }
-            head = this->successors[head];
-        }
-    }
+    if (this->objectCells[idx] == i)
+        this->unlink(idx, i);
+}
+
+void NeighbourGrid::remove(std::size_t idx) {
+    std::size_t i = this->objectCells[idx];
+    if (i == NOT_PRESENT)
+        return;
+
+    #ifdef NG_SANITIZE_RACE_CONDITION
+        this->sanitizeRaceCondition(i, "NeighbourGrid::remove(idx)");
+    #endif
+
+    this->unlink(idx, i);
+}
+
+void NeighbourGrid::unlink(std::size_t idx, std::size_t cellNo) {
+    std::uint32_t *cellBegin = this->getSlot(this->cellOffsets[cellNo]);
+    std::uint32_t slot = this->objectSlots[idx];
+    Assert(slot < this->cellSizes[cellNo] && cellBegin[slot] == idx);
+    // The last member takes the place of the removed one
+    std::uint32_t lastIdx = cellBegin[--this->cellSizes[cellNo]];
+    cellBegin[slot] = lastIdx;
+    this->objectSlots[lastIdx] = slot;
+    this->objectCells[idx] = NOT_PRESENT;
+}
+
+bool NeighbourGrid::move(std::size_t idx, const Vector<3> &newPosition) {
+    return this->move(idx, this->positionToCellNo(newPosition));
+}
+
+bool NeighbourGrid::move(std::size_t idx, std::size_t newCellNo) {
+    std::size_t oldCellNo = this->objectCells[idx];
+    Expects(oldCellNo != NOT_PRESENT);
+    if (oldCellNo == newCellNo)
+        return false;
+
+    #ifdef NG_SANITIZE_RACE_CONDITION
+        this->sanitizeRaceCondition(oldCellNo, "NeighbourGrid::move(idx, newCellNo)");
+        this->sanitizeRaceCondition(newCellNo, "NeighbourGrid::move(idx, newCellNo)");
+    #endif
+
+    this->unlink(idx, oldCellNo);
+    this->link(idx, newCellNo);
+    return true;
 }
 
 void NeighbourGrid::clear() {
-    std::fill(this->cellHeads.begin(), this->cellHeads.end(), LIST_END);
+    // Layout of cells is preserved, so that they do not have to be grown again when refilled
+    std::fill(this->cellSizes.begin(), this->cellSizes.end(), 0);
     std::fill(this->cellOwningThreads.begin(), this->cellOwningThreads.end(), LIST_END);
-    std::fill(this->successors.begin(), this->successors.end(), LIST_END);
+    std::fill(this->objectCells.begin(), this->objectCells.end(), NOT_PRESENT);
 }
 
 NeighbourGrid::CellView NeighbourGrid::getCell(const Vector<3> &position) const {
     std::size_t i = this->positionToCellNo(position);
-    std::size_t head = this->cellHeads[i];
-    return CellView(*this, head);
+    return CellView(this->getCellBegin(i), this->cellSizes[i]);
 }
 
 NeighbourGrid::CellView NeighbourGrid::getCell(const std::array<std::size_t, 3> &coord) const {
     for (std::size_t i = 0; i < 3; i++)
-        Expects(coord[i] < this->cellDivisions[i] - 2);
+        Expects(coord[i] < this->cellDivisions[i] - 2*this->reflectedLayers);
 
     std::size_t i = this->realCoordinatesToCellNo(coord);
-    std::size_t head = this->cellHeads[i];
-    return CellView(*this, head);
+    return CellView(this->getCellBegin(i), this->cellSizes[i]);
 }
 
 std::vector<std::size_t> NeighbourGrid::getNeighbours(const Vector<3> &position) const {
@@ -298,15 +593,8 @@ std::vector<std::size_t> NeighbourGrid::getNeighbours(const Vector<3> &position)
 
 std::vector<std::size_t> NeighbourGrid::getCellVector(std::size_t cellNo) const {
     std::size_t realI = this->reflectedCells[cellNo];
-    std::size_t head = this->cellHeads[realI];
-
-    std::vector<std::size_t> cell;
-    while (head != NeighbourGrid::LIST_END) {
-        cell.push_back(head);
-        head = this->successors[head];
-    }
-
-    return cell;
+    const std::uint32_t *cellBegin = this->getCellBegin(realI);
+    return std::vector<std::size_t>(cellBegin, cellBegin + this->cellSizes[realI]);
 }
 
 bool NeighbourGrid::resize(TriclinicBox newBox, double newCellSize) {
@@ -315,15 +603,19 @@ bool NeighbourGrid::resize(TriclinicBox newBox, double newCellSize) {
     this->setupSizes(newBox, newCellSize);
 
     // Early exit - if number of cells in line did not change we do not need to rebuild the structure, only clear and
-    // recreate translations
+    // recreate translations (and pruned stencils, which depend on the shape of cells)
     if (this->cellDivisions == oldNumCellsInLine) {
+        if (this->reflectedLayers > 1)
+            this->fillNeighbouringCellsOffsets();
         this->clear();
         return false;
     }
 
     // The resize is needed only if number of cells is to big for allocated memory - otherwise reuse the old structure
     if (oldNumCells < this->numCells) {
-        this->cellHeads.resize(this->numCells);
+        this->cellOffsets.resize(this->numCells);
+        this->cellSizes.resize(this->numCells);
+        this->cellCapacities.resize(this->numCells);
         #ifdef NG_SANITIZE_RACE_CONDITION
             this->cellOwningThreads.resize(this->numCells);
         #endif
@@ -331,14 +623,36 @@ bool NeighbourGrid::resize(TriclinicBox newBox, double newCellSize) {
         this->reflectedCells.resize(this->numCells);
     }
 
-    for (std::size_t i{}; i < this->numCells; i++)
-        std::tie(this->reflectedCells[i], this->translationIndices[i]) = this->getReflectedCellData(i);
+    for (std::size_t i{}; i < this->numCells; i++) {
+        auto [reflectedCell, translationIdx] = this->getReflectedCellData(i);
+        this->reflectedCells[i] = static_cast<std::uint32_t>(reflectedCell);
+        this->translationIndices[i] = static_cast<std::uint8_t>(translationIdx);
+    }
 
     this->fillNeighbouringCellsOffsets();
+    // Old layout of cells is meaningless for new cells
+    this->resetStorage();
     this->clear();
     return true;
 }
 
+bool NeighbourGrid::rescale(const TriclinicBox &newBox, double newCellSize) {
+    Expects(newBox.getVolume() > 0);
+    Expects(newCellSize > 0);
+
+    auto newCellDivisions = NeighbourGrid::calculateCellDivisions(newBox, newCellSize, this->reflectedLayers,
+                                                                  this->cellSubdivisions);
+    if (newCellDivisions != this->cellDivisions)
+        return false;
+
+    // Reflected cells depend only on cell divisions, so they stay valid. The same holds for the 27 nearest cells, but
+    // pruned stencils for more layers depend also on the shape of cells
+    this->setupSizes(newBox, newCellSize);
+    if (this->reflectedLayers > 1)
+        this->fillNeighbouringCellsOffsets();
+    return true;
+}
+
 bool NeighbourGrid::resize(const std::array<double, 3> &newLinearSize, double newCellSize) {
     return this->resize(TriclinicBox(Matrix<3, 3>{newLinearSize[0], 0, 0,
                                                   0, newLinearSize[1], 0,
@@ -361,7 +675,7 @@ NeighbourGrid::NeighboursView NeighbourGrid::getNeighbouringCells(const std::arr
                                                                   bool onlyPositive) const
 {
     for (std::size_t i = 0; i < 3; i++)
-        Expects(coord[i] < this->cellDivisions[i] - 2);
+        Expects(coord[i] < this->cellDivisions[i] - 2*this->reflectedLayers);
 
     if (onlyPositive)
         return NeighboursView(*this, this->realCoordinatesToCellNo(coord), this->positiveNeighbouringCellsOffsets);
@@ -369,19 +683,39 @@ NeighbourGrid::NeighboursView NeighbourGrid::getNeighbouringCells(const std::arr
         return NeighboursView(*this, this->realCoordinatesToCellNo(coord), this->neighbouringCellsOffsets);
 }
 
+NeighbourGrid::NeighboursView NeighbourGrid::getExtendedNeighbouringCells(const Vector<3> &position,
+                                                                          std::size_t layers) const
+{
+    Expects(layers >= 1);
+    Expects(layers <= this->reflectedLayers);
+
+    return NeighboursView(*this, this->positionToCellNo(position), this->extendedNeighbouringCellsOffsets[layers - 1]);
+}
+
 std::array<std::size_t, 3> NeighbourGrid::getCellDivisions() const {
-    return {this->cellDivisions[0] - 2, this->cellDivisions[1] - 2, this->cellDivisions[2] - 2};
+    std::size_t reflectedCells = 2*this->reflectedLayers;
+    return {this->cellDivisions[0] - reflectedCells, this->cellDivisions[1] - reflectedCells,
+            this->cellDivisions[2] - reflectedCells};
 }
 
 std::size_t NeighbourGrid::getMemoryUsage() const {
     std::size_t bytes{};
-    bytes += get_vector_memory_usage(this->cellHeads);
+    bytes += get_vector_memory_usage(this->cellOffsets);
+    bytes += get_vector_memory_usage(this->cellSizes);
+    bytes += get_vector_memory_usage(this->cellCapacities);
+    bytes += get_vector_memory_usage(this->baseStorage);
+    bytes += get_vector_memory_usage(this->overflowDirectory);
+    bytes += this->overflowBlocksAllocated * OVERFLOW_BLOCK_SIZE * sizeof(std::unique_ptr<std::uint32_t[]>);
+    bytes += this->overflowPagesAllocated * OVERFLOW_PAGE_SIZE * sizeof(std::uint32_t);
     bytes += get_vector_memory_usage(this->cellOwningThreads);
+    bytes += get_vector_memory_usage(this->objectCells);
+    bytes += get_vector_memory_usage(this->objectSlots);
     bytes += get_vector_memory_usage(this->translationIndices);
-    bytes += get_vector_memory_usage(this->successors);
     bytes += get_vector_memory_usage(this->reflectedCells);
     bytes += get_vector_memory_usage(this->neighbouringCellsOffsets);
     bytes += get_vector_memory_usage(this->positiveNeighbouringCellsOffsets);
+    for (const auto &offsets : this->extendedNeighbouringCellsOffsets)
+        bytes += get_vector_memory_usage(offsets);
     return bytes;
 }
 
@@ -394,7 +728,7 @@ NeighbourGrid::cellCoordinatesToCellBounds(const std::array<std::size_t, 3> &coo
 {
     std::array<std::pair<double, double>, 3> bounds;
     for (std::size_t i{}; i < 3; i++) {
-        double beg = (static_cast<double>(coords[i]) - 1) / this->cellDivisions[i];
+        double beg = (static_cast<double>(coords[i]) - this->reflectedLayers) / this->cellDivisions[i];
         double end = beg + this->relativeCellSize[i];
         bounds[i] = {beg, end};
     }
@@ -421,7 +755,7 @@ void NeighbourGrid::sanitizeRaceCondition(std::size_t cellNo, const std::string
         auto coords = this->cellNoToCoordinates(cellNo);
         auto bounds = this->cellCoordinatesToCellBounds(coords);
         for (auto &coord : coords)
-            coord--;
+            coord -= this->reflectedLayers;
 
         msg << "Cell coordinates : {" << coords[0] << ", " << coords[1] << ", " << coords[2] << "}" << std::endl;
         msg << "Rel. cell bounds : {[" << bounds[0].first << ", " << bounds[0].second << "), ";
@@ -17,6 +17,9 @@
 #include <array>
 #include <iterator>
 #include <memory>
+#include <cstdint>
+#include <limits>
+#include <utility>
 
 #include "TriclinicBox.h"
 #include "geometry/Vector.h"
@@ -24,33 +27,65 @@
 
 /**
  * @brief An acceleration structure for a constant-time lookup of neighbours for a fixed number of particles.
+ * @details Identifiers of objects in each cell are stored contiguously (as 32-bit integers) with some slack, so that
+ * adding an object to a cell usually does not require any reallocation. A cell which outgrows its capacity is moved to
+ * an overflow storage, which is compacted lazily (see NeighbourGrid::compactIfNeeded).
  */
 class NeighbourGrid {
 private:
     static constexpr std::size_t LIST_END = std::numeric_limits<std::size_t>::max();
+    static constexpr std::uint32_t NOT_PRESENT = std::numeric_limits<std::uint32_t>::max();
+    static constexpr std::size_t MAX_CELL_CAPACITY = std::numeric_limits<std::uint32_t>::max();
+
+    // Segments of cells which outgrew their capacity are moved to overflow pages. Pages are never reallocated, so
+    // cells can be grown concurrently by different threads. Pages are indexed by a two-level directory spanning the
+    // whole 32-bit slot space, so it never runs out of pages and does not have to be resized
+    static constexpr std::size_t OVERFLOW_PAGE_BITS = 14;
+    static constexpr std::size_t OVERFLOW_PAGE_SIZE = std::size_t{1} << OVERFLOW_PAGE_BITS;
+    static constexpr std::size_t OVERFLOW_BLOCK_BITS = 10;
+    static constexpr std::size_t OVERFLOW_BLOCK_SIZE = std::size_t{1} << OVERFLOW_BLOCK_BITS;
+    static constexpr std::size_t OVERFLOW_DIRECTORY_SIZE
+        = std::size_t{1} << (32 - OVERFLOW_PAGE_BITS - OVERFLOW_BLOCK_BITS);
 
     TriclinicBox box;
     std::array<Vector<3>, 3> boxSides;
     std::array<std::size_t, 3> cellDivisions{};
+    std::size_t reflectedLayers{};
+    std::size_t cellSubdivisions{};
+    double requestedCellSize{};
     std::array<double, 3> relativeCellSize{};
-    std::vector<std::size_t> cellHeads;
+
+    // Members of each cell are stored contiguously: cellOffsets[cellNo] is the index of the first slot (see
+    // NeighbourGrid::getSlot) and cellSizes[cellNo] and cellCapacities[cellNo] the number of members and slots
+    std::vector<std::uint32_t> cellOffsets;
+    std::vector<std::uint32_t> cellSizes;
+    std::vector<std::uint32_t> cellCapacities;
+    // Storage laid out by the last compaction - slots [0, baseStorage.size())
+    std::vector<std::uint32_t> baseStorage;
+    // Overflow pages - slots from baseStorage.size() on. Each directory entry is a lazily allocated block of
+    // OVERFLOW_BLOCK_SIZE consecutive pages
+    std::vector<std::unique_ptr<std::unique_ptr<std::uint32_t[]>[]>> overflowDirectory;
+    std::size_t overflowSlotsUsed{};
+    std::size_t overflowPagesAllocated{};   // a segment spanning many page indices counts as many pages
+    std::size_t overflowBlocksAllocated{};
+
     std::vector<std::size_t> cellOwningThreads;
-    std::vector<std::size_t> successors;
+    std::vector<std::uint32_t> objectCells;     // cell number of each object (NOT_PRESENT if not present)
+    std::vector<std::uint32_t> objectSlots;     // position of each object within its cell
     std::array<Vector<3>, 27> translations;
-    std::vector<std::size_t> translationIndices;
-    std::vector<std::size_t> reflectedCells;
+    std::vector<std::uint8_t> translationIndices;
+    std::vector<std::uint32_t> reflectedCells;
     std::size_t numCells{};
     std::vector<std::size_t> neighbouringCellsOffsets;
     std::vector<std::size_t> positiveNeighbouringCellsOffsets;
+    std::vector<std::vector<std::size_t>> extendedNeighbouringCellsOffsets;    // indexed by number of layers - 1
 
-    static bool increment(std::array<int, 3> &in);
     static std::size_t flattenTranslationIndex(std::size_t i, std::size_t j, std::size_t k) { return i*3*3 + j*3 + k; }
+    static std::size_t calculateCapacity(std::size_t cellSize) { return cellSize + cellSize/2 + 1; }
 
     [[nodiscard]] std::array<std::size_t, 3> cellNoToCoordinates(std::size_t cellNo) const;
     [[nodiscard]] std::size_t coordinatesToCellNo(const std::array<std::size_t, 3> &coords) const;
     [[nodiscard]] std::size_t realCoordinatesToCellNo(const std::array<std::size_t, 3> &coords) const;
-    [[nodiscard]] std::size_t cellNeighbourToCellNo(const std::array<std::size_t, 3> &coords,
-                                                    const std::array<int, 3> &neighbour) const;
     [[nodiscard]] std::array<std::pair<double, double>, 3>
     cellCoordinatesToCellBounds(const std::array<std::size_t, 3> &coords) const;
 
@@ -60,17 +95,51 @@ private:
     [[nodiscard]] bool isCellReflected(std::size_t cellNo) const;
 
     /**
-     * @brief If @a cellNo is the reflection of a real cell due to periodic boundary conditions the method returns
-     * pointer to the vector in the real cell. Otherwise @a nullptr is returned.
+     * @brief Returns the pair of the number of the real cell corresponding to @a cellNo and the index of the periodic
+     * translation (see NeighbourGrid::flattenTranslationIndex) from the real cell to @a cellNo.
+     * @details If @a cellNo is not the reflection of a real cell due to periodic boundary conditions, the pair is
+     * (@a cellNo, index of the zero translation), i.e. there is no separate reflected data.
      */
     [[nodiscard]] std::pair<std::size_t, std::size_t> getReflectedCellData(std::size_t cellNo) const;
 
+    /**
+     * @brief Returns the squared minimal distance between points of a real cell and the one shifted by @a offset cells.
+     */
+    [[nodiscard]] double calculateMinimalCellDistance2(const std::array<int, 3> &offset) const;
     void fillNeighbouringCellsOffsets();
 
     [[nodiscard]] std::vector<std::size_t> getCellVector(std::size_t cellNo) const;
     void setupSizes(const TriclinicBox& newBox, double newCellSize);
+    [[nodiscard]] static std::array<std::size_t, 3> calculateCellDivisions(const TriclinicBox &newBox,
+                                                                           double newCellSize,
+                                                                           std::size_t reflectedLayers,
+                                                                           std::size_t cellSubdivisions);
     void calculateTranslations();
 
+    [[nodiscard]] const std::uint32_t *getSlot(std::size_t slotIdx) const {
+        if (slotIdx < this->baseStorage.size())
+            return this->baseStorage.data() + slotIdx;
+        std::size_t overflowIdx = slotIdx - this->baseStorage.size();
+        std::size_t pageIdx = overflowIdx >> OVERFLOW_PAGE_BITS;
+        const auto &block = this->overflowDirectory[pageIdx >> OVERFLOW_BLOCK_BITS];
+        return block[pageIdx & (OVERFLOW_BLOCK_SIZE - 1)].get() + (overflowIdx & (OVERFLOW_PAGE_SIZE - 1));
+    }
+
+    [[nodiscard]] std::uint32_t *getSlot(std::size_t slotIdx) {
+        return const_cast<std::uint32_t*>(std::as_const(*this).getSlot(slotIdx));
+    }
+
+    [[nodiscard]] const std::uint32_t *getCellBegin(std::size_t cellNo) const {
+        return this->getSlot(this->cellOffsets[cellNo]);
+    }
+
+    std::uint32_t allocateOverflowSlots(std::size_t numSlots);
+    void growCell(std::size_t cellNo);
+    void link(std::size_t idx, std::size_t cellNo);
+    void unlink(std::size_t idx, std::size_t cellNo);
+    void layOutCells(const std::vector<std::uint32_t> &newCellSizes);
+    void resetStorage();
+
     void sanitizeRaceCondition(size_t cellNo, const std::string& methodSignature);
 
     friend class NeighboursView;
@@ -79,12 +148,11 @@ private:
 
 public:
     /**
-     * @brief Iterator over the cell linked-list.
+     * @brief Iterator over the contiguous cell storage.
      */
     class CellViewIterator {
     private:
-        const NeighbourGrid *grid;
-        std::size_t head;
+        const std::uint32_t *member{};
 
     public:
         using iterator_category = std::input_iterator_tag;
@@ -93,10 +161,10 @@ public:
         using pointer = void;
         using reference = std::size_t;
 
-        CellViewIterator(const NeighbourGrid *grid, std::size_t head) : grid{grid}, head{head} { }
+        explicit CellViewIterator(const std::uint32_t *member) : member{member} { }
 
         CellViewIterator& operator++() {
-            this->head = this->grid->successors[this->head];
+            this->member++;
             return *this;
         }
 
@@ -106,24 +174,26 @@ public:
             return retval;
         }
 
-        bool operator==(CellViewIterator other) const { return this->head == other.head; }
+        bool operator==(CellViewIterator other) const { return this->member == other.member; }
         bool operator!=(CellViewIterator other) const { return !(*this == other);}
-        value_type operator*() const { return this->head; }
+        value_type operator*() const { return *this->member; }
     };
 
     /**
-     * @brief The view over a single cell linked-list.
+     * @brief The view over members of a single cell.
      */
     class CellView {
     private:
-        const NeighbourGrid &grid;
-        std::size_t head;
+        const std::uint32_t *first{};
+        const std::uint32_t *last{};
 
     public:
-        CellView(const NeighbourGrid &grid, std::size_t head) : grid{grid}, head{head} { }
+        CellView(const std::uint32_t *first, std::size_t size) : first{first}, last{first + size} { }
 
-        [[nodiscard]] CellViewIterator begin() const { return CellViewIterator(&this->grid, this->head); }
-        [[nodiscard]] CellViewIterator end() const { return CellViewIterator(&this->grid, LIST_END); }
+        [[nodiscard]] CellViewIterator begin() const { return CellViewIterator(this->first); }
+        [[nodiscard]] CellViewIterator end() const { return CellViewIterator(this->last); }
+        [[nodiscard]] std::size_t size() const { return this->last - this->first; }
+        [[nodiscard]] bool empty() const { return this->first == this->last; }
     };
 
 
@@ -132,18 +202,15 @@ public:
      */
     class NeighbourCellData {
     private:
-        const NeighbourGrid *grid;
-        const std::size_t head;
+        CellView cellView;
         const Vector<3> *translation;
 
     public:
-        NeighbourCellData(std::size_t head, const Vector<3> *translation, const NeighbourGrid *grid)
-                : grid{grid}, head{head}, translation{translation}
+        NeighbourCellData(CellView cellView, const Vector<3> *translation)
+                : cellView{cellView}, translation{translation}
         { }
 
-        [[nodiscard]] CellView getNeighbours() const {
-            return CellView(*this->grid, this->head);
-        }
+        [[nodiscard]] CellView getNeighbours() const { return this->cellView; }
         [[nodiscard]] const Vector<3> &getTranslation() const { return *this->translation; }
     };
 
@@ -192,9 +259,10 @@ public:
         value_type operator*() const {
             std::size_t neighbourCellNo = this->cellNo + (*this->offsets)[this->offsetIdx];
             std::size_t translationIdx = grid->translationIndices[neighbourCellNo];
+            std::size_t realCellNo = this->grid->reflectedCells[neighbourCellNo];
 
-            return NeighbourCellData(this->grid->cellHeads[this->grid->reflectedCells[neighbourCellNo]],
-                                     &(this->grid->translations[translationIdx]), this->grid);
+            CellView cellView(this->grid->getCellBegin(realCellNo), this->grid->cellSizes[realCellNo]);
+            return NeighbourCellData(cellView, &(this->grid->translations[translationIdx]));
         }
     };
 
@@ -240,6 +308,22 @@ public:
      */
     NeighbourGrid(const TriclinicBox& box, double cellSize, std::size_t numParticles);
 
+    /**
+     * @brief Creates a neighbour grid for a general box, as NeighbourGrid(const TriclinicBox&, double, std::size_t),
+     * but with @a reflectedLayers layers of "reflected" cells on each edge instead of one and each cell of size
+     * @a cellSize additionally divided into @a cellSubdivisions parts in each direction.
+     * @details Reflected layers enable NeighbourGrid::getExtendedNeighbouringCells queries reaching further than the
+     * nearest neighbouring cells - up to @a reflectedLayers cells in each direction. The number of real cells in each
+     * direction has to be at least @a reflectedLayers. Cell subdivisions guarantee that the boundaries of cells are
+     * aligned with the ones of a grid created with the same @a cellSize, but without subdivisions. NeighbourGrid::
+     * getNeighbouringCells then spans @a cellSubdivisions layers, so it still covers all objects closer than
+     * @a cellSize, thus @a reflectedLayers cannot be smaller than @a cellSubdivisions. As the cells are smaller, the
+     * corners of the cube of cells which cannot contain such objects are pruned (see
+     * NeighbourGrid::getExtendedNeighbouringCells).
+     */
+    NeighbourGrid(const TriclinicBox& box, double cellSize, std::size_t numParticles, std::size_t reflectedLayers,
+                  std::size_t cellSubdivisions);
+
     /**
      * @brief Adds an object with identifier @a idx at position @a position to the neighbour grid.
      */
@@ -256,16 +340,70 @@ public:
      */
     void add(std::size_t idx, std::size_t cellNo);
 
+    /**
+     * @brief Clears the neighbour grid and adds all @a objects given as (identifier, cell number) pairs at once using
+     * @a numThreads threads.
+     * @details It is a parallel counting sort - objects are counted in cells, the storage is laid out from scratch
+     * (with some slack in each cell) and objects are scattered concurrently. Then each cell is sorted, so that the
+     * result is deterministic and the same as when NeighbourGrid::add(std::size_t, std::size_t) was called for all
+     * @a objects sequentially in the increasing order of identifiers. Race condition sanitizer is not used.
+     */
+    void build(const std::vector<std::pair<std::size_t, std::size_t>> &objects, std::size_t numThreads = 1);
+
     /**
      * @brief Removes an object with identifier @a idx at position @a position from the neighbour grid.
+     * @details If the object is not present in the cell containing @a position, nothing happens.
      */
     void remove(std::size_t idx, const Vector<3> &position);
 
+    /**
+     * @brief Removes an object with identifier @a idx from the cell it was added to (if it is present at all).
+     * @details Contrary to NeighbourGrid::remove(std::size_t, const Vector<3> &), the position is not needed, so the
+     * method is immune to the object's cell being ambiguous due to numerical inaccuracies (for example after
+     * NeighbourGrid::rescale).
+     */
+    void remove(std::size_t idx);
+
+    /**
+     * @brief Moves an object with identifier @a idx, which is already present in the neighbour grid, to the cell
+     * containing @a newPosition.
+     * @details If the cell did not change, it is a no-op. Otherwise the object is relocated in constant time.
+     * @return @a true if the object changed the cell
+     */
+    bool move(std::size_t idx, const Vector<3> &newPosition);
+
+    /**
+     * @brief Moves an object with identifier @a idx, which is already present in the neighbour grid, to the cell
+     * indexed by @a newCellNo.
+     * @details If the cell did not change, it is a no-op. Otherwise the object is relocated in constant time.
+     * @return @a true if the object changed the cell
+     */
+    bool move(std::size_t idx, std::size_t newCellNo);
+
+    /**
+     * @brief Returns the cell number (see NeighbourGrid::positionToCellNo) to which an object with identifier @a idx
+     * was added or @a std::numeric_limits<std::size_t>::max() if it is not present in the neighbour grid.
+     */
+    [[nodiscard]] std::size_t getObjectCellNo(std::size_t idx) const {
+        std::uint32_t cellNo = this->objectCells[idx];
+        return cellNo == NOT_PRESENT ? LIST_END : cellNo;
+    }
+
     /**
      * @brief Clears the neighbour grid.
      */
     void clear();
 
+    /**
+     * @brief Compacts the storage of cells if a significant part of it is occupied by the overflow storage of grown
+     * cells. It is a no-op most of the time.
+     * @details The method must not be run concurrently with other methods, neither should CellView or NeighboursView
+     * obtained before be used afterwards.
+     * @param numThreads number of threads used for the compaction
+     * @return @a true if compaction was performed
+     */
+    bool compactIfNeeded(std::size_t numThreads = 1);
+
     /**
      * @brief Resizes the neighbour grid with given new linear size (of a cubic box) and new cell size. NG is also
      * cleared.
@@ -283,6 +421,17 @@ public:
      */
     bool resize(TriclinicBox box_, double newCellSize);
 
+    /**
+     * @brief Changes the box to @a newBox without clearing the neighbour grid, provided that the number of cells in
+     * each direction for @a newBox and @a newCellSize is the same as the current one.
+     * @details Cells are indexed in relative coordinates, so the cell membership of objects whose relative position
+     * did not change (affine transformation of the box) is preserved and only box-dependent translations are updated.
+     * Objects whose relative positions were altered have to be relocated by the caller.
+     * @return @a true if the box was changed, @a false if cell divisions would be different - in that case neighbour
+     * grid is left untouched and NeighbourGrid::resize should be used.
+     */
+    bool rescale(const TriclinicBox &newBox, double newCellSize);
+
     /**
      * @brief Returns all identifiers of objects places in NG cell containing @a position point.
      */
@@ -318,11 +467,28 @@ public:
     [[nodiscard]] NeighboursView getNeighbouringCells(const std::array<std::size_t, 3> &coord,
                                                       bool onlyPositive = false) const;
 
+    /**
+     * @brief Returns NeighboursView of all cells which are at most @a layers cells away in each direction from the NG
+     * cell containing @a position point and may contain points closer than @a layers * cellSize / cellSubdivisions
+     * to it (see the constructor).
+     * @details The cells in the corners of the cube which are further away are pruned. The minimal distance between
+     * cells is computed exactly for the current (possibly triclinic) shape of cells, so the result stays valid after
+     * NeighbourGrid::resize and NeighbourGrid::rescale. For @a layers equal @a cellSubdivisions it is the same as
+     * NeighbourGrid::getNeighbouringCells. @a layers cannot be larger than the number of reflected layers specified
+     * in the constructor.
+     */
+    [[nodiscard]] NeighboursView getExtendedNeighbouringCells(const Vector<3> &position, std::size_t layers) const;
+
     /**
      * @brief Returns a number of NG cells in each direction.
      */
     [[nodiscard]] std::array<std::size_t, 3> getCellDivisions() const;
 
+    /**
+     * @brief Returns the number of subdivisions of cells in each direction specified in the constructor.
+     */
+    [[nodiscard]] std::size_t getCellSubdivisions() const { return this->cellSubdivisions; }
+
     /**
      * @brief Estimates the memory usage of the neighbour grid in bytes.
      */
@@ -0,0 +1,70 @@
+#include <algorithm>
+#include <cmath>
+#include <utility>
+
+#include "NeighbourGridCellSizeTuner.h"
+#include "utils/Exceptions.h"
+
+
+// 0.2 is the value used for untuned packings - the rest give cells a few times larger than the mean distance between
+// particles, which is beneficial for elongated or dense systems
+const std::vector<double> NeighbourGridCellSizeTuner::DEFAULT_CANDIDATE_FACTORS = {0.2, 0.5, 1, 1.5, 2, 3};
+
+NeighbourGridCellSizeTuner::NeighbourGridCellSizeTuner(std::vector<double> candidateFactors,
+                                                       std::size_t cyclesPerCandidate, double densityTolerance)
+        : candidateFactors{std::move(candidateFactors)}, cyclesPerCandidate{cyclesPerCandidate},
+          densityTolerance{densityTolerance}
+{
+    Expects(!this->candidateFactors.empty());
+    Expects(std::all_of(this->candidateFactors.begin(), this->candidateFactors.end(), [](double f) { return f > 0; }));
+    Expects(this->cyclesPerCandidate > 0);
+    Expects(this->densityTolerance > 0);
+
+    this->startTuning();
+}
+
+void NeighbourGridCellSizeTuner::startTuning() {
+    this->tuned = false;
+    this->candidateMicroseconds.assign(this->candidateFactors.size(), 0);
+    this->currentCandidateIdx = 0;
+    this->currentCandidateCycles = 0;
+}
+
+bool NeighbourGridCellSizeTuner::registerCycle(double microseconds, double numberDensity) {
+    Expects(numberDensity > 0);
+
+    if (this->tuned) {
+        if (std::abs(numberDensity / this->tunedDensity - 1) <= this->densityTolerance)
+            return false;
+
+        double oldFactor = this->getFactor();
+        this->startTuning();
+        return this->getFactor() != oldFactor;
+    }
+
+    // The first cycle for a given candidate is not counted
+    if (this->currentCandidateCycles > 0)
+        this->candidateMicroseconds[this->currentCandidateIdx] += microseconds;
+    this->currentCandidateCycles++;
+    if (this->currentCandidateCycles <= this->cyclesPerCandidate)
+        return false;
+
+    double oldFactor = this->getFactor();
+    this->currentCandidateIdx++;
+    this->currentCandidateCycles = 0;
+    if (this->currentCandidateIdx == this->candidateFactors.size()) {
+        auto fastestIt = std::min_element(this->candidateMicroseconds.begin(), this->candidateMicroseconds.end());
+        this->tunedFactor = this->candidateFactors[fastestIt - this->candidateMicroseconds.begin()];
+        this->tunedDensity = numberDensity;
+        this->tuned = true;
+        this->tunings++;
+    }
+    return this->getFactor() != oldFactor;
+}
+
+double NeighbourGridCellSizeTuner::getFactor() const {
+    if (this->tuned)
+        return this->tunedFactor;
+    else
+        return this->candidateFactors[this->currentCandidateIdx];
+}
@@ -0,0 +1,69 @@
+#ifndef RAMPACK_NEIGHBOURGRIDCELLSIZETUNER_H
+#define RAMPACK_NEIGHBOURGRIDCELLSIZETUNER_H
+
+#include <vector>
+#include <cstddef>
+
+
+/**
+ * @brief Class choosing the fastest neighbour grid cell size factor (see Packing::setNeighbourGridCellSizeFactor) by
+ * measuring the duration of simulation cycles.
+ * @details Each candidate factor is used for a given number of cycles (the first cycle after each change is not
+ * measured, since it includes cache warm-up) and the one with the shortest average cycle time is locked in. The tuning
+ * is started again if the number density of the system changes by more than a given relative tolerance from the one
+ * for which the factor was chosen.
+ */
+class NeighbourGridCellSizeTuner {
+private:
+    std::vector<double> candidateFactors;
+    std::size_t cyclesPerCandidate{};
+    double densityTolerance{};
+
+    std::vector<double> candidateMicroseconds;
+    std::size_t currentCandidateIdx{};
+    std::size_t currentCandidateCycles{};
+    bool tuned{};
+    double tunedFactor{};
+    double tunedDensity{};
+    std::size_t tunings{};
+
+    void startTuning();
+
+public:
+    /**
+     * @brief Candidate factors used by default - from the one giving the smallest cells to the largest ones.
+     */
+    static const std::vector<double> DEFAULT_CANDIDATE_FACTORS;
+
+    /**
+     * @brief Creates the tuner for given @a candidateFactors, each measured during @a cyclesPerCandidate cycles and
+     * retuned when the density changes relatively by more than @a densityTolerance.
+     */
+    explicit NeighbourGridCellSizeTuner(std::vector<double> candidateFactors = DEFAULT_CANDIDATE_FACTORS,
+                                        std::size_t cyclesPerCandidate = 10, double densityTolerance = 0.1);
+
+    /**
+     * @brief Registers the duration of a cycle performed using the factor NeighbourGridCellSizeTuner::getFactor()
+     * and number density of the system after it.
+     * @return @a true if the factor which should be used has changed.
+     */
+    bool registerCycle(double microseconds, double numberDensity);
+
+    /**
+     * @brief Returns the factor which should be currently used - the one being measured or the tuned one.
+     */
+    [[nodiscard]] double getFactor() const;
+
+    /**
+     * @brief Returns @a true if the tuning has finished and the fastest factor is locked in.
+     */
+    [[nodiscard]] bool isTuned() const { return this->tuned; }
+
+    /**
+     * @brief Returns how many times the tuning was completed.
+     */
+    [[nodiscard]] std::size_t getTunings() const { return this->tunings; }
+};
+
+
+#endif //RAMPACK_NEIGHBOURGRIDCELLSIZETUNER_H
@@ -9,8 +9,10 @@
 #include <chrono>
 #include <atomic>
 #include <functional>
+#include <cstdint>
 
 #include "Packing.h"
+#include "DevirtualisedInteractions.h"
 #include "utils/Exceptions.h"
 #include "utils/Utils.h"
 #include "utils/ParseUtils.h"
@@ -19,8 +21,9 @@
 
 
 namespace {
-    // Helper class for precomputed boundary conditions translations
-    class HardcodedTranslation : public BoundaryConditions {
+    // Helper class for precomputed boundary conditions translations. It is final, so that getTranslation and
+    // getDistance2 are not called virtually when the pair tests of devirtualised interactions are inlined
+    class HardcodedTranslation final : public BoundaryConditions {
     private:
         Vector<3> translation;
 
@@ -41,6 +44,38 @@ namespace {
             return (position2 + this->translation - position1).norm2();
         }
     };
+
+    // Interleaves the lowest 10 bits of x with two zero bits each, as needed by Morton codes
+    std::uint32_t spread_morton_bits(std::uint32_t x) {
+        x &= 0x3ff;
+        x = (x | (x << 16)) & 0x030000ff;
+        x = (x | (x << 8)) & 0x0300f00f;
+        x = (x | (x << 4)) & 0x030c30c3;
+        x = (x | (x << 2)) & 0x09249249;
+        return x;
+    }
+
+    // Morton code of a point given in box-relative coordinates, with 1024 bins per axis
+    std::uint32_t morton_code(const Vector<3> &relativePos) {
+        constexpr double BINS = 1024;
+        std::array<std::uint32_t, 3> bins{};
+        for (std::size_t i{}; i < 3; i++)
+            bins[i] = static_cast<std::uint32_t>(std::clamp(relativePos[i] * BINS, 0., BINS - 1));
+        return spread_morton_bits(bins[0]) | (spread_morton_bits(bins[1]) << 1) | (spread_morton_bits(bins[2]) << 2);
+    }
+
+    // Permutes consecutive blocks of blockSize elements according to order (new block i is old block order[i]). The
+    // elements after the last permuted block (temp slots) are left untouched
+    template<typename T, typename Allocator>
+    void permute_blocks(std::vector<T, Allocator> &data, const std::vector<std::size_t> &order, std::size_t blockSize) {
+        std::vector<T, Allocator> permuted;
+        permuted.reserve(data.size());
+        for (std::size_t oldIdx : order)
+            for (std::size_t i{}; i < blockSize; i++)
+                permuted.push_back(data[oldIdx * blockSize + i]);
+        permuted.insert(permuted.end(), data.begin() + order.size() * blockSize, data.end());
+        data = std::move(permuted);
+    }
 }
 
 Packing::Packing(const TriclinicBox &box, std::vector<Shape> shapes, std::unique_ptr<BoundaryConditions> bc,
@@ -59,9 +94,12 @@ Packing::Packing(std::unique_ptr<BoundaryConditions> bc, std::size_t moveThreads
     this->moveThreads = (moveThreads == 0 ? OMP_MAXTHREADS : moveThreads);
     this->scalingThreads = (scalingThreads == 0 ? OMP_MAXTHREADS : scalingThreads);
 
-    this->shapes.resize(this->moveThreads);    // temp shapes at the back so that Packing::end() works
+    // temp shapes at the back so that Packing::end() works
+    this->positions.resize(this->moveThreads);
+    this->orientations.resize(this->moveThreads, Packing::toStoredOrientation(Matrix<3, 3>::identity()));
     this->lastAlteredParticleIdx.resize(this->moveThreads, 0);
     this->lastMoveOverlapDeltas.resize(this->moveThreads, 0);
+    this->overlapBatches.resize(this->moveThreads);
 }
 
 void Packing::reset(std::vector<Shape> newShapes, const TriclinicBox &newBox, const Interaction &newInteraction) {
@@ -70,13 +108,27 @@ void Packing::reset(std::vector<Shape> newShapes, const TriclinicBox &newBox, co
     Expects(!newShapes.empty());
     Expects(Packing::areShapesWithinBox(newShapes, newBox));
 
-    this->shapes = std::move(newShapes);
+    // The box has to be set before the positions, because they may be stored relative to it
     this->box = newBox;
-    this->interactionRange = newInteraction.getRangeRadius();
+    this->positions.clear();
+    this->orientations.clear();
+    // temp shapes at the back
+    this->positions.reserve(newShapes.size() + this->moveThreads);
+    this->orientations.reserve(newShapes.size() + this->moveThreads);
+    for (const auto &shape : newShapes) {
+        this->positions.push_back(this->toStoredPosition(shape.getPosition()));
+        this->orientations.push_back(Packing::toStoredOrientation(shape.getOrientation()));
+    }
+    this->positions.resize(newShapes.size() + this->moveThreads);
+    this->internalIndices.clear();
+    this->externalIndices.clear();
+    auto identity = Packing::toStoredOrientation(Matrix<3, 3>::identity());
+    this->orientations.resize(newShapes.size() + this->moveThreads, identity);
 
-    this->shapes.resize(this->shapes.size() + this->moveThreads);    // temp shapes at the back
+    this->interactionRange = newInteraction.getRangeRadius();
     this->lastAlteredParticleIdx.resize(this->moveThreads, 0);
     this->lastMoveOverlapDeltas.resize(this->moveThreads, 0);
+    this->overlapBatches.resize(this->moveThreads);
     this->bc->setBox(this->box);
     this->setupForInteraction(newInteraction);
 }
@@ -86,13 +138,14 @@ double Packing::tryTranslation(std::size_t particleIdx, Vector<3> translation, c
 {
     Expects(particleIdx < this->size());
     Expects(interaction.getRangeRadius() <= this->interactionRange);
+    particleIdx = this->toInternalIndex(particleIdx);
 
     std::size_t tempParticleIdx = this->size() + OMP_THREAD_ID;
     this->lastAlteredParticleIdx[OMP_THREAD_ID] = particleIdx;
-    this->shapes[tempParticleIdx] = this->shapes[particleIdx];
-    this->shapes[tempParticleIdx].translate(translation, *this->bc);
+    this->translateTempPosition(particleIdx, translation);
+    this->orientations[tempParticleIdx] = this->orientations[particleIdx];
 
-    if (boundaries.has_value() && !boundaries->isInside(this->shapes[tempParticleIdx].getPosition()))
+    if (boundaries.has_value() && !boundaries->isInside(this->getAbsolutePosition(tempParticleIdx)))
         return std::numeric_limits<double>::infinity();
 
     if (this->numInteractionCentres != 0) {
@@ -104,20 +157,19 @@ double Packing::tryTranslation(std::size_t particleIdx, Vector<3> translation, c
     if (overlapEnergy != 0)
         return overlapEnergy;
 
-    double initialEnergy = this->calculateParticleEnergy(particleIdx, particleIdx, interaction);
-    double finalEnergy = this->calculateParticleEnergy(particleIdx, tempParticleIdx, interaction);
-    return finalEnergy - initialEnergy;
+    return this->calculateMoveEnergy(particleIdx, tempParticleIdx, interaction);
 }
 
 double Packing::tryRotation(std::size_t particleIdx, const Matrix<3, 3> &rotation, const Interaction &interaction) {
     Expects(particleIdx < this->size());
     Expects(interaction.getRangeRadius() <= this->interactionRange);
+    particleIdx = this->toInternalIndex(particleIdx);
 
     std::size_t tempParticleIdx = this->size() + OMP_THREAD_ID;
     this->lastAlteredParticleIdx[OMP_THREAD_ID] = particleIdx;
-    this->shapes[tempParticleIdx] = this->shapes[particleIdx];
+    this->positions[tempParticleIdx] = this->positions[particleIdx];
+    this->orientations[tempParticleIdx] = Packing::rotateOrientation(rotation, this->orientations[particleIdx]);
 
-    this->shapes[tempParticleIdx].rotate(rotation);
     if (this->numInteractionCentres != 0) {
         this->prepareTempInteractionCentres(particleIdx);
         this->rotateTempInteractionCentres(rotation);
@@ -128,9 +180,7 @@ double Packing::tryRotation(std::size_t particleIdx, const Matrix<3, 3> &rotatio
     if (overlapEnergy != 0)
         return overlapEnergy;
 
-    double initialEnergy = this->calculateParticleEnergy(particleIdx, particleIdx, interaction);
-    double finalEnergy = this->calculateParticleEnergy(particleIdx, tempParticleIdx, interaction);
-    return finalEnergy - initialEnergy;
+    return this->calculateMoveEnergy(particleIdx, tempParticleIdx, interaction);
 }
 
 double Packing::tryMove(std::size_t particleIdx, const Vector<3> &translation, const Matrix<3, 3> &rotation,
@@ -138,16 +188,16 @@ double Packing::tryMove(std::size_t particleIdx, const Vector<3> &translation, c
 {
     Expects(particleIdx < this->size());
     Expects(interaction.getRangeRadius() <= this->interactionRange);
+    particleIdx = this->toInternalIndex(particleIdx);
 
     std::size_t tempParticleIdx = this->size() + OMP_THREAD_ID;
     this->lastAlteredParticleIdx[OMP_THREAD_ID] = particleIdx;
-    this->shapes[tempParticleIdx] = this->shapes[particleIdx];
-    this->shapes[tempParticleIdx].translate(translation, *this->bc);
+    this->translateTempPosition(particleIdx, translation);
 
-    if (boundaries.has_value() && !boundaries->isInside(this->shapes[tempParticleIdx].getPosition()))
+    if (boundaries.has_value() && !boundaries->isInside(this->getAbsolutePosition(tempParticleIdx)))
         return std::numeric_limits<double>::infinity();
 
-    this->shapes[tempParticleIdx].rotate(rotation);
+    this->orientations[tempParticleIdx] = Packing::rotateOrientation(rotation, this->orientations[particleIdx]);
     if (this->numInteractionCentres != 0) {
         this->prepareTempInteractionCentres(particleIdx);
         this->rotateTempInteractionCentres(rotation);
@@ -158,9 +208,7 @@ double Packing::tryMove(std::size_t particleIdx, const Vector<3> &translation, c
     if (overlapEnergy != 0)
         return overlapEnergy;
 
-    double initialEnergy = this->calculateParticleEnergy(particleIdx, particleIdx, interaction);
-    double finalEnergy = this->calculateParticleEnergy(particleIdx, tempParticleIdx, interaction);
-    return finalEnergy - initialEnergy;
+    return this->calculateMoveEnergy(particleIdx, tempParticleIdx, interaction);
 }
 
 double Packing::tryScaling(const std::array<double, 3> &scaleFactor, const Interaction &interaction) {
@@ -173,19 +221,43 @@ double Packing::tryScaling(const TriclinicBox &newBox, const Interaction &intera
     Expects(newBox.getVolume() != 0);
     Expects(interaction.getRangeRadius() <= this->interactionRange);
     this->lastBox = this->box;
-    this->lastShapes = this->shapes;
 
     double initialEnergy = this->getTotalEnergy(interaction);
     this->lastScalingNumOverlaps = this->numOverlaps;
+    // Distances between particles are altered, so Verlet lists are no longer valid if the scaling is accepted
+    this->lastScalingVerletListsValid = this->verletListsValid;
+    this->verletListsValid = false;
 
     this->box = newBox;
     this->bc->setBox(this->box);
-    for (auto &shape : *this)
-        shape.setPosition(this->box.relativeToAbsolute(this->lastBox.absoluteToRelative(shape.getPosition())));
-    std::swap(this->neighbourGrid, this->tempNeighbourGrid);
-    if (this->numInteractionCentres != 0)
+    // Scaled positions and interaction centres are written to the second buffers, which are then swapped with the
+    // current ones, so revertScaling only swaps them back. Slots for temporary data of threads are just copied
+#ifndef RAMPACK_SINGLE_PRECISION_POSITIONS
+    this->lastPositions.resize(this->positions.size());
+    for (std::size_t i{}; i < this->size(); i++)
+        this->lastPositions[i] = this->box.relativeToAbsolute(this->lastBox.absoluteToRelative(this->positions[i]));
+    std::copy(this->positions.begin() + this->size(), this->positions.end(),
+              this->lastPositions.begin() + this->size());
+    std::swap(this->positions, this->lastPositions);
+#endif
+    if (this->numInteractionCentres != 0) {
+        this->lastAbsoluteInteractionCentres.resize(this->absoluteInteractionCentres.size());
+        std::size_t numCentres = this->size() * this->numInteractionCentres;
+        std::copy(this->absoluteInteractionCentres.begin() + numCentres, this->absoluteInteractionCentres.end(),
+                  this->lastAbsoluteInteractionCentres.begin() + numCentres);
+        std::swap(this->absoluteInteractionCentres, this->lastAbsoluteInteractionCentres);
         this->recalculateAbsoluteInteractionCentres();
-    this->rebuildNeighbourGrid();
+    }
+    // If cell divisions do not change, NG is updated in place - otherwise the old one is kept for revertScaling
+    // (unless the neighbour grid is lean)
+    this->lastScalingRescaledNeighbourGrid = this->rescaleNeighbourGrid();
+    if (!this->lastScalingRescaledNeighbourGrid) {
+        if (!this->leanNeighbourGrid) {
+            std::swap(this->neighbourGrid, this->tempNeighbourGrid);
+            std::swap(this->neighbourGridLevels, this->tempNeighbourGridLevels);
+        }
+        this->rebuildNeighbourGrid();
+    }
 
     static constexpr double INF = std::numeric_limits<double>::infinity();
     if (interaction.hasHardPart()) {
@@ -207,19 +279,30 @@ double Packing::tryScaling(const TriclinicBox &newBox, const Interaction &intera
     return finalEnergy - initialEnergy;
 }
 
-const Shape &Packing::operator[](std::size_t i) const {
+Shape Packing::operator[](std::size_t i) const {
     Expects(i < this->size());
-    return this->shapes[i];
+    std::size_t internalIdx = this->toInternalIndex(i);
+    return Shape(this->getAbsolutePosition(internalIdx), this->getOrientationMatrix(internalIdx));
 }
 
-const Shape &Packing::front() const {
+Shape Packing::front() const {
     Expects(!this->empty());
-    return this->shapes.front();
+    return (*this)[0];
 }
 
-const Shape &Packing::back() const {
+Shape Packing::back() const {
     Expects(!this->empty());
-    return this->shapes[this->size() - 1];
+    return (*this)[this->size() - 1];
+}
+
+Vector<3> Packing::getPosition(std::size_t i) const {
+    Expects(i < this->size());
+    return this->getAbsolutePosition(this->toInternalIndex(i));
+}
+
+Matrix<3, 3> Packing::getOrientation(std::size_t i) const {
+    Expects(i < this->size());
+    return this->getOrientationMatrix(this->toInternalIndex(i));
 }
 
 double Packing::getPackingFraction(double shapeVolume) const {
@@ -233,24 +316,19 @@ double Packing::getNumberDensity() const {
 
 void Packing::acceptTranslation() {
     std::size_t lastAlteredIdx = this->lastAlteredParticleIdx[OMP_THREAD_ID];
-    if (this->neighbourGrid.has_value()) {
-        if (this->numInteractionCentres == 0)
-            this->neighbourGrid->remove(lastAlteredIdx, this->shapes[lastAlteredIdx].getPosition());
-        else
-            this->removeInteractionCentresFromNeighbourGrid(lastAlteredIdx);
-    }
-
-    this->shapes[lastAlteredIdx].setPosition(this->shapes[this->size() + OMP_THREAD_ID].getPosition());
+    this->positions[lastAlteredIdx] = this->positions[this->size() + OMP_THREAD_ID];
     if (this->numInteractionCentres != 0)
         this->acceptTempInteractionCentres();
 
     if (this->neighbourGrid.has_value()) {
         if (this->numInteractionCentres == 0)
-            this->neighbourGrid->add(lastAlteredIdx, this->shapes[lastAlteredIdx].getPosition());
+            this->neighbourGrid->move(lastAlteredIdx, this->getAbsolutePosition(lastAlteredIdx));
         else
-            this->addInteractionCentresToNeighbourGrid(lastAlteredIdx);
+            this->moveInteractionCentresInNeighbourGrid(lastAlteredIdx);
     }
 
+    this->checkVerletListDisplacement(lastAlteredIdx);
+
     if (this->overlapCounting) {
         #pragma omp critical
         this->numOverlaps += this->lastMoveOverlapDeltas[OMP_THREAD_ID];
@@ -259,15 +337,14 @@ void Packing::acceptTranslation() {
 
 void Packing::acceptRotation() {
     std::size_t lastAlteredIdx = this->lastAlteredParticleIdx[OMP_THREAD_ID];
-    if (this->neighbourGrid.has_value() && this->numInteractionCentres != 0)
-        this->removeInteractionCentresFromNeighbourGrid(lastAlteredIdx);
-
-    this->shapes[lastAlteredIdx].setOrientation(this->shapes[size() + OMP_THREAD_ID].getOrientation());
+    this->orientations[lastAlteredIdx] = this->orientations[this->size() + OMP_THREAD_ID];
     if (this->numInteractionCentres != 0)
         this->acceptTempInteractionCentres();
 
     if (this->neighbourGrid.has_value() && this->numInteractionCentres != 0)
-        this->addInteractionCentresToNeighbourGrid(lastAlteredIdx);
+        this->moveInteractionCentresInNeighbourGrid(lastAlteredIdx);
+
+    this->checkVerletListDisplacement(lastAlteredIdx);
 
     if (this->overlapCounting) {
         #pragma omp critical
@@ -277,37 +354,45 @@ void Packing::acceptRotation() {
 
 void Packing::acceptMove() {
     std::size_t lastAlteredIdx = this->lastAlteredParticleIdx[OMP_THREAD_ID];
-    if (this->neighbourGrid.has_value()) {
-        if (this->numInteractionCentres == 0)
-            this->neighbourGrid->remove(lastAlteredIdx, this->shapes[lastAlteredIdx].getPosition());
-        else
-            this->removeInteractionCentresFromNeighbourGrid(lastAlteredIdx);
-    }
-
-    this->shapes[lastAlteredIdx] = this->shapes[this->size() + OMP_THREAD_ID];
+    this->positions[lastAlteredIdx] = this->positions[this->size() + OMP_THREAD_ID];
+    this->orientations[lastAlteredIdx] = this->orientations[this->size() + OMP_THREAD_ID];
     if (this->numInteractionCentres != 0)
         this->acceptTempInteractionCentres();
 
     if (this->neighbourGrid.has_value()) {
         if (this->numInteractionCentres == 0)
-            this->neighbourGrid->add(lastAlteredIdx, this->shapes[lastAlteredIdx].getPosition());
+            this->neighbourGrid->move(lastAlteredIdx, this->getAbsolutePosition(lastAlteredIdx));
         else
-            this->addInteractionCentresToNeighbourGrid(lastAlteredIdx);
+            this->moveInteractionCentresInNeighbourGrid(lastAlteredIdx);
     }
 
+    this->checkVerletListDisplacement(lastAlteredIdx);
+
     if (this->overlapCounting) {
         #pragma omp critical
         this->numOverlaps += this->lastMoveOverlapDeltas[OMP_THREAD_ID];
     }
 }
 
+template<typename Visitor>
+decltype(auto) Packing::visitInteraction(const Interaction &interaction, Visitor &&visitor) const {
+    bool isSetUp = this->setUpInteractionTypeInfo != nullptr && typeid(interaction) == *this->setUpInteractionTypeInfo;
+    DevirtualisedInteraction type = isSetUp ? this->setUpInteractionType : get_devirtualised_interaction(interaction);
+    return visit_devirtualised_interaction(interaction, type, std::forward<Visitor>(visitor));
+}
+
 double Packing::calculateMoveOverlapEnergy(size_t particleIdx, size_t tempParticleIdx, const Interaction &interaction) {
     static constexpr double INF = std::numeric_limits<double>::infinity();
 
-    if (interaction.hasHardPart()) {
+    if (!interaction.hasHardPart())
+        return 0;
+
+    return this->visitInteraction(interaction, [&](const auto &concreteInteraction) {
         if (this->overlapCounting) {
-            std::size_t initialOverlaps = this->countParticleOverlaps(particleIdx, particleIdx, interaction, false);
-            std::size_t finalOverlaps = this->countParticleOverlaps(particleIdx, tempParticleIdx, interaction, false);
+            std::size_t initialOverlaps = this->countParticleOverlaps(particleIdx, particleIdx, concreteInteraction,
+                                                                      false);
+            std::size_t finalOverlaps = this->countParticleOverlaps(particleIdx, tempParticleIdx, concreteInteraction,
+                                                                    false);
             auto &lastMoveOverlapDelta = this->lastMoveOverlapDeltas[OMP_THREAD_ID];
             lastMoveOverlapDelta = static_cast<int>(finalOverlaps) - initialOverlaps;
             if (lastMoveOverlapDelta < 0)
@@ -315,24 +400,33 @@ double Packing::calculateMoveOverlapEnergy(size_t particleIdx, size_t tempPartic
             else if (lastMoveOverlapDelta > 0)
                 return INF;
         } else {
-            if (this->countParticleOverlaps(particleIdx, tempParticleIdx, interaction, true) > 0)
+            if (this->countParticleOverlaps(particleIdx, tempParticleIdx, concreteInteraction, true) > 0)
                 return INF;
         }
-    }
-    return 0;
+        return 0.;
+    });
 }
 
-void Packing::addInteractionCentresToNeighbourGrid(std::size_t particleIdx) {
-    for (size_t i{}; i < this->numInteractionCentres; i++) {
-        std::size_t centreIdx = particleIdx * this->numInteractionCentres + i;
-        this->neighbourGrid->add(centreIdx, this->absoluteInteractionCentres[centreIdx]);
-    }
+double Packing::calculateMoveEnergy(std::size_t particleIdx, std::size_t tempParticleIdx,
+                                    const Interaction &interaction) const
+{
+    if (!interaction.hasSoftPart())
+        return 0;
+
+    return this->visitInteraction(interaction, [&](const auto &concreteInteraction) {
+        double initialEnergy = this->calculateParticleEnergy(particleIdx, particleIdx, concreteInteraction);
+        double finalEnergy = this->calculateParticleEnergy(particleIdx, tempParticleIdx, concreteInteraction);
+        return finalEnergy - initialEnergy;
+    });
 }
 
-void Packing::removeInteractionCentresFromNeighbourGrid(std::size_t particleIdx) {
+void Packing::moveInteractionCentresInNeighbourGrid(std::size_t particleIdx) {
     for (size_t i{}; i < this->numInteractionCentres; i++) {
         std::size_t centreIdx = particleIdx * this->numInteractionCentres + i;
-        this->neighbourGrid->remove(centreIdx, this->absoluteInteractionCentres[centreIdx]);
+        auto centrePos = this->getAbsoluteInteractionCentre(centreIdx);
+        this->neighbourGrid->move(centreIdx, centrePos);
+        if (!this->neighbourGridLevels.empty())
+            this->neighbourGridLevels[this->interactionCentreLevels[i]].neighbourGrid.move(centreIdx, centrePos);
     }
 }
 
@@ -347,6 +441,12 @@ void Packing::acceptTempInteractionCentres() {
     }
 }
 
+void Packing::translateTempPosition(std::size_t particleIdx, const Vector<3> &translation) {
+    Vector<3> tempPosition = this->getAbsolutePosition(particleIdx) + translation;
+    tempPosition += this->bc->getCorrection(tempPosition);
+    this->positions[this->size() + OMP_THREAD_ID] = this->toStoredPosition(tempPosition);
+}
+
 void Packing::prepareTempInteractionCentres(std::size_t particleIdx) {
     std::size_t fromOrigin = particleIdx * this->numInteractionCentres;
     std::size_t toOrigin = (this->size() + OMP_THREAD_ID) * this->numInteractionCentres;
@@ -354,49 +454,76 @@ void Packing::prepareTempInteractionCentres(std::size_t particleIdx) {
         this->interactionCentres[toOrigin + i] = this->interactionCentres[fromOrigin + i];
 }
 
-void Packing::rotateTempInteractionCentres(const Matrix<3, 3> &rotation) {
-    std::size_t idxOrigin = (this->size() + OMP_THREAD_ID) * this->numInteractionCentres;
+void Packing::rotateTempInteractionCentres([[maybe_unused]] const Matrix<3, 3> &rotation) {
+    std::size_t tempParticleIdx = this->size() + OMP_THREAD_ID;
+    std::size_t idxOrigin = tempParticleIdx * this->numInteractionCentres;
+#ifdef RAMPACK_QUATERNION_ORIENTATIONS
+    // Orientations are not renormalized periodically, so centres are derived from the (normalized) orientation
+    // instead of being rotated incrementally - otherwise numerical errors of subsequent rotations would accumulate
+    Matrix<3, 3> orientation = this->getOrientationMatrix(tempParticleIdx);
+    for (std::size_t i{}; i < this->numInteractionCentres; i++)
+        this->interactionCentres[idxOrigin + i] = orientation * this->bodyFrameInteractionCentres[i];
+#else
     for (std::size_t i{}; i < this->numInteractionCentres; i++)
         this->interactionCentres[idxOrigin + i] = rotation * this->interactionCentres[idxOrigin + i];
+#endif
 }
 
 void Packing::revertScaling() {
-    this->shapes = this->lastShapes;
+#ifndef RAMPACK_SINGLE_PRECISION_POSITIONS
+    std::swap(this->positions, this->lastPositions);
+#endif
     this->box = this->lastBox;
     this->bc->setBox(this->box);
-    std::swap(this->neighbourGrid, this->tempNeighbourGrid);
     if (this->numInteractionCentres != 0)
-        this->recalculateAbsoluteInteractionCentres();
+        std::swap(this->absoluteInteractionCentres, this->lastAbsoluteInteractionCentres);
+    if (this->lastScalingRescaledNeighbourGrid) {
+        // Cell divisions were the same for the old box, so rescaling back has to succeed
+        [[maybe_unused]] bool rescaled = this->rescaleNeighbourGrid();
+        Assert(rescaled);
+    } else if (this->leanNeighbourGrid) {
+        // There is no old neighbour grid to swap back to
+        this->rebuildNeighbourGrid();
+    } else {
+        std::swap(this->neighbourGrid, this->tempNeighbourGrid);
+        std::swap(this->neighbourGridLevels, this->tempNeighbourGridLevels);
+    }
     this->numOverlaps = this->lastScalingNumOverlaps;
+    this->verletListsValid = this->lastScalingVerletListsValid;
 }
 
+template<typename ConcreteInteraction>
 std::size_t Packing::countParticleOverlaps(std::size_t originalParticleIdx, std::size_t tempParticleIdx,
-                                           const Interaction &interaction, bool earlyExit) const
+                                           const ConcreteInteraction &interaction, bool earlyExit) const
 {
     std::size_t overlapsCounted{};
 
-    if (this->neighbourGrid.has_value()) {
+    if (this->canUseVerletLists(originalParticleIdx, tempParticleIdx)) {
+        overlapsCounted = this->countParticleOverlapsWithVerletLists(originalParticleIdx, tempParticleIdx, interaction,
+                                                                     earlyExit);
+    } else if (this->neighbourGrid.has_value()) {
         if (this->numInteractionCentres == 0) {
-            Vector<3> pos = this->shapes[tempParticleIdx].getPosition();
+            const auto &pos = this->getAbsolutePosition(tempParticleIdx);
+            const auto &orientation = this->getOrientationMatrix(tempParticleIdx);
+            auto &batch = this->overlapBatches[OMP_THREAD_ID];
+            batch.reset(interaction.needsBatchOrientations());
             for (const auto &cell : this->neighbourGrid->getNeighbouringCells(pos)) {
-                HardcodedTranslation cellTranslation(cell.getTranslation());
+                const auto &translation = cell.getTranslation();
                 for (auto j: cell.getNeighbours()) {
                     if (originalParticleIdx == j)
                         continue;
 
-                    if (interaction.overlapBetween(this->shapes[tempParticleIdx].getPosition(),
-                                                   this->shapes[tempParticleIdx].getOrientation(),
-                                                   0,
-                                                   this->shapes[j].getPosition(),
-                                                   this->shapes[j].getOrientation(),
-                                                   0,
-                                                   cellTranslation))
-                    {
-                        if (earlyExit) return 1;
-                        overlapsCounted++;
-                    }
+                    const auto &pos2 = this->getAbsolutePosition(j);
+                    // Range is checked here only to avoid copying orientations - otherwise the interaction checks it
+                    // together with the overlap
+                    if (batch.hasOrientations() && !this->isWithinInteractionRange(pos, pos2, translation))
+                        continue;
+
+                    this->addToOverlapBatch(batch, j, 0, pos2 + translation);
                 }
             }
+            batch.calculateDistances2(pos);
+            overlapsCounted = interaction.countOverlapsInBatch(pos, orientation, 0, batch, earlyExit);
         } else {
             for (std::size_t centre1{}; centre1 < this->numInteractionCentres; centre1++) {
                 std::size_t centreOverlaps = this->countInteractionCentreOverlapsWithNG(originalParticleIdx,
@@ -428,8 +555,9 @@ std::size_t Packing::countParticleOverlaps(std::size_t originalParticleIdx, std:
     return overlapsCounted + wallOverlaps;
 }
 
+template<typename ConcreteInteraction>
 std::size_t Packing::countTotalOverlapsNGCellHelper(const std::array<std::size_t, 3> &coord,
-                                                    const Interaction &interaction, bool earlyExit) const
+                                                    const ConcreteInteraction &interaction, bool earlyExit) const
 {
     std::size_t overlapsCounted{};
 
@@ -437,15 +565,17 @@ std::size_t Packing::countTotalOverlapsNGCellHelper(const std::array<std::size_t
         const auto &cellView = this->neighbourGrid->getCell(coord);
         for (auto cellIt1 = cellView.begin(); cellIt1 != cellView.end(); cellIt1++) {
             std::size_t particleIdx1 = *cellIt1;
-            const auto &pos1 = this->shapes[particleIdx1].getPosition();
-            const auto &orientation1 = this->shapes[particleIdx1].getOrientation();
+            const auto &pos1 = this->getAbsolutePosition(particleIdx1);
+            const auto &orientation1 = this->getOrientationMatrix(particleIdx1);
 
             // Overlaps within the cell
             HardcodedTranslation noTranslation({});
             for (auto cellIt2 = std::next(cellIt1); cellIt2 != cellView.end(); cellIt2++) {
                 std::size_t particleIdx2 = *cellIt2;
-                const auto &pos2 = this->shapes[particleIdx2].getPosition();
-                const auto &orientation2 = this->shapes[particleIdx2].getOrientation();
+                const auto &pos2 = this->getAbsolutePosition(particleIdx2);
+                if (!this->isWithinInteractionRange(pos1, pos2, {}))
+                    continue;
+                const auto &orientation2 = this->getOrientationMatrix(particleIdx2);
                 if (interaction.overlapBetween(pos1, orientation1, 0, pos2, orientation2, 0, noTranslation)) {
                     if (earlyExit) return 1;
                     overlapsCounted++;
@@ -454,10 +584,13 @@ std::size_t Packing::countTotalOverlapsNGCellHelper(const std::array<std::size_t
 
             // Overlaps with other cells (but only with a half to avoid redundant checks)
             for (const auto &cell : this->neighbourGrid->getNeighbouringCells(coord, true)) {
-                HardcodedTranslation cellTranslation(cell.getTranslation());
+                const auto &translation = cell.getTranslation();
+                HardcodedTranslation cellTranslation(translation);
                 for (auto particleIdx2 : cell.getNeighbours()) { // NOLINT(readability-use-anyofallof)
-                    const auto &pos2 = this->shapes[particleIdx2].getPosition();
-                    const auto &orientation2 = this->shapes[particleIdx2].getOrientation();
+                    const auto &pos2 = this->getAbsolutePosition(particleIdx2);
+                    if (!this->isWithinInteractionRange(pos1, pos2, translation))
+                        continue;
+                    const auto &orientation2 = this->getOrientationMatrix(particleIdx2);
                     if (interaction.overlapBetween(pos1, orientation1, 0, pos2, orientation2, 0, cellTranslation)) {
                         if (earlyExit) return 1;
                         overlapsCounted++;
@@ -471,8 +604,8 @@ std::size_t Packing::countTotalOverlapsNGCellHelper(const std::array<std::size_t
             std::size_t centreIdx1 = *cellIt1;
             std::size_t particleIdx1 = centreIdx1 / this->numInteractionCentres;
             std::size_t centre1 = centreIdx1 % this->numInteractionCentres;
-            const auto &pos1 = this->absoluteInteractionCentres[centreIdx1];
-            const auto &orientation1 = this->shapes[particleIdx1].getOrientation();
+            const auto &pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
+            const auto &orientation1 = this->getOrientationMatrix(particleIdx1);
 
             // Overlaps within the cell
             HardcodedTranslation noTranslation({});
@@ -481,9 +614,11 @@ std::size_t Packing::countTotalOverlapsNGCellHelper(const std::array<std::size_t
                 std::size_t particleIdx2 = centreIdx2 / this->numInteractionCentres;
                 if (particleIdx1 == particleIdx2)
                     continue;
+                const auto &pos2 = this->getAbsoluteInteractionCentre(centreIdx2);
+                if (!this->isWithinInteractionRange(pos1, pos2, {}))
+                    continue;
                 std::size_t centre2 = centreIdx2 % this->numInteractionCentres;
-                const auto &pos2 = this->absoluteInteractionCentres[centreIdx2];
-                const auto &orientation2 = this->shapes[particleIdx2].getOrientation();
+                const auto &orientation2 = this->getOrientationMatrix(particleIdx2);
                 if (interaction.overlapBetween(pos1, orientation1, centre1, pos2, orientation2, centre2,
                                                noTranslation))
                 {
@@ -494,14 +629,17 @@ std::size_t Packing::countTotalOverlapsNGCellHelper(const std::array<std::size_t
 
             // Overlaps with other cells (but only with a half to avoid redundant checks)
             for (const auto &cell : this->neighbourGrid->getNeighbouringCells(coord, true)) {
-                HardcodedTranslation cellTrans(cell.getTranslation());
+                const auto &translation = cell.getTranslation();
+                HardcodedTranslation cellTrans(translation);
                 for (auto centreIdx2 : cell.getNeighbours()) { // NOLINT(readability-use-anyofallof)
                     std::size_t particleIdx2 = centreIdx2 / this->numInteractionCentres;
                     if (particleIdx1 == particleIdx2)
                         continue;
+                    const auto &pos2 = this->getAbsoluteInteractionCentre(centreIdx2);
+                    if (!this->isWithinInteractionRange(pos1, pos2, translation))
+                        continue;
                     std::size_t centre2 = centreIdx2 % this->numInteractionCentres;
-                    const auto &pos2 = this->absoluteInteractionCentres[centreIdx2];
-                    const auto &orientation2 = this->shapes[particleIdx2].getOrientation();
+                    const auto &orientation2 = this->getOrientationMatrix(particleIdx2);
                     if (interaction.overlapBetween(pos1, orientation1, centre1, pos2, orientation2, centre2,
                                                    cellTrans))
                     {
@@ -517,6 +655,17 @@ std::size_t Packing::countTotalOverlapsNGCellHelper(const std::array<std::size_t
 }
 
 std::size_t Packing::countTotalOverlaps(const Interaction &interaction, bool earlyExit) const {
+    std::size_t overlapsCounted = this->visitInteraction(interaction, [&](const auto &concreteInteraction) {
+        return this->countTotalOverlapsHelper(concreteInteraction, earlyExit);
+    });
+    if (earlyExit && overlapsCounted > 0)
+        return overlapsCounted;
+
+    return overlapsCounted + this->countWallOverlaps(interaction, earlyExit);
+}
+
+template<typename ConcreteInteraction>
+std::size_t Packing::countTotalOverlapsHelper(const ConcreteInteraction &interaction, bool earlyExit) const {
     std::size_t overlapsCounted{};
 
     if (this->neighbourGrid.has_value()) {
@@ -555,7 +704,7 @@ std::size_t Packing::countTotalOverlaps(const Interaction &interaction, bool ear
         }
     }
 
-    return overlapsCounted + this->countWallOverlaps(interaction, earlyExit);
+    return overlapsCounted;
 }
 
 std::size_t Packing::countWallOverlaps(const Interaction &interaction, bool earlyExit) const {
@@ -579,17 +728,19 @@ std::size_t Packing::countWallOverlaps(const Interaction &interaction, bool earl
     return wallOverlaps;
 }
 
+template<typename ConcreteInteraction>
 std::size_t Packing::countOverlapsBetweenParticlesWithoutNG(std::size_t tempParticleIdx, std::size_t anotherParticleIdx,
-                                                            const Interaction &interaction, bool earlyExit) const
+                                                            const ConcreteInteraction &interaction,
+                                                            bool earlyExit) const
 {
     std::size_t overlapsCounted{};
 
     if (this->numInteractionCentres == 0) {
-        if (interaction.overlapBetween(this->shapes[tempParticleIdx].getPosition(),
-                                       this->shapes[tempParticleIdx].getOrientation(),
+        if (interaction.overlapBetween(this->getAbsolutePosition(tempParticleIdx),
+                                       this->getOrientationMatrix(tempParticleIdx),
                                        0,
-                                       this->shapes[anotherParticleIdx].getPosition(),
-                                       this->shapes[anotherParticleIdx].getOrientation(),
+                                       this->getAbsolutePosition(anotherParticleIdx),
+                                       this->getOrientationMatrix(anotherParticleIdx),
                                        0,
                                        *this->bc))
         {
@@ -599,12 +750,12 @@ std::size_t Packing::countOverlapsBetweenParticlesWithoutNG(std::size_t tempPart
     } else {
         for (std::size_t centre1{}; centre1 < this->numInteractionCentres; centre1++) {
             std::size_t centreIdx1 = tempParticleIdx * this->numInteractionCentres + centre1;
-            const auto &pos1 = this->absoluteInteractionCentres[centreIdx1];
-            const auto &orientation1 = this->shapes[tempParticleIdx].getOrientation();
+            const auto &pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
+            const auto &orientation1 = this->getOrientationMatrix(tempParticleIdx);
             for (std::size_t centre2{}; centre2 < this->numInteractionCentres; centre2++) {
                 std::size_t centreIdx2 = anotherParticleIdx * this->numInteractionCentres + centre2;
-                const auto &pos2 = this->absoluteInteractionCentres[centreIdx2];
-                const auto &orientation2 = this->shapes[anotherParticleIdx].getOrientation();
+                const auto &pos2 = this->getAbsoluteInteractionCentre(centreIdx2);
+                const auto &orientation2 = this->getOrientationMatrix(anotherParticleIdx);
                 if (interaction.overlapBetween(pos1, orientation1, centre1, pos2, orientation2, centre2, *this->bc)) {
                     if (earlyExit) return 1;
                     overlapsCounted++;
@@ -616,59 +767,128 @@ std::size_t Packing::countOverlapsBetweenParticlesWithoutNG(std::size_t tempPart
     return overlapsCounted;
 }
 
+template<typename ConcreteInteraction>
+std::size_t Packing::countParticleOverlapsWithVerletLists(std::size_t originalParticleIdx,
+                                                          std::size_t tempParticleIdx,
+                                                          const ConcreteInteraction &interaction, bool earlyExit) const
+{
+    std::size_t overlapsCounted{};
+
+    std::size_t centresPerParticle = std::max<std::size_t>(this->numInteractionCentres, 1);
+    bool useSeparatingDirections = !this->verletListSeparatingDirections.empty()
+                                   && interaction.usesSeparatingDirections();
+    const auto &orientation1 = this->getOrientationMatrix(tempParticleIdx);
+    for (std::size_t centre1{}; centre1 < centresPerParticle; centre1++) {
+        auto pos1 = this->getNeighbourGridObjectPosition(tempParticleIdx * centresPerParticle + centre1);
+        std::size_t listIdx = originalParticleIdx * centresPerParticle + centre1;
+        for (std::size_t i = this->verletListOffsets[listIdx]; i < this->verletListOffsets[listIdx + 1]; i++) {
+            const auto &entry = this->verletListEntries[i];
+            const auto &translation = this->verletListTranslations[entry.translationIdx];
+            auto pos2 = this->getNeighbourGridObjectPosition(entry.centreIdx);
+            if (!this->isWithinInteractionRange(pos1, pos2, translation))
+                continue;
+
+            std::size_t j = entry.centreIdx / centresPerParticle;
+            std::size_t centre2 = entry.centreIdx % centresPerParticle;
+            HardcodedTranslation entryTranslation(translation);
+            bool overlap = useSeparatingDirections
+                ? interaction.overlapBetweenWithHint(pos1, orientation1, centre1, pos2, this->getOrientationMatrix(j),
+                                                     centre2, entryTranslation,
+                                                     this->verletListSeparatingDirections[i])
+                : interaction.overlapBetween(pos1, orientation1, centre1, pos2, this->getOrientationMatrix(j), centre2,
+                                             entryTranslation);
+            if (overlap) {
+                if (earlyExit) return 1;
+                overlapsCounted++;
+            }
+        }
+    }
+
+    return overlapsCounted;
+}
+
+template<typename ConcreteInteraction>
 std::size_t Packing::countInteractionCentreOverlapsWithNG(std::size_t originalParticleIdx, std::size_t tempParticleIdx,
-                                                          std::size_t centre, const Interaction &interaction,
+                                                          std::size_t centre, const ConcreteInteraction &interaction,
                                                           bool earlyExit) const
 {
     Expects(this->neighbourGrid.has_value());
 
+    std::size_t centreIdx1 = tempParticleIdx * this->numInteractionCentres + centre;
+    auto pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
+    if (this->neighbourGridLevels.empty()) {
+        return this->countInteractionCentreOverlapsInCells(originalParticleIdx, tempParticleIdx, centre,
+                                                           this->neighbourGrid->getNeighbouringCells(pos1),
+                                                           interaction, earlyExit);
+    }
+
     std::size_t overlapsCounted{};
+    for (const auto &level : this->neighbourGridLevels) {
+        auto cells = level.neighbourGrid.getExtendedNeighbouringCells(pos1, level.queryLayers[centre]);
+        overlapsCounted += this->countInteractionCentreOverlapsInCells(originalParticleIdx, tempParticleIdx, centre,
+                                                                       cells, interaction, earlyExit);
+        if (earlyExit && overlapsCounted > 0)
+            return overlapsCounted;
+    }
+    return overlapsCounted;
+}
 
+template<typename ConcreteInteraction>
+std::size_t Packing::countInteractionCentreOverlapsInCells(std::size_t originalParticleIdx,
+                                                           std::size_t tempParticleIdx, std::size_t centre,
+                                                           const NeighbourGrid::NeighboursView &cells,
+                                                           const ConcreteInteraction &interaction, bool earlyExit) const
+{
     std::size_t centreIdx1 = tempParticleIdx * this->numInteractionCentres + centre;
-    auto pos1 = this->absoluteInteractionCentres[centreIdx1];
-    const auto &orientation1 = this->shapes[tempParticleIdx].getOrientation();
-    for (const auto &cell : this->neighbourGrid->getNeighbouringCells(pos1)) {
-        HardcodedTranslation cellTranslation(cell.getTranslation());
-        for (auto centreIdx2 : cell.getNeighbours()) { // NOLINT(readability-use-anyofallof)
+    auto pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
+    const auto &orientation1 = this->getOrientationMatrix(tempParticleIdx);
+    auto &batch = this->overlapBatches[OMP_THREAD_ID];
+    batch.reset(interaction.needsBatchOrientations());
+    for (const auto &cell : cells) {
+        const auto &translation = cell.getTranslation();
+        for (auto centreIdx2 : cell.getNeighbours()) {
             std::size_t j = centreIdx2 / this->numInteractionCentres;
             if (j == originalParticleIdx)
                 continue;
+            const auto &pos2 = this->getAbsoluteInteractionCentre(centreIdx2);
             std::size_t centre2 = centreIdx2 % this->numInteractionCentres;
-            const auto &pos2 = this->absoluteInteractionCentres[centreIdx2];
-            const auto &orientation2 = this->shapes[j].getOrientation();
-            if (interaction.overlapBetween(pos1, orientation1, centre, pos2, orientation2, centre2, cellTranslation)){
-                if (earlyExit) return 1;
-                overlapsCounted++;
-            }
+            // The same as in countParticleOverlaps
+            if (batch.hasOrientations() && !this->isWithinInteractionRange(centre, pos1, centre2, pos2, translation))
+                continue;
+
+            this->addToOverlapBatch(batch, j, centre2, pos2 + translation);
         }
     }
-
-    return overlapsCounted;
+    batch.calculateDistances2(pos1);
+    return interaction.countOverlapsInBatch(pos1, orientation1, centre, batch, earlyExit);
 }
 
+template<typename ConcreteInteraction>
 double Packing::calculateParticleEnergy(std::size_t originalParticleIdx, std::size_t tempParticleIdx,
-                                        const Interaction &interaction) const
+                                        const ConcreteInteraction &interaction) const
 {
     Expects(originalParticleIdx < this->size());
     if (!interaction.hasSoftPart())
         return 0;
 
     double energy{};
-    if (this->neighbourGrid.has_value()) {
+    if (this->canUseVerletLists(originalParticleIdx, tempParticleIdx)) {
+        energy = this->calculateParticleEnergyWithVerletLists(originalParticleIdx, tempParticleIdx, interaction);
+    } else if (this->neighbourGrid.has_value()) {
         if (this->numInteractionCentres == 0) {
-            const auto &pos = this->shapes[tempParticleIdx].getPosition();
+            const auto &pos = this->getAbsolutePosition(tempParticleIdx);
+            const auto &orientation = this->getOrientationMatrix(tempParticleIdx);
             for (const auto &cell : this->neighbourGrid->getNeighbouringCells(pos)) {
-                HardcodedTranslation cellTranslation(cell.getTranslation());
+                const auto &translation = cell.getTranslation();
+                HardcodedTranslation cellTranslation(translation);
                 for (auto j : cell.getNeighbours()) {
                     if (originalParticleIdx == j)
                         continue;
-                    energy += interaction.calculateEnergyBetween(this->shapes[tempParticleIdx].getPosition(),
-                                                                 this->shapes[tempParticleIdx].getOrientation(),
-                                                                 0,
-                                                                 this->shapes[j].getPosition(),
-                                                                 this->shapes[j].getOrientation(),
-                                                                 0,
-                                                                 cellTranslation);
+                    const auto &pos2 = this->getAbsolutePosition(j);
+                    if (!this->isWithinInteractionRange(pos, pos2, translation))
+                        continue;
+                    energy += interaction.calculateEnergyBetween(pos, orientation, 0, pos2,
+                                                                 this->getOrientationMatrix(j), 0, cellTranslation);
                 }
             }
         } else {
@@ -691,6 +911,13 @@ double Packing::getTotalEnergy(const Interaction &interaction) const {
     if (!interaction.hasSoftPart())
         return 0;
 
+    return this->visitInteraction(interaction, [this](const auto &concreteInteraction) {
+        return this->getTotalEnergyHelper(concreteInteraction);
+    });
+}
+
+template<typename ConcreteInteraction>
+double Packing::getTotalEnergyHelper(const ConcreteInteraction &interaction) const {
     double energy{};
     if (this->neighbourGrid.has_value()) {
         auto cellDivisions = this->neighbourGrid->getCellDivisions();
@@ -708,27 +935,28 @@ double Packing::getTotalEnergy(const Interaction &interaction) const {
     return energy;
 }
 
+template<typename ConcreteInteraction>
 double Packing::calculateEnergyBetweenParticlesWithoutNG(std::size_t tempParticleIdx, std::size_t anotherParticleIdx,
-                                                         const Interaction &interaction) const
+                                                         const ConcreteInteraction &interaction) const
 {
     double energy = 0;
     if (this->numInteractionCentres == 0) {
-        energy += interaction.calculateEnergyBetween(this->shapes[tempParticleIdx].getPosition(),
-                                                     this->shapes[tempParticleIdx].getOrientation(),
+        energy += interaction.calculateEnergyBetween(this->getAbsolutePosition(tempParticleIdx),
+                                                     this->getOrientationMatrix(tempParticleIdx),
                                                      0,
-                                                     this->shapes[anotherParticleIdx].getPosition(),
-                                                     this->shapes[anotherParticleIdx].getOrientation(),
+                                                     this->getAbsolutePosition(anotherParticleIdx),
+                                                     this->getOrientationMatrix(anotherParticleIdx),
                                                      0,
                                                      *this->bc);
     } else {
         for (size_t centre1{}; centre1 < this->numInteractionCentres; centre1++) {
             std::size_t centreIdx1 = tempParticleIdx * this->numInteractionCentres + centre1;
-            const auto &pos1 = this->absoluteInteractionCentres[centreIdx1];
-            const auto &orientation1 = this->shapes[tempParticleIdx].getOrientation();
+            const auto &pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
+            const auto &orientation1 = this->getOrientationMatrix(tempParticleIdx);
             for (size_t centre2{}; centre2 < this->numInteractionCentres; centre2++) {
                 std::size_t centreIdx2 = anotherParticleIdx * this->numInteractionCentres + centre2;
-                const auto &pos2 = this->absoluteInteractionCentres[centreIdx2];
-                const auto &orientation2 =  this->shapes[anotherParticleIdx].getOrientation();
+                const auto &pos2 = this->getAbsoluteInteractionCentre(centreIdx2);
+                const auto &orientation2 = this->getOrientationMatrix(anotherParticleIdx);
                 energy += interaction.calculateEnergyBetween(pos1, orientation1, centre1, pos2, orientation2, centre2,
                                                              *this->bc);
             }
@@ -737,25 +965,82 @@ double Packing::calculateEnergyBetweenParticlesWithoutNG(std::size_t tempParticl
     return energy;
 }
 
+template<typename ConcreteInteraction>
+double Packing::calculateParticleEnergyWithVerletLists(std::size_t originalParticleIdx, std::size_t tempParticleIdx,
+                                                       const ConcreteInteraction &interaction) const
+{
+    double energy{};
+
+    std::size_t centresPerParticle = std::max<std::size_t>(this->numInteractionCentres, 1);
+    const auto &orientation1 = this->getOrientationMatrix(tempParticleIdx);
+    for (std::size_t centre1{}; centre1 < centresPerParticle; centre1++) {
+        auto pos1 = this->getNeighbourGridObjectPosition(tempParticleIdx * centresPerParticle + centre1);
+        std::size_t listIdx = originalParticleIdx * centresPerParticle + centre1;
+        for (std::size_t i = this->verletListOffsets[listIdx]; i < this->verletListOffsets[listIdx + 1]; i++) {
+            const auto &entry = this->verletListEntries[i];
+            const auto &translation = this->verletListTranslations[entry.translationIdx];
+            auto pos2 = this->getNeighbourGridObjectPosition(entry.centreIdx);
+            if (!this->isWithinInteractionRange(pos1, pos2, translation))
+                continue;
+
+            std::size_t j = entry.centreIdx / centresPerParticle;
+            std::size_t centre2 = entry.centreIdx % centresPerParticle;
+            HardcodedTranslation entryTranslation(translation);
+            const auto &orientation2 = this->getOrientationMatrix(j);
+            energy += interaction.calculateEnergyBetween(pos1, orientation1, centre1, pos2, orientation2, centre2,
+                                                         entryTranslation);
+        }
+    }
+
+    return energy;
+}
+
+template<typename ConcreteInteraction>
 double Packing::calculateInteractionCentreEnergyWithNG(size_t originalParticleIdx, std::size_t tempParticleIdx,
-                                                       std::size_t centre, const Interaction &interaction) const
+                                                       std::size_t centre, const ConcreteInteraction &interaction) const
 {
     Expects(this->neighbourGrid.has_value());
 
+    std::size_t centreIdx1 = tempParticleIdx * this->numInteractionCentres + centre;
+    auto pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
+    if (this->neighbourGridLevels.empty()) {
+        return this->calculateInteractionCentreEnergyInCells(originalParticleIdx, tempParticleIdx, centre,
+                                                             this->neighbourGrid->getNeighbouringCells(pos1),
+                                                             interaction);
+    }
+
+    double energy{};
+    for (const auto &level : this->neighbourGridLevels) {
+        auto cells = level.neighbourGrid.getExtendedNeighbouringCells(pos1, level.queryLayers[centre]);
+        energy += this->calculateInteractionCentreEnergyInCells(originalParticleIdx, tempParticleIdx, centre, cells,
+                                                                interaction);
+    }
+    return energy;
+}
+
+template<typename ConcreteInteraction>
+double Packing::calculateInteractionCentreEnergyInCells(std::size_t originalParticleIdx, std::size_t tempParticleIdx,
+                                                        std::size_t centre,
+                                                        const NeighbourGrid::NeighboursView &cells,
+                                                        const ConcreteInteraction &interaction) const
+{
     double energy{};
 
     std::size_t centreIdx1 = tempParticleIdx * this->numInteractionCentres + centre;
-    auto pos1 = this->absoluteInteractionCentres[centreIdx1];
-    const auto &orientation1 = this->shapes[tempParticleIdx].getOrientation();
-    for (const auto &cell : this->neighbourGrid->getNeighbouringCells(pos1)) {
-        HardcodedTranslation cellTranslation(cell.getTranslation());
+    auto pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
+    const auto &orientation1 = this->getOrientationMatrix(tempParticleIdx);
+    for (const auto &cell : cells) {
+        const auto &translation = cell.getTranslation();
+        HardcodedTranslation cellTranslation(translation);
         for (auto centreIdx2 : cell.getNeighbours()) {
             size_t j = centreIdx2 / this->numInteractionCentres;
             if (j == originalParticleIdx)
                 continue;
+            const auto &pos2 = this->getAbsoluteInteractionCentre(centreIdx2);
             size_t centre2 = centreIdx2 % this->numInteractionCentres;
-            const auto &pos2 = this->absoluteInteractionCentres[centreIdx2];
-            const auto &orientation2 = this->shapes[j].getOrientation();
+            if (!this->isWithinInteractionRange(centre, pos1, centre2, pos2, translation))
+                continue;
+            const auto &orientation2 = this->getOrientationMatrix(j);
             energy += interaction.calculateEnergyBetween(pos1, orientation1, centre, pos2, orientation2, centre2,
                                                          cellTranslation);
         }
@@ -763,33 +1048,39 @@ double Packing::calculateInteractionCentreEnergyWithNG(size_t originalParticleId
     return energy;
 }
 
+template<typename ConcreteInteraction>
 double Packing::getTotalEnergyNGCellHelper(const std::array<std::size_t, 3> &coord,
-                                           const Interaction &interaction) const
+                                           const ConcreteInteraction &interaction) const
 {
     double energy{};
     if (this->numInteractionCentres == 0) {
         const auto &cellView = this->neighbourGrid->getCell(coord);
         for (auto cellIt1 = cellView.begin(); cellIt1 != cellView.end(); cellIt1++) {
             std::size_t particleIdx1 = *cellIt1;
-            const auto &pos1 = this->shapes[particleIdx1].getPosition();
-            const auto &orientation1 = this->shapes[particleIdx1].getOrientation();
+            const auto &pos1 = this->getAbsolutePosition(particleIdx1);
+            const auto &orientation1 = this->getOrientationMatrix(particleIdx1);
 
             // Energy within the cell
             HardcodedTranslation noTranslation({});
             for (auto cellIt2 = std::next(cellIt1); cellIt2 != cellView.end(); cellIt2++) {
                 std::size_t particleIdx2 = *cellIt2;
-                const auto &pos2 = this->shapes[particleIdx2].getPosition();
-                const auto &orientation2 = this->shapes[particleIdx2].getOrientation();
+                const auto &pos2 = this->getAbsolutePosition(particleIdx2);
+                if (!this->isWithinInteractionRange(pos1, pos2, {}))
+                    continue;
+                const auto &orientation2 = this->getOrientationMatrix(particleIdx2);
                 energy += interaction.calculateEnergyBetween(pos1, orientation1, 0, pos2, orientation2, 0,
                                                              noTranslation);
             }
 
             // Energy with other cells (but only with a half to avoid double calculations)
             for (const auto &cell : this->neighbourGrid->getNeighbouringCells(coord, true)) {
-                HardcodedTranslation cellTranslation(cell.getTranslation());
+                const auto &translation = cell.getTranslation();
+                HardcodedTranslation cellTranslation(translation);
                 for (auto particleIdx2 : cell.getNeighbours()) { // NOLINT(readability-use-anyofallof)
-                    const auto &pos2 = this->shapes[particleIdx2].getPosition();
-                    const auto &orientation2 = this->shapes[particleIdx2].getOrientation();
+                    const auto &pos2 = this->getAbsolutePosition(particleIdx2);
+                    if (!this->isWithinInteractionRange(pos1, pos2, translation))
+                        continue;
+                    const auto &orientation2 = this->getOrientationMatrix(particleIdx2);
                     energy += interaction.calculateEnergyBetween(pos1, orientation1, 0, pos2, orientation2, 0,
                                                                  cellTranslation);
                 }
@@ -801,8 +1092,8 @@ double Packing::getTotalEnergyNGCellHelper(const std::array<std::size_t, 3> &coo
             std::size_t centreIdx1 = *cellIt1;
             std::size_t particleIdx1 = centreIdx1 / this->numInteractionCentres;
             std::size_t centre1 = centreIdx1 % this->numInteractionCentres;
-            const auto &pos1 = this->absoluteInteractionCentres[centreIdx1];
-            const auto &orientation1 = this->shapes[particleIdx1].getOrientation();
+            const auto &pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
+            const auto &orientation1 = this->getOrientationMatrix(particleIdx1);
 
             // Energy within the cell
             HardcodedTranslation noTranslation({});
@@ -811,23 +1102,28 @@ double Packing::getTotalEnergyNGCellHelper(const std::array<std::size_t, 3> &coo
                 std::size_t particleIdx2 = centreIdx2 / this->numInteractionCentres;
                 if (particleIdx1 == particleIdx2)
                     continue;
+                const auto &pos2 = this->getAbsoluteInteractionCentre(centreIdx2);
+                if (!this->isWithinInteractionRange(pos1, pos2, {}))
+                    continue;
                 std::size_t centre2 = centreIdx2 % this->numInteractionCentres;
-                const auto &pos2 = this->absoluteInteractionCentres[centreIdx2];
-                const auto &orientation2 = this->shapes[particleIdx2].getOrientation();
+                const auto &orientation2 = this->getOrientationMatrix(particleIdx2);
                 energy += interaction.calculateEnergyBetween(pos1, orientation1, centre1, pos2, orientation2, centre2,
                                                              noTranslation);
             }
 
             // Energy with other cells (but only with a half to avoid double calculations)
             for (const auto &cell : this->neighbourGrid->getNeighbouringCells(coord, true)) {
-                HardcodedTranslation cellTranslation(cell.getTranslation());
+                const auto &translation = cell.getTranslation();
+                HardcodedTranslation cellTranslation(translation);
                 for (auto centreIdx2 : cell.getNeighbours()) { // NOLINT(readability-use-anyofallof)
                     std::size_t particleIdx2 = centreIdx2 / this->numInteractionCentres;
                     if (particleIdx1 == particleIdx2)
                         continue;
+                    const auto &pos2 = this->getAbsoluteInteractionCentre(centreIdx2);
+                    if (!this->isWithinInteractionRange(pos1, pos2, translation))
+                        continue;
                     std::size_t centre2 = centreIdx2 % this->numInteractionCentres;
-                    const auto &pos2 = this->absoluteInteractionCentres[centreIdx2];
-                    const auto &orientation2 = this->shapes[particleIdx2].getOrientation();
+                    const auto &orientation2 = this->getOrientationMatrix(particleIdx2);
                     energy += interaction.calculateEnergyBetween(pos1, orientation1, centre1, pos2, orientation2,
                                                                  centre2, cellTranslation);
                 }
@@ -855,30 +1151,42 @@ double Packing::getParticleEnergyFluctuations(const Interaction &interaction) co
     return doubleEnergy / 2;    // We divide by 2, because each interaction was counted twice
 }
 
-void Packing::rebuildNeighbourGrid() {
-    using namespace std::chrono;
-    auto start = high_resolution_clock::now();
-
-    double cellSize = this->interactionRange;
-    // linearSize/cbrt(size()) gives 1 cell per particle, factor 1/5 empirically gives best times
-    double minCellSize = std::cbrt(this->getVolume() / this->size()) / 5;
-    if (this->interactionRange < minCellSize)
+std::optional<double> Packing::calculateNeighbourGridCellSize() const {
+    // Verlet lists are built using the neighbour grid, so the cells have to cover the skin as well
+    double cellSize = this->interactionRange + this->verletSkin;
+    // linearSize/cbrt(size()) gives 1 cell per particle, the factor is empirical (see NeighbourGridCellSizeTuner)
+    double minCellSize = this->neighbourGridCellSizeFactor * std::cbrt(this->getVolume() / this->size());
+    if (cellSize < minCellSize)
         cellSize = minCellSize;
 
     // Less than 4 cells in line is redundant, because everything always would be neighbour
     auto boxHeights = this->box.getHeights();
-    if (cellSize * 4 > *std::max_element(boxHeights.begin(), boxHeights.end())) {
-        this->neighbourGrid = std::nullopt;
-        return;
-    }
+    if (cellSize * 4 > *std::max_element(boxHeights.begin(), boxHeights.end()))
+        return std::nullopt;
 
     // If minCellSize makes the cell larger than the box (for example for very few particles in a box very elongated in
     // 2 directions and very narrow in the 3rd one), abort creating NG
     static constexpr double CELL_SIZE_EPSILON = 1 + 1e-12;
-    if (cellSize * CELL_SIZE_EPSILON > *std::min_element(boxHeights.begin(), boxHeights.end())) {
+    if (cellSize * CELL_SIZE_EPSILON > *std::min_element(boxHeights.begin(), boxHeights.end()))
+        return std::nullopt;
+
+    return cellSize;
+}
+
+void Packing::rebuildNeighbourGrid() {
+    using namespace std::chrono;
+    auto start = high_resolution_clock::now();
+
+    // Indices or positions of centres could have changed
+    this->verletListsValid = false;
+
+    auto cellSizeOptional = this->calculateNeighbourGridCellSize();
+    if (!cellSizeOptional.has_value()) {
         this->neighbourGrid = std::nullopt;
+        this->neighbourGridLevels.clear();
         return;
     }
+    double cellSize = *cellSizeOptional;
 
     std::size_t totalInteractionCentres{};
     if (this->numInteractionCentres == 0)
@@ -887,60 +1195,249 @@ void Packing::rebuildNeighbourGrid() {
         totalInteractionCentres = this->numInteractionCentres*this->size();
 
     if (!this->neighbourGrid.has_value())
-        this->neighbourGrid = NeighbourGrid(this->box, cellSize, totalInteractionCentres);
+        this->neighbourGrid = NeighbourGrid(this->box, cellSize, totalInteractionCentres,
+                                            this->neighbourGridCellSubdivisions, this->neighbourGridCellSubdivisions);
     else
         this->neighbourGridResizes += this->neighbourGrid->resize(this->box, cellSize);
 
     this->addInteractionCentresToNeighbourGrid();
+    this->rebuildNeighbourGridLevels(cellSize);
 
     this->neighbourGridRebuilds++;
     auto end = high_resolution_clock::now();
     this->neighbourGridRebuildMicroseconds += duration<double, std::micro>(end - start).count();
 }
 
-void Packing::addInteractionCentresToNeighbourGrid() {
-    if (numInteractionCentres == 0) {
-        std::vector<std::size_t> cellNos(size());
+void Packing::rebuildNeighbourGridLevels(double cellSize) {
+    if (this->interactionCentreRanges.empty()) {
+        this->neighbourGridLevels.clear();
+        return;
+    }
 
-        #pragma omp parallel for default(none) shared(cellNos) num_threads(this->scalingThreads)
-        for (std::size_t particleIdx = 0; particleIdx < size(); particleIdx++)
-            cellNos[particleIdx] = neighbourGrid->positionToCellNo(shapes[particleIdx].getPosition());
+    // Cells are halved as long as they are larger than the diameter of a centre, but not below the minimal cell size
+    // used for the main grid (see Packing::calculateNeighbourGridCellSize)
+    constexpr std::size_t MAX_CELL_SUBDIVISIONS = 4;
+    double minCellSize = this->neighbourGridCellSizeFactor * std::cbrt(this->getVolume() / this->size());
+    std::vector<std::size_t> centreSubdivisions(this->numInteractionCentres);
+    for (std::size_t centre{}; centre < this->numInteractionCentres; centre++) {
+        std::size_t subdivisions = 1;
+        double subdividedCellSize = cellSize / 2;
+        while (subdivisions < MAX_CELL_SUBDIVISIONS && subdividedCellSize >= minCellSize
+               && subdividedCellSize >= 2 * this->interactionCentreRanges[centre])
+        {
+            subdivisions *= 2;
+            subdividedCellSize /= 2;
+        }
+        centreSubdivisions[centre] = subdivisions;
+    }
 
-        for (std::size_t particleIdx{}; particleIdx < size(); particleIdx++)
-            neighbourGrid->add(particleIdx, cellNos[particleIdx]);
-    } else {
-        std::vector<std::size_t> cellNos(size() * numInteractionCentres);
+    std::vector<std::size_t> levelSubdivisions = centreSubdivisions;
+    std::sort(levelSubdivisions.begin(), levelSubdivisions.end());
+    levelSubdivisions.erase(std::unique(levelSubdivisions.begin(), levelSubdivisions.end()), levelSubdivisions.end());
+    // A single level without subdivisions would be just a copy of the main neighbour grid
+    if (levelSubdivisions.size() == 1 && levelSubdivisions.front() == 1) {
+        this->neighbourGridLevels.clear();
+        return;
+    }
 
-        #pragma omp parallel for default(none) shared(cellNos) num_threads(this->scalingThreads)
-        for (std::size_t particleIdx = 0; particleIdx < size(); particleIdx++) {
-            for (size_t i{}; i < numInteractionCentres; i++) {
-                std::size_t centreIdx = particleIdx * numInteractionCentres + i;
-                cellNos[centreIdx] = neighbourGrid->positionToCellNo(absoluteInteractionCentres[centreIdx]);
+    this->interactionCentreLevels.resize(this->numInteractionCentres);
+    std::vector<std::vector<std::size_t>> levelCentres(levelSubdivisions.size());
+    for (std::size_t centre{}; centre < this->numInteractionCentres; centre++) {
+        auto levelIt = std::lower_bound(levelSubdivisions.begin(), levelSubdivisions.end(), centreSubdivisions[centre]);
+        std::size_t levelIdx = levelIt - levelSubdivisions.begin();
+        this->interactionCentreLevels[centre] = levelIdx;
+        levelCentres[levelIdx].push_back(centre);
+    }
+
+    auto subdivisionsMatch = [&levelSubdivisions](const std::vector<NeighbourGridLevel> &levels) {
+        if (levels.size() != levelSubdivisions.size())
+            return false;
+        for (std::size_t levelIdx{}; levelIdx < levels.size(); levelIdx++)
+            if (levels[levelIdx].cellSubdivisions != levelSubdivisions[levelIdx])
+                return false;
+        return true;
+    };
+    if (!subdivisionsMatch(this->neighbourGridLevels))
+        this->neighbourGridLevels.clear();
+
+    std::size_t totalInteractionCentres = this->numInteractionCentres*this->size();
+    for (std::size_t levelIdx{}; levelIdx < levelSubdivisions.size(); levelIdx++) {
+        const auto &centres = levelCentres[levelIdx];
+        std::size_t subdivisions = levelSubdivisions[levelIdx];
+
+        if (levelIdx < this->neighbourGridLevels.size()) {
+            auto &levelNeighbourGrid = this->neighbourGridLevels[levelIdx].neighbourGrid;
+            this->neighbourGridResizes += levelNeighbourGrid.resize(this->box, cellSize);
+        } else {
+            double maxLevelRange{};
+            for (std::size_t centre : centres)
+                maxLevelRange = std::max(maxLevelRange, this->interactionCentreRanges[centre]);
+
+            // Cells are never smaller than interactionRange / subdivisions, so the layers are sufficient for any box.
+            // They also never exceed subdivisions, thus queries do not reach beyond the neighbouring cells of the main
+            // neighbour grid, which keeps domain decomposition valid. Since the number of layers is rounded up, the
+            // distance pruning of stencils removes the redundant cells
+            std::vector<std::size_t> queryLayers(this->numInteractionCentres);
+            for (std::size_t centre{}; centre < this->numInteractionCentres; centre++) {
+                double range = this->interactionCentreRanges[centre] + maxLevelRange;
+                auto layers = static_cast<std::size_t>(std::ceil(range * subdivisions / this->interactionRange));
+                queryLayers[centre] = std::clamp<std::size_t>(layers, 1, subdivisions);
             }
+            NeighbourGrid levelNeighbourGrid(this->box, cellSize, totalInteractionCentres, subdivisions, subdivisions);
+            this->neighbourGridLevels.push_back({std::move(levelNeighbourGrid), subdivisions, std::move(queryLayers)});
         }
 
-        for (std::size_t particleIdx{}; particleIdx < size(); particleIdx++) {
-            for (size_t i{}; i < numInteractionCentres; i++) {
-                std::size_t centreIdx = particleIdx * numInteractionCentres + i;
-                neighbourGrid->add(centreIdx, cellNos[centreIdx]);
-            }
+        auto &levelNeighbourGrid = this->neighbourGridLevels[levelIdx].neighbourGrid;
+        std::size_t centresPerParticle = centres.size();
+        std::size_t numLevelCentres = centresPerParticle * this->size();
+        std::vector<std::pair<std::size_t, std::size_t>> centreCells(numLevelCentres);
+        #pragma omp parallel for default(none) shared(centreCells, centres, levelNeighbourGrid) \
+                firstprivate(numLevelCentres, centresPerParticle) num_threads(this->scalingThreads)
+        for (std::size_t i = 0; i < numLevelCentres; i++) {
+            std::size_t particleIdx = i / centresPerParticle;
+            std::size_t centreIdx = particleIdx * this->numInteractionCentres + centres[i % centresPerParticle];
+            auto pos = this->getAbsoluteInteractionCentre(centreIdx);
+            centreCells[i] = {centreIdx, levelNeighbourGrid.positionToCellNo(pos)};
         }
+        levelNeighbourGrid.build(centreCells, this->scalingThreads);
+    }
+}
+
+void Packing::reorderParticles() {
+    std::size_t numParticles = this->size();
+    std::vector<std::uint32_t> mortonCodes(numParticles);
+    #pragma omp parallel for default(none) shared(mortonCodes) firstprivate(numParticles) \
+            num_threads(this->scalingThreads)
+    for (std::size_t i = 0; i < numParticles; i++)
+        mortonCodes[i] = morton_code(this->box.absoluteToRelative(this->getAbsolutePosition(i)));
+
+    // order[newIdx] = oldIdx
+    std::vector<std::size_t> order(numParticles);
+    std::iota(order.begin(), order.end(), 0);
+    std::stable_sort(order.begin(), order.end(), [&mortonCodes](std::size_t i, std::size_t j) {
+        return mortonCodes[i] < mortonCodes[j];
+    });
+
+    permute_blocks(this->positions, order, 1);
+    permute_blocks(this->orientations, order, 1);
+    if (this->numInteractionCentres != 0) {
+        permute_blocks(this->interactionCentres, order, this->numInteractionCentres);
+        permute_blocks(this->absoluteInteractionCentres, order, this->numInteractionCentres);
     }
+
+    if (this->externalIndices.empty()) {
+        this->externalIndices.resize(numParticles);
+        std::iota(this->externalIndices.begin(), this->externalIndices.end(), 0);
+    }
+    permute_blocks(this->externalIndices, order, 1);
+    this->internalIndices.resize(numParticles);
+    for (std::size_t i{}; i < numParticles; i++)
+        this->internalIndices[this->externalIndices[i]] = i;
+
+    if (this->neighbourGrid.has_value())
+        this->rebuildNeighbourGrid();
+}
+
+bool Packing::rescaleNeighbourGrid() {
+    if (!this->neighbourGrid.has_value())
+        return false;
+
+    auto cellSize = this->calculateNeighbourGridCellSize();
+    if (!cellSize.has_value())
+        return false;
+
+    if (!this->neighbourGrid->rescale(this->box, *cellSize))
+        return false;
+
+    // Levels subdivide the cells of the main neighbour grid, so they can be rescaled whenever it can be
+    for (auto &level : this->neighbourGridLevels) {
+        [[maybe_unused]] bool levelRescaled = level.neighbourGrid.rescale(this->box, *cellSize);
+        Assert(levelRescaled);
+    }
+
+    this->relocateInteractionCentresInNeighbourGrid();
+    return true;
+}
+
+void Packing::relocateInteractionCentresInNeighbourGrid() {
+    // Particle centres keep relative positions when the box is rescaled, so only a few of them (mostly interaction
+    // centres displaced from the mass centre or ones lying on cell boundaries due to numerical inaccuracies) change
+    // the cell
+    std::size_t numCentres = (this->numInteractionCentres == 0 ? 1 : this->numInteractionCentres) * this->size();
+    std::vector<std::size_t> cellNos(numCentres);
+
+    #pragma omp parallel for default(none) shared(cellNos) firstprivate(numCentres) num_threads(this->scalingThreads)
+    for (std::size_t centreIdx = 0; centreIdx < numCentres; centreIdx++) {
+        if (this->numInteractionCentres == 0)
+            cellNos[centreIdx] = this->neighbourGrid->positionToCellNo(this->getAbsolutePosition(centreIdx));
+        else
+            cellNos[centreIdx] = this->neighbourGrid->positionToCellNo(this->getAbsoluteInteractionCentre(centreIdx));
+    }
+
+    for (std::size_t centreIdx{}; centreIdx < numCentres; centreIdx++)
+        this->neighbourGrid->move(centreIdx, cellNos[centreIdx]);
+
+    if (this->neighbourGridLevels.empty())
+        return;
+
+    #pragma omp parallel for default(none) shared(cellNos) firstprivate(numCentres) num_threads(this->scalingThreads)
+    for (std::size_t centreIdx = 0; centreIdx < numCentres; centreIdx++) {
+        std::size_t levelIdx = this->interactionCentreLevels[centreIdx % this->numInteractionCentres];
+        const auto &levelNeighbourGrid = this->neighbourGridLevels[levelIdx].neighbourGrid;
+        cellNos[centreIdx] = levelNeighbourGrid.positionToCellNo(this->getAbsoluteInteractionCentre(centreIdx));
+    }
+
+    for (std::size_t centreIdx{}; centreIdx < numCentres; centreIdx++) {
+        std::size_t levelIdx = this->interactionCentreLevels[centreIdx % this->numInteractionCentres];
+        this->neighbourGridLevels[levelIdx].neighbourGrid.move(centreIdx, cellNos[centreIdx]);
+    }
+}
+
+void Packing::addInteractionCentresToNeighbourGrid() {
+    std::size_t numCentres = (this->numInteractionCentres == 0 ? 1 : this->numInteractionCentres) * this->size();
+    std::vector<std::pair<std::size_t, std::size_t>> centreCells(numCentres);
+
+    #pragma omp parallel for default(none) shared(centreCells) firstprivate(numCentres) \
+            num_threads(this->scalingThreads)
+    for (std::size_t centreIdx = 0; centreIdx < numCentres; centreIdx++) {
+        if (this->numInteractionCentres == 0) {
+            centreCells[centreIdx] = {centreIdx,
+                                      this->neighbourGrid->positionToCellNo(this->getAbsolutePosition(centreIdx))};
+        } else {
+            auto pos = this->getAbsoluteInteractionCentre(centreIdx);
+            centreCells[centreIdx] = {centreIdx, this->neighbourGrid->positionToCellNo(pos)};
+        }
+    }
+
+    this->neighbourGrid->build(centreCells, this->scalingThreads);
 }
 
 void Packing::setupForInteraction(const Interaction &interaction) {
+    this->setUpInteractionTypeInfo = &typeid(interaction);
+    this->setUpInteractionType = get_devirtualised_interaction(interaction);
     this->interactionRange = interaction.getRangeRadius();
     this->numInteractionCentres = interaction.getInteractionCentres().size();
+    this->interactionCentreRanges.clear();
+    if (this->numInteractionCentres > 0) {
+        this->interactionCentreRanges = interaction.getInteractionCentreRanges();
+        Expects(this->interactionCentreRanges.empty()
+                || this->interactionCentreRanges.size() == this->numInteractionCentres);
+    }
+    // Query layers of the levels depend on the ranges, so the levels cannot be reused
+    this->neighbourGridLevels.clear();
+    this->tempNeighbourGridLevels.clear();
     this->interactionCentres.clear();
     this->absoluteInteractionCentres.clear();
+    this->bodyFrameInteractionCentres = interaction.getInteractionCentres();
     if (this->numInteractionCentres > 0) {
         // Takes into account temp shapes at the back
-        this->interactionCentres.reserve(this->shapes.size() * this->numInteractionCentres);
-        this->absoluteInteractionCentres.resize(this->shapes.size() * this->numInteractionCentres);
-        auto centres = interaction.getInteractionCentres();
-        for (const auto &shape : this->shapes)
-            for (const auto &centre : centres)
-                this->interactionCentres.emplace_back(shape.getOrientation() * centre);
+        this->interactionCentres.reserve(this->orientations.size() * this->numInteractionCentres);
+        this->absoluteInteractionCentres.resize(this->orientations.size() * this->numInteractionCentres);
+        for (std::size_t i{}; i < this->orientations.size(); i++) {
+            const auto &orientation = this->getOrientationMatrix(i);
+            for (const auto &centre : this->bodyFrameInteractionCentres)
+                this->interactionCentres.emplace_back(orientation * centre);
+        }
         this->recalculateAbsoluteInteractionCentres();
     }
     this->rebuildNeighbourGrid();
@@ -967,6 +1464,7 @@ void Packing::resetCounters() {
     this->neighbourGridRebuilds = 0;
     this->neighbourGridResizes = 0;
     this->neighbourGridRebuildMicroseconds = 0;
+    this->verletListRebuilds = 0;
 }
 
 std::ostream &operator<<(std::ostream &out, const Packing &packing) {
@@ -982,9 +1480,14 @@ std::ostream &operator<<(std::ostream &out, const Packing &packing) {
 
 std::size_t Packing::getShapesMemoryUsage() const {
     std::size_t bytes{};
-    bytes += get_vector_memory_usage(this->shapes);
+    bytes += get_vector_memory_usage(this->positions);
+    bytes += get_vector_memory_usage(this->orientations);
     bytes += get_vector_memory_usage(this->interactionCentres);
     bytes += get_vector_memory_usage(this->absoluteInteractionCentres);
+    bytes += get_vector_memory_usage(this->lastPositions);
+    bytes += get_vector_memory_usage(this->lastAbsoluteInteractionCentres);
+    bytes += get_vector_memory_usage(this->internalIndices);
+    bytes += get_vector_memory_usage(this->externalIndices);
     return bytes;
 }
 
@@ -994,6 +1497,14 @@ std::size_t Packing::getNeighbourGridMemoryUsage() const {
         bytes += this->neighbourGrid->getMemoryUsage();
     if (this->tempNeighbourGrid.has_value())
         bytes += this->tempNeighbourGrid->getMemoryUsage();
+    for (const auto &level : this->neighbourGridLevels)
+        bytes += level.neighbourGrid.getMemoryUsage();
+    for (const auto &level : this->tempNeighbourGridLevels)
+        bytes += level.neighbourGrid.getMemoryUsage();
+    bytes += get_vector_memory_usage(this->verletListOffsets);
+    bytes += get_vector_memory_usage(this->verletListEntries);
+    bytes += get_vector_memory_usage(this->verletListReferenceCentres);
+    bytes += get_vector_memory_usage(this->verletListSeparatingDirections);
     return bytes;
 }
 
@@ -1008,7 +1519,7 @@ double Packing::getAverageNumberOfNeighbours() const {
     if (this->numInteractionCentres == 0) {
         std::size_t numNeighbours{};
         for (std::size_t i{}; i < this->size(); i++) {
-            const auto &pos = this->shapes[i].getPosition();
+            const auto &pos = this->getAbsolutePosition(i);
             for (const auto &cell : this->neighbourGrid->getNeighbouringCells(pos))
                 for (auto j : cell.getNeighbours())
                     if (i != j)
@@ -1019,7 +1530,7 @@ double Packing::getAverageNumberOfNeighbours() const {
         std::size_t numNeighbours{};
         for (std::size_t centreIdx1{}; centreIdx1 < this->size()*this->numInteractionCentres; centreIdx1++) {
             std::size_t particle1 = centreIdx1 / this->numInteractionCentres;
-            auto pos1 = this->absoluteInteractionCentres[centreIdx1];
+            auto pos1 = this->getAbsoluteInteractionCentre(centreIdx1);
             for (const auto &cell : this->neighbourGrid->getNeighbouringCells(pos1)) {
                 for (auto centreIdx2 : cell.getNeighbours()) { // NOLINT(readability-use-anyofallof)
                     std::size_t particle2 = centreIdx2 / this->numInteractionCentres;
@@ -1041,8 +1552,8 @@ void Packing::recalculateAbsoluteInteractionCentres() {
 void Packing::recalculateAbsoluteInteractionCentres(std::size_t particleIdx) {
     for (std::size_t centre{}; centre < this->numInteractionCentres; centre++) {
         std::size_t centreIdx = particleIdx * this->numInteractionCentres + centre;
-        auto pos = this->shapes[particleIdx].getPosition() + this->interactionCentres[centreIdx];
-        this->absoluteInteractionCentres[centreIdx] = pos + this->bc->getCorrection(pos);
+        auto pos = this->getAbsolutePosition(particleIdx) + this->interactionCentres[centreIdx];
+        this->absoluteInteractionCentres[centreIdx] = this->toStoredPosition(pos + this->bc->getCorrection(pos));
     }
 }
 
@@ -1059,9 +1570,198 @@ std::size_t Packing::getCachedNumberOfOverlaps() const {
     throw std::runtime_error("Packing: overlap counting is toggled false; number of overlaps is not cached");
 }
 
+void Packing::compactNeighbourGrid() {
+    if (this->neighbourGrid.has_value())
+        this->neighbourGrid->compactIfNeeded(this->scalingThreads);
+    for (auto &level : this->neighbourGridLevels)
+        level.neighbourGrid.compactIfNeeded(this->scalingThreads);
+}
+
+void Packing::setVerletListSkin(double skin) {
+    Expects(skin >= 0);
+    this->verletSkin = skin;
+    this->verletListsValid = false;
+    if (skin == 0) {
+        this->verletListOffsets.clear();
+        this->verletListEntries.clear();
+        this->verletListReferenceCentres.clear();
+        this->verletListSeparatingDirections.clear();
+    }
+
+    // Cell size depends on the skin
+    if (this->size() > 0)
+        this->rebuildNeighbourGrid();
+}
+
+double Packing::getNeighbourGridCellSize() const {
+    if (!this->neighbourGrid.has_value())
+        return 0;
+    return this->calculateNeighbourGridCellSize().value_or(0);
+}
+
+void Packing::setNeighbourGridCellSizeFactor(double factor) {
+    Expects(factor > 0);
+    this->neighbourGridCellSizeFactor = factor;
+    if (this->size() > 0)
+        this->rebuildNeighbourGrid();
+}
+
+void Packing::setNeighbourGridCellSubdivisions(std::size_t subdivisions) {
+    Expects(subdivisions >= 1);
+    if (subdivisions == this->neighbourGridCellSubdivisions)
+        return;
+
+    // Subdivisions are fixed for a given neighbour grid, so it has to be created from scratch
+    this->neighbourGridCellSubdivisions = subdivisions;
+    this->neighbourGrid = std::nullopt;
+    this->tempNeighbourGrid = std::nullopt;
+    if (this->size() > 0)
+        this->rebuildNeighbourGrid();
+}
+
+void Packing::toggleLeanNeighbourGrid(bool lean) {
+    this->leanNeighbourGrid = lean;
+    if (this->leanNeighbourGrid) {
+        this->tempNeighbourGrid = std::nullopt;
+        this->tempNeighbourGridLevels.clear();
+        this->tempNeighbourGridLevels.shrink_to_fit();
+    }
+}
+
+void Packing::toggleSeparatingDirectionCache(bool cache) {
+    this->separatingDirectionCache = cache;
+    // Zero vectors are unknown directions
+    if (this->separatingDirectionCache)
+        this->verletListSeparatingDirections.assign(this->verletListEntries.size(), Vector<3>{});
+    else
+        this->verletListSeparatingDirections.clear();
+}
+
+bool Packing::updateVerletLists() {
+    if (this->verletSkin == 0 || this->verletListsValid || !this->neighbourGrid.has_value())
+        return false;
+
+    this->rebuildVerletLists();
+    this->verletListsValid = true;
+    this->verletListRebuilds++;
+    return true;
+}
+
+void Packing::rebuildVerletLists() {
+    for (std::size_t i{}; i < 3; i++) {
+        for (std::size_t j{}; j < 3; j++) {
+            for (std::size_t k{}; k < 3; k++) {
+                // indices 0, 1, 2 correspond to -1, 0, 1 (relative) translation respectively
+                Vector<3> relativeTranslation{static_cast<double>(i) - 1,
+                                              static_cast<double>(j) - 1,
+                                              static_cast<double>(k) - 1};
+                this->verletListTranslations[9*i + 3*j + k] = this->box.relativeToAbsolute(relativeTranslation);
+            }
+        }
+    }
+
+    std::size_t centresPerParticle = std::max<std::size_t>(this->numInteractionCentres, 1);
+    std::size_t numCentres = centresPerParticle * this->size();
+    double maxDistance = this->interactionRange + this->verletSkin;
+    double maxDistance2 = maxDistance * maxDistance;
+
+    // Lists are gathered in two passes (counting and filling), so that they can be stored contiguously. Writes to
+    // out are skipped in the counting pass (when it is nullptr)
+    auto collectNeighbours = [this, centresPerParticle, maxDistance2](std::size_t centreIdx, VerletListEntry *out) {
+        std::size_t particleIdx = centreIdx / centresPerParticle;
+        Vector<3> pos1 = this->getNeighbourGridObjectPosition(centreIdx);
+        std::size_t numNeighbours{};
+        for (const auto &cell : this->neighbourGrid->getNeighbouringCells(pos1)) {
+            const auto &translation = cell.getTranslation();
+            std::uint32_t translationIdx{};
+            if (out != nullptr) {
+                Vector<3> relativeTranslation = this->box.absoluteToRelative(translation);
+                for (std::size_t i{}; i < 3; i++) {
+                    auto relativeCoord = static_cast<std::uint32_t>(std::lround(relativeTranslation[i]) + 1);
+                    translationIdx = 3*translationIdx + relativeCoord;
+                }
+            }
+
+            for (auto centreIdx2 : cell.getNeighbours()) {
+                if (centreIdx2 / centresPerParticle == particleIdx)
+                    continue;
+                Vector<3> pos2 = this->getNeighbourGridObjectPosition(centreIdx2);
+                if ((pos2 + translation - pos1).norm2() > maxDistance2)
+                    continue;
+
+                if (out != nullptr)
+                    out[numNeighbours] = {static_cast<std::uint32_t>(centreIdx2), translationIdx};
+                numNeighbours++;
+            }
+        }
+        return numNeighbours;
+    };
+
+    this->verletListOffsets.assign(numCentres + 1, 0);
+    this->verletListReferenceCentres.resize(numCentres);
+    #pragma omp parallel for default(none) shared(collectNeighbours) firstprivate(numCentres) \
+            num_threads(this->scalingThreads)
+    for (std::size_t centreIdx = 0; centreIdx < numCentres; centreIdx++) {
+        this->verletListOffsets[centreIdx + 1] = collectNeighbours(centreIdx, nullptr);
+        this->verletListReferenceCentres[centreIdx] = this->getNeighbourGridObjectPosition(centreIdx);
+    }
+
+    std::partial_sum(this->verletListOffsets.begin(), this->verletListOffsets.end(), this->verletListOffsets.begin());
+    this->verletListEntries.resize(this->verletListOffsets.back());
+
+    #pragma omp parallel for default(none) shared(collectNeighbours) firstprivate(numCentres) \
+            num_threads(this->scalingThreads)
+    for (std::size_t centreIdx = 0; centreIdx < numCentres; centreIdx++)
+        collectNeighbours(centreIdx, this->verletListEntries.data() + this->verletListOffsets[centreIdx]);
+
+    // Slots correspond to different pairs after the rebuild
+    if (this->separatingDirectionCache)
+        this->verletListSeparatingDirections.assign(this->verletListEntries.size(), Vector<3>{});
+}
+
+bool Packing::areVerletListsValid() const {
+    bool valid{};
+    #pragma omp atomic read
+    valid = this->verletListsValid;
+    return valid;
+}
+
+void Packing::invalidateVerletLists() {
+    #pragma omp atomic write
+    this->verletListsValid = false;
+}
+
+bool Packing::isWithinVerletSkin(std::size_t originalParticleIdx, std::size_t tempParticleIdx) const {
+    double maxDisplacement = this->verletSkin / 2;
+    std::size_t centresPerParticle = std::max<std::size_t>(this->numInteractionCentres, 1);
+    for (std::size_t centre{}; centre < centresPerParticle; centre++) {
+        std::size_t originalCentreIdx = originalParticleIdx * centresPerParticle + centre;
+        std::size_t tempCentreIdx = tempParticleIdx * centresPerParticle + centre;
+        const auto &referenceCentre = this->verletListReferenceCentres[originalCentreIdx];
+        Vector<3> currentCentre = this->getNeighbourGridObjectPosition(tempCentreIdx);
+        if ((currentCentre - referenceCentre).norm2() > maxDisplacement * maxDisplacement)
+            return false;
+    }
+    return true;
+}
+
+bool Packing::canUseVerletLists(std::size_t originalParticleIdx, std::size_t tempParticleIdx) const {
+    // Other particles are displaced by at most half of the skin if the lists are valid. If the checked one is
+    // displaced further, some pairs within the interaction range may be missing
+    return this->verletSkin > 0 && this->areVerletListsValid()
+           && this->isWithinVerletSkin(originalParticleIdx, tempParticleIdx);
+}
+
+void Packing::checkVerletListDisplacement(std::size_t particleIdx) {
+    if (this->verletSkin > 0 && this->areVerletListsValid() && !this->isWithinVerletSkin(particleIdx, particleIdx))
+        this->invalidateVerletLists();
+}
+
 void Packing::resetNGRaceConditionSanitizer() {
     if (this->neighbourGrid.has_value())
         this->neighbourGrid->resetRaceConditionSanitizer();
+    for (auto &level : this->neighbourGridLevels)
+        level.neighbourGrid.resetRaceConditionSanitizer();
 }
 
 bool Packing::areShapesWithinBox(const std::vector<Shape> &shapes, const TriclinicBox &box) {
@@ -1099,8 +1799,8 @@ std::size_t Packing::countParticleWallOverlaps(std::size_t particleIdx, const In
         std::size_t nextCoord = (i + 1) % 3;
         std::size_t nextNextCoord = (i + 2) % 3;
         Vector<3> wallVector = (boxSides[nextCoord] ^ boxSides[nextNextCoord]).normalized();
-        const auto &shapePos = this->shapes[particleIdx].getPosition();
-        const auto &shapeRot = this->shapes[particleIdx].getOrientation();
+        const auto &shapePos = this->getAbsolutePosition(particleIdx);
+        const auto &shapeRot = this->getOrientationMatrix(particleIdx);
         if (shapePos * wallVector < halfTotalRangeRadius) {
             // Nearer wall
             if (this->numInteractionCentres == 0) {
@@ -1176,16 +1876,14 @@ bool Packing::isBoxUpscaled(const TriclinicBox &oldBox, const TriclinicBox &newB
 }
 
 std::size_t Packing::renormalizeOrientations(const Interaction &interaction, bool allowOverlaps) {
+    if constexpr (Packing::areOrientationsDriftFree())
+        return 0;
+
     if (allowOverlaps) {
-        auto newShapes = std::vector<Shape>(this->begin(), this->end());
-        #pragma omp parallel for shared(newShapes) default(none) num_threads(this->scalingThreads)
-        for (std::size_t i = 0; i < this->size(); i++) {
-            auto &shape = this->shapes[i];
-            auto rot = shape.getOrientation();
-            Packing::fixRotationMatrix(rot);
-            shape.setOrientation(rot);
-        }
-        this->reset(std::move(newShapes), this->box, interaction);
+        #pragma omp parallel for default(none) num_threads(this->scalingThreads)
+        for (std::size_t i = 0; i < this->size(); i++)
+            Packing::normalizeOrientation(this->orientations[i]);
+        this->setupForInteraction(interaction);
         return 0;
     }
 
@@ -1218,18 +1916,75 @@ void Packing::fixRotationMatrix(Matrix<3, 3> &rotation) {
         rotation = 1.5 * rotation - 0.5 * rotation * rotation.transpose() * rotation;
 }
 
+Packing::StoredPosition Packing::toStoredPosition(const Vector<3> &position) const {
+#ifdef RAMPACK_SINGLE_PRECISION_POSITIONS
+    Vector<3> relativePosition = this->box.absoluteToRelative(position);
+    StoredPosition storedPosition;
+    for (std::size_t i{}; i < 3; i++) {
+        // Rounding to float may push the coordinate outside [0, 1), which would break the boundary conditions
+        auto coord = static_cast<float>(relativePosition[i]);
+        if (coord < 0)
+            coord = 0;
+        else if (coord >= 1)
+            coord = std::nextafter(1.f, 0.f);
+        storedPosition[i] = coord;
+    }
+    return storedPosition;
+#else
+    return position;
+#endif
+}
+
+#ifdef RAMPACK_SINGLE_PRECISION_POSITIONS
+Vector<3> Packing::fromStoredPosition(const StoredPosition &position) const {
+    return this->box.relativeToAbsolute({position[0], position[1], position[2]});
+}
+#endif
+
+Packing::StoredOrientation Packing::toStoredOrientation(const Matrix<3, 3> &orientation) {
+#ifdef RAMPACK_QUATERNION_ORIENTATIONS
+    return Quaternion::fromMatrix(orientation);
+#else
+    return orientation;
+#endif
+}
+
+Packing::StoredOrientation Packing::rotateOrientation(const Matrix<3, 3> &rotation,
+                                                      const StoredOrientation &orientation)
+{
+#ifdef RAMPACK_QUATERNION_ORIENTATIONS
+    // Normalizing after each composition prevents the accumulation of numerical errors
+    return Quaternion::multiply(Quaternion::fromMatrix(rotation), orientation).normalized();
+#else
+    return rotation * orientation;
+#endif
+}
+
+void Packing::normalizeOrientation(StoredOrientation &orientation) {
+#ifdef RAMPACK_QUATERNION_ORIENTATIONS
+    orientation = orientation.normalized();
+#else
+    Packing::fixRotationMatrix(orientation);
+#endif
+}
+
+#ifdef RAMPACK_QUATERNION_ORIENTATIONS
+Matrix<3, 3> Packing::getOrientationMatrix(std::size_t i) const {
+    return Quaternion::toMatrix(this->orientations[i]);
+}
+#endif
+
 void Packing::tryOrientationFix(std::size_t particleIdx, const std::vector<Vector<3>> &centres) {
     // threadId should be 0 (master), but fetch explicitly if somehow this function is run from a different thread
     auto threadId = OMP_THREAD_ID;
-    auto &shape = this->shapes[particleIdx];
     std::size_t tempParticleIdx = this->size() + threadId;
     this->lastAlteredParticleIdx[threadId] = particleIdx;
 
-    auto &tempShape = this->shapes[tempParticleIdx];
-    tempShape.setPosition(shape.getPosition());
-    auto rot = shape.getOrientation();
-    Packing::fixRotationMatrix(rot);
-    tempShape.setOrientation(rot);
+    this->positions[tempParticleIdx] = this->positions[particleIdx];
+    auto &tempOrientation = this->orientations[tempParticleIdx];
+    tempOrientation = this->orientations[particleIdx];
+    Packing::normalizeOrientation(tempOrientation);
+    const auto &rot = this->getOrientationMatrix(tempParticleIdx);
 
     if (this->numInteractionCentres > 0) {
         std::size_t tempOrigin = (this->size() + threadId) * this->numInteractionCentres;
@@ -10,16 +10,23 @@
 #include <memory>
 #include <optional>
 #include <map>
+#include <iterator>
+#include <typeinfo>
 
 #include "Shape.h"
 #include "BoundaryConditions.h"
 #include "Interaction.h"
+#include "InteractionBatch.h"
 #include "ShapePrinter.h"
 #include "ShapeGeometry.h"
 #include "NeighbourGrid.h"
 #include "ActiveDomain.h"
 #include "utils/OMPMacros.h"
 #include "TriclinicBox.h"
+#include "utils/AlignedAllocator.h"
+#include "geometry/Quaternion.h"
+
+enum class DevirtualisedInteraction : std::uint8_t;
 
 /**
  * @brief A class representing the packing of molecules, eligible for Monte Carlo perturbations.
@@ -31,21 +38,50 @@
  */
 class Packing {
 private:
-    // shapes, interactionCentres and absoluteInteractionCentres contain additional slots at the end for temporary data
-    // for all threads
-
-    // Shapes in the packing - mass centers and orientations
-    std::vector<Shape> shapes;
+#ifdef RAMPACK_QUATERNION_ORIENTATIONS
+    // Orientations are stored as unit quaternions and converted to rotation matrices only when passed to Interaction
+    using StoredOrientation = Vector<4>;
+#else
+    using StoredOrientation = Matrix<3, 3>;
+#endif
+
+#ifdef RAMPACK_SINGLE_PRECISION_POSITIONS
+    // Positions are stored in single precision as box-relative coordinates - the precision is then uniform within the
+    // box and volume moves do not alter them. They are converted to absolute double precision vectors when read
+    using StoredPosition = Vector<3, float>;
+#else
+    using StoredPosition = Vector<3>;
+#endif
+
+    // positions, orientations, interactionCentres and absoluteInteractionCentres contain additional slots at the end
+    // for temporary data for all threads
+
+    // Shapes in the packing - mass centers and orientations. They are stored as separate arrays (structure of arrays),
+    // so that loops using only positions do not pull orientations into the cache
+    AlignedVector<StoredPosition> positions;
+    AlignedVector<StoredOrientation> orientations;
     // Positions of interaction centers with respect to mass centers (coherent with particle orientations)
-    std::vector<Vector<3>> interactionCentres;
-    // Absolute positions of interaction centers (shapes[i].getPosition() + interactionCentres[i] + bc correction)
-    std::vector<Vector<3>> absoluteInteractionCentres;
+    AlignedVector<Vector<3>> interactionCentres;
+    // Interaction centres in the body frame - in quaternion builds rotated centres are recalculated from them
+    std::vector<Vector<3>> bodyFrameInteractionCentres;
+    // Absolute positions of interaction centers (positions[i] + interactionCentres[i] + bc correction)
+    AlignedVector<StoredPosition> absoluteInteractionCentres;
+
+    // Permutation introduced by Packing::reorderParticles(). Particle with index i seen from the outside is stored
+    // under internalIndices[i] and externalIndices is the inverse map. Both are empty if particles were never reordered
+    std::vector<std::size_t> internalIndices;
+    std::vector<std::size_t> externalIndices;
 
     TriclinicBox box;
     std::unique_ptr<BoundaryConditions> bc;
     std::optional<NeighbourGrid> neighbourGrid;
     double interactionRange{};
     std::size_t numInteractionCentres{};
+    // Concrete type of the interaction from the last Packing::setupForInteraction (see DevirtualisedInteractions.h)
+    // is determined once and reused for interactions of the same dynamic type, instead of a series of dynamic_casts
+    // for each move
+    const std::type_info *setUpInteractionTypeInfo{};
+    DevirtualisedInteraction setUpInteractionType{};
 
     std::size_t moveThreads{};
     std::size_t scalingThreads{};
@@ -58,31 +94,161 @@ private:
 
     std::vector<std::size_t> lastAlteredParticleIdx{};
     std::vector<int> lastMoveOverlapDeltas{};
+    // Per-thread buffers of neighbours gathered for Interaction::countOverlapsInBatch. They are only scratch space,
+    // so they can be filled in const methods
+    mutable std::vector<InteractionBatch> overlapBatches{};
     std::size_t lastScalingNumOverlaps{};
     TriclinicBox lastBox;
-    std::vector<Shape> lastShapes;
+    // Second buffers swapped with positions and absoluteInteractionCentres by scaling (see Packing::tryScaling).
+    // Scaling does not alter orientations, so they are not stored
+    AlignedVector<StoredPosition> lastPositions;
+    AlignedVector<StoredPosition> lastAbsoluteInteractionCentres;
     std::optional<NeighbourGrid> tempNeighbourGrid;     // temp ng is used for swapping in volume moves
-
+    bool lastScalingRescaledNeighbourGrid{};   // if true, NG was updated in place instead of being swapped and rebuilt
+
+    // Levels of a hierarchical neighbour grid for interaction centres of different ranges (see
+    // Interaction::getInteractionCentreRanges). Each level stores only centres of similar ranges in cells of the main
+    // neighbour grid divided into cellSubdivisions parts in each direction, so small centres are not binned together
+    // with the large ones. They are used only in molecule moves - the main neighbour grid is still kept for the rest
+    struct NeighbourGridLevel {
+        NeighbourGrid neighbourGrid;
+        std::size_t cellSubdivisions{};
+        // Number of cell layers which have to be queried for each interaction centre of a molecule
+        std::vector<std::size_t> queryLayers;
+    };
+
+    std::vector<double> interactionCentreRanges;    // empty if ranges of all centres are the same
+    std::vector<std::size_t> interactionCentreLevels;   // index of NeighbourGridLevel for each centre of a molecule
+    std::vector<NeighbourGridLevel> neighbourGridLevels;    // empty if the levels are not used
+    std::vector<NeighbourGridLevel> tempNeighbourGridLevels;
+
+    // Minimal neighbour grid cell size in the units of the mean distance between particles cbrt(V/N)
+    double neighbourGridCellSizeFactor = DEFAULT_NEIGHBOUR_GRID_CELL_SIZE_FACTOR;
+    std::size_t neighbourGridCellSubdivisions = 1;
+    bool leanNeighbourGrid{};   // if true, tempNeighbourGrid and tempNeighbourGridLevels are not used
     std::size_t neighbourGridRebuilds{};
     std::size_t neighbourGridResizes{};
     double neighbourGridRebuildMicroseconds{};
 
+    // Verlet lists (see Packing::setVerletListSkin). Neighbours of interaction centre (or particle if there are no
+    // interaction centres) i are stored in verletListEntries under indices [verletListOffsets[i],
+    // verletListOffsets[i + 1]) together with the index of periodic translation in verletListTranslations
+    struct VerletListEntry {
+        std::uint32_t centreIdx{};
+        std::uint32_t translationIdx{};
+    };
+
+    double verletSkin{};
+    bool verletListsValid{};    // accessed atomically, since it may be invalidated by concurrent moves
+    bool lastScalingVerletListsValid{};
+    std::vector<std::size_t> verletListOffsets;
+    std::vector<VerletListEntry> verletListEntries;
+    std::array<Vector<3>, 27> verletListTranslations;
+    std::vector<Vector<3>> verletListReferenceCentres;     // centre positions for which the lists were built
+    std::size_t verletListRebuilds{};
+    // Separating directions of pairs from verletListEntries (see Packing::toggleSeparatingDirectionCache). Each list
+    // is accessed only by a thread moving its particle, so it can be updated in const methods without locks
+    bool separatingDirectionCache{};
+    mutable std::vector<Vector<3>> verletListSeparatingDirections;
+
 
     static bool areShapesWithinBox(const std::vector<Shape> &shapes, const TriclinicBox &box);
     static bool isBoxUpscaled(const TriclinicBox &oldBox, const TriclinicBox &newBox);
     static void fixRotationMatrix(Matrix<3, 3> &rotation);
 
+    static StoredOrientation toStoredOrientation(const Matrix<3, 3> &orientation);
+    static StoredOrientation rotateOrientation(const Matrix<3, 3> &rotation, const StoredOrientation &orientation);
+    static void normalizeOrientation(StoredOrientation &orientation);
+
+    [[nodiscard]] StoredPosition toStoredPosition(const Vector<3> &position) const;
+
+#ifdef RAMPACK_SINGLE_PRECISION_POSITIONS
+    [[nodiscard]] Vector<3> fromStoredPosition(const StoredPosition &position) const;
+#else
+    [[nodiscard]] const Vector<3> &fromStoredPosition(const StoredPosition &position) const { return position; }
+#endif
+
+    [[nodiscard]] std::size_t toInternalIndex(std::size_t particleIdx) const {
+        return this->internalIndices.empty() ? particleIdx : this->internalIndices[particleIdx];
+    }
+
+    [[nodiscard]] decltype(auto) getAbsolutePosition(std::size_t i) const {
+        return this->fromStoredPosition(this->positions[i]);
+    }
+
+    [[nodiscard]] decltype(auto) getAbsoluteInteractionCentre(std::size_t centreIdx) const {
+        return this->fromStoredPosition(this->absoluteInteractionCentres[centreIdx]);
+    }
+
+    // Position of an object stored in the neighbour grid - an interaction centre or a particle if there are none
+    [[nodiscard]] Vector<3> getNeighbourGridObjectPosition(std::size_t objectIdx) const {
+        if (this->numInteractionCentres == 0)
+            return this->getAbsolutePosition(objectIdx);
+        else
+            return this->getAbsoluteInteractionCentre(objectIdx);
+    }
+
+#ifdef RAMPACK_QUATERNION_ORIENTATIONS
+    [[nodiscard]] Matrix<3, 3> getOrientationMatrix(std::size_t i) const;
+#else
+    [[nodiscard]] const Matrix<3, 3> &getOrientationMatrix(std::size_t i) const { return this->orientations[i]; }
+#endif
+
+    [[nodiscard]] std::optional<double> calculateNeighbourGridCellSize() const;
     void rebuildNeighbourGrid();
+    void rebuildNeighbourGridLevels(double cellSize);
+    bool rescaleNeighbourGrid();
+    void relocateInteractionCentresInNeighbourGrid();
+
+    // Position-only prefilter - particles (interaction centres) further than interactionRange cannot interact, so
+    // orientations do not have to be fetched at all
+    [[nodiscard]] bool isWithinInteractionRange(const Vector<3> &pos1, const Vector<3> &pos2,
+                                                const Vector<3> &translation) const
+    {
+        return (pos2 + translation - pos1).norm2() <= this->interactionRange * this->interactionRange;
+    }
+
+    // The same as above, but for a specific pair of interaction centres, which may have a shorter range
+    [[nodiscard]] bool isWithinInteractionRange(std::size_t centre1, const Vector<3> &pos1, std::size_t centre2,
+                                                const Vector<3> &pos2, const Vector<3> &translation) const
+    {
+        if (this->interactionCentreRanges.empty())
+            return this->isWithinInteractionRange(pos1, pos2, translation);
+
+        double range = this->interactionCentreRanges[centre1] + this->interactionCentreRanges[centre2];
+        return (pos2 + translation - pos1).norm2() <= range * range;
+    }
+
+    // Adds an interaction centre (or a whole particle) to the batch of neighbours, fetching the orientation only if the
+    // batch stores them
+    void addToOverlapBatch(InteractionBatch &batch, std::size_t particleIdx, std::size_t centre,
+                           const Vector<3> &position) const
+    {
+        if (batch.hasOrientations())
+            batch.add(position, centre, this->getOrientationMatrix(particleIdx));
+        else
+            batch.add(position, centre);
+    }
+
+    void rebuildVerletLists();
+    [[nodiscard]] bool areVerletListsValid() const;
+    void invalidateVerletLists();
+    // Returns true if all interaction centres of a particle stored under tempParticleIdx are displaced by at most half
+    // of the skin from the reference positions of originalParticleIdx, for which Verlet lists were built
+    [[nodiscard]] bool isWithinVerletSkin(std::size_t originalParticleIdx, std::size_t tempParticleIdx) const;
+    [[nodiscard]] bool canUseVerletLists(std::size_t originalParticleIdx, std::size_t tempParticleIdx) const;
+    void checkVerletListDisplacement(std::size_t particleIdx);
 
     double calculateMoveOverlapEnergy(size_t particleIdx, size_t tempParticleIdx, const Interaction &interaction);
 
-    void removeInteractionCentresFromNeighbourGrid(std::size_t particleIdx);
-    void addInteractionCentresToNeighbourGrid(std::size_t particleIdx);
+    void moveInteractionCentresInNeighbourGrid(std::size_t particleIdx);
     void addInteractionCentresToNeighbourGrid();
 
     void recalculateAbsoluteInteractionCentres();
     void recalculateAbsoluteInteractionCentres(std::size_t particleIdx);
 
+    void translateTempPosition(std::size_t particleIdx, const Vector<3> &translation);
+
     void prepareTempInteractionCentres(std::size_t particleIdx);
     void rotateTempInteractionCentres(const Matrix<3, 3> &rotation);
     void acceptTempInteractionCentres();
@@ -92,47 +258,145 @@ private:
     // In all the methods below, tempParticleIdx means where the position is stored - may be equal to
     // originalParticleIdx or be the last index (temp shape). originalParticleIdx is the actual id of the particle, but
     // the position under it may be not representative at the moment - for example in the process of performing the move
+    //
+    // The methods are templated on the interaction type, so that for interactions listed in
+    // DevirtualisedInteractions.h the whole neighbour loop is instantiated with direct, inlined pair tests. For other
+    // interactions ConcreteInteraction is just Interaction. All instantiations are in Packing.cpp
+
+    // Calls visit_devirtualised_interaction with the type determined in Packing::setupForInteraction, if
+    // @a interaction is of the same dynamic type as the one, for which the packing was set up
+    template<typename Visitor>
+    decltype(auto) visitInteraction(const Interaction &interaction, Visitor &&visitor) const;
+
+    // Change of energy (apart from overlaps) after moving a particle to tempParticleIdx
+    [[nodiscard]] double calculateMoveEnergy(std::size_t particleIdx, std::size_t tempParticleIdx,
+                                             const Interaction &interaction) const;
 
     // "Main hub" for checking a single particle (all cases - with or without neighbour grid, one or many interaction
     // centres
+    template<typename ConcreteInteraction>
     [[nodiscard]] std::size_t countParticleOverlaps(std::size_t originalParticleIdx, std::size_t tempParticleIdx,
-                                                    const Interaction &interaction, bool earlyExit) const;
+                                                    const ConcreteInteraction &interaction, bool earlyExit) const;
     // Helper method for the overlap check without neighbour grid - exhaustive checks for all interaction centers
+    template<typename ConcreteInteraction>
     [[nodiscard]] std::size_t countOverlapsBetweenParticlesWithoutNG(std::size_t tempParticleIdx,
                                                                      std::size_t anotherParticleIdx,
-                                                                     const Interaction &interaction,
+                                                                     const ConcreteInteraction &interaction,
                                                                      bool earlyExit) const;
+    // Helper method for the overlap check with Verlet lists - all interaction centres (or the particle itself)
+    template<typename ConcreteInteraction>
+    [[nodiscard]] std::size_t countParticleOverlapsWithVerletLists(std::size_t originalParticleIdx,
+                                                                   std::size_t tempParticleIdx,
+                                                                   const ConcreteInteraction &interaction,
+                                                                   bool earlyExit) const;
     // Helper method for a single interaction center with neighbour grid
+    template<typename ConcreteInteraction>
     [[nodiscard]] std::size_t countInteractionCentreOverlapsWithNG(std::size_t originalParticleIdx,
                                                                    std::size_t tempParticleIdx,
                                                                    std::size_t centre,
-                                                                   const Interaction &interaction,
+                                                                   const ConcreteInteraction &interaction,
                                                                    bool earlyExit) const;
+    // Helper method for a single interaction centre and given neighbouring cells
+    template<typename ConcreteInteraction>
+    [[nodiscard]] std::size_t countInteractionCentreOverlapsInCells(std::size_t originalParticleIdx,
+                                                                    std::size_t tempParticleIdx, std::size_t centre,
+                                                                    const NeighbourGrid::NeighboursView &cells,
+                                                                    const ConcreteInteraction &interaction,
+                                                                    bool earlyExit) const;
     // Helper method for a single NG cell when checking all particles
+    template<typename ConcreteInteraction>
     [[nodiscard]] std::size_t countTotalOverlapsNGCellHelper(const std::array<std::size_t, 3> &coord,
-                                                             const Interaction &interaction, bool earlyExit) const;
+                                                             const ConcreteInteraction &interaction,
+                                                             bool earlyExit) const;
+    // Overlaps between all particles, without walls
+    template<typename ConcreteInteraction>
+    [[nodiscard]] std::size_t countTotalOverlapsHelper(const ConcreteInteraction &interaction, bool earlyExit) const;
     [[nodiscard]] std::size_t countParticleWallOverlaps(std::size_t particleIdx, const Interaction &interaction,
                                                         bool earlyExit) const;
 
     // Analogous helper methods as for overlaps but for energy
+    template<typename ConcreteInteraction>
     [[nodiscard]] double calculateParticleEnergy(std::size_t originalParticleIdx, std::size_t tempParticleIdx,
-                                                 const Interaction &interaction) const;
+                                                 const ConcreteInteraction &interaction) const;
+    template<typename ConcreteInteraction>
     [[nodiscard]] double calculateEnergyBetweenParticlesWithoutNG(std::size_t tempParticleIdx,
                                                                   std::size_t anotherParticleIdx,
-                                                                  const Interaction &interaction) const;
+                                                                  const ConcreteInteraction &interaction) const;
+    template<typename ConcreteInteraction>
+    [[nodiscard]] double calculateParticleEnergyWithVerletLists(std::size_t originalParticleIdx,
+                                                                std::size_t tempParticleIdx,
+                                                                const ConcreteInteraction &interaction) const;
+    template<typename ConcreteInteraction>
     [[nodiscard]] double calculateInteractionCentreEnergyWithNG(std::size_t originalParticleIdx,
                                                                 std::size_t tempParticleIdx, size_t centre,
-                                                                const Interaction &interaction) const;
+                                                                const ConcreteInteraction &interaction) const;
+    template<typename ConcreteInteraction>
+    [[nodiscard]] double calculateInteractionCentreEnergyInCells(std::size_t originalParticleIdx,
+                                                                 std::size_t tempParticleIdx, std::size_t centre,
+                                                                 const NeighbourGrid::NeighboursView &cells,
+                                                                 const ConcreteInteraction &interaction) const;
+    template<typename ConcreteInteraction>
     [[nodiscard]] double getTotalEnergyNGCellHelper(const std::array<std::size_t, 3> &coord,
-                                                    const Interaction &interaction) const;
+                                                    const ConcreteInteraction &interaction) const;
+    template<typename ConcreteInteraction>
+    [[nodiscard]] double getTotalEnergyHelper(const ConcreteInteraction &interaction) const;
+
+public:
+    /**
+     * @brief Default factor for Packing::setNeighbourGridCellSizeFactor.
+     */
+    static constexpr double DEFAULT_NEIGHBOUR_GRID_CELL_SIZE_FACTOR = 0.2;
+
+    /**
+     * @brief Random access iterator over shapes in the packing.
+     * @details As positions and orientations are stored in separate arrays, the iterator dereferences to a Shape
+     * assembled on the fly (returned by value), not to a reference.
+     */
+    class const_iterator {
+    private:
+        const Packing *packing{};
+        std::size_t idx{};
 
-    using iterator = decltype(shapes)::iterator;
+    public:
+        using iterator_category = std::random_access_iterator_tag;
+        using value_type = Shape;
+        using difference_type = std::ptrdiff_t;
+        using pointer = void;
+        using reference = Shape;
 
-    [[nodiscard]] iterator begin() { return this->shapes.begin(); }
-    [[nodiscard]] iterator end() { return this->shapes.end() - this->moveThreads; }
+        const_iterator() = default;
+        const_iterator(const Packing *packing, std::size_t idx) : packing{packing}, idx{idx} { }
 
-public:
-    using const_iterator = decltype(shapes)::const_iterator;
+        [[nodiscard]] Shape operator*() const {
+            std::size_t internalIdx = this->packing->toInternalIndex(this->idx);
+            return Shape(this->packing->getAbsolutePosition(internalIdx),
+                         this->packing->getOrientationMatrix(internalIdx));
+        }
+
+        [[nodiscard]] Shape operator[](difference_type n) const { return *(*this + n); }
+
+        const_iterator &operator++() { this->idx++; return *this; }
+        const_iterator operator++(int) { const_iterator copy = *this; this->idx++; return copy; }
+        const_iterator &operator--() { this->idx--; return *this; }
+        const_iterator operator--(int) { const_iterator copy = *this; this->idx--; return copy; }
+        const_iterator &operator+=(difference_type n) { this->idx += n; return *this; }
+        const_iterator &operator-=(difference_type n) { this->idx -= n; return *this; }
+
+        friend const_iterator operator+(const_iterator it, difference_type n) { return it += n; }
+        friend const_iterator operator+(difference_type n, const_iterator it) { return it += n; }
+        friend const_iterator operator-(const_iterator it, difference_type n) { return it -= n; }
+
+        friend difference_type operator-(const const_iterator &lhs, const const_iterator &rhs) {
+            return static_cast<difference_type>(lhs.idx) - static_cast<difference_type>(rhs.idx);
+        }
+
+        friend bool operator==(const const_iterator &lhs, const const_iterator &rhs) { return lhs.idx == rhs.idx; }
+        friend bool operator!=(const const_iterator &lhs, const const_iterator &rhs) { return lhs.idx != rhs.idx; }
+        friend bool operator<(const const_iterator &lhs, const const_iterator &rhs) { return lhs.idx < rhs.idx; }
+        friend bool operator>(const const_iterator &lhs, const const_iterator &rhs) { return lhs.idx > rhs.idx; }
+        friend bool operator<=(const const_iterator &lhs, const const_iterator &rhs) { return lhs.idx <= rhs.idx; }
+        friend bool operator>=(const const_iterator &lhs, const const_iterator &rhs) { return lhs.idx >= rhs.idx; }
+    };
 
     /**
      * @brief Creates an empty packing. Packing::restore method can then be used to load shapes.
@@ -175,45 +439,83 @@ public:
      * @brief Performs renormalization of rotation matrices.
      * @details If @a allowOverlaps is @a true, renormalization will be performed on all particles regardless if it
      * introduces overlaps or not. Otherwise, for each particle renormalization is performed like a Monte Carlo move
-     * - it is rejected if overlaps are introduces.
+     * - it is rejected if overlaps are introduces. If orientations are drift-free (see
+     * Packing::areOrientationsDriftFree()), the method does nothing.
      * @returns Number of particles, which were not normalized.
      */
     std::size_t renormalizeOrientations(const Interaction &interaction, bool allowOverlaps);
 
+    /**
+     * @brief Reorders particles in the internal storage along the Morton (Z-order) space-filling curve, so that
+     * particles close in space are also close in memory.
+     * @details It improves the cache locality of neighbour grid traversals, which degrades during the simulation as
+     * particles diffuse. The reordering is transparent - indices of particles used in all public methods (access,
+     * iteration, moves) are not altered, so observables, snapshots and trajectories see the original order.
+     * Interaction centres and neighbour grid are remapped accordingly.
+     */
+    void reorderParticles();
+
+    /**
+     * @brief Returns @a true if orientations are stored as unit quaternions (the project was built with
+     * @a RAMPACK_QUATERNION_ORIENTATIONS option). They are normalized after each rotation and interaction centres
+     * are recalculated from them (instead of being rotated incrementally), so the periodic renormalization is not
+     * needed.
+     */
+    static constexpr bool areOrientationsDriftFree() {
+#ifdef RAMPACK_QUATERNION_ORIENTATIONS
+        return true;
+#else
+        return false;
+#endif
+    }
+
     /**
      * @brief Return the number of shapes in the packing.
      */
-    [[nodiscard]] std::size_t size() const { return this->shapes.size() - this->moveThreads; }
+    [[nodiscard]] std::size_t size() const { return this->positions.size() - this->moveThreads; }
 
     /**
      * @brief Returns @a true, if packing is empty, false otherwise.
      */
-    [[nodiscard]] bool empty() const { return this->shapes.size() == this->moveThreads; }
+    [[nodiscard]] bool empty() const { return this->positions.size() == this->moveThreads; }
 
     /**
      * @brief Returns the begin iterator over the shapes in the packing.
      */
-    [[nodiscard]] const_iterator begin() const { return this->shapes.begin(); }
+    [[nodiscard]] const_iterator begin() const { return {this, 0}; }
 
     /**
      * @brief Returns the end iterator over the shapes in the packing.
      */
-    [[nodiscard]] const_iterator end() const { return this->shapes.end() - this->moveThreads; }
+    [[nodiscard]] const_iterator end() const { return {this, this->size()}; }
 
     /**
-     * @brief Read-only access to @a i -th shape
+     * @brief Read-only access to @a i -th shape. The shape is assembled from position and orientation arrays, thus it
+     * is returned by value.
      */
-    [[nodiscard]] const Shape &operator[](std::size_t i) const;
+    [[nodiscard]] Shape operator[](std::size_t i) const;
 
     /**
      * @brief Returns the first shape in the packing.
      */
-    [[nodiscard]] const Shape &front() const;
+    [[nodiscard]] Shape front() const;
 
     /**
      * @brief Returns the last shape in the packing.
      */
-    [[nodiscard]] const Shape &back() const;
+    [[nodiscard]] Shape back() const;
+
+    /**
+     * @brief Returns the position of @a i -th shape without assembling the whole Shape.
+     * @details If the packing is built with single precision positions, the absolute position is computed on the fly.
+     */
+    [[nodiscard]] Vector<3> getPosition(std::size_t i) const;
+
+    /**
+     * @brief Returns the orientation of @a i -th shape without assembling the whole Shape.
+     * @details If the packing is built with quaternion orientations, the rotation matrix is computed on the fly.
+     */
+    [[nodiscard]] Matrix<3, 3> getOrientation(std::size_t i) const;
 
     [[nodiscard]] const TriclinicBox &getBox() const { return this->box; }
 
@@ -231,11 +533,68 @@ public:
 
     /**
      * @brief Returns the number of neighbour grid cell in each direction.
+     * @details Subdivided cells (see Packing::setNeighbourGridCellSubdivisions) are not counted separately, so the
+     * cells are never smaller than the interaction range.
      */
     [[nodiscard]] std::array<std::size_t, 3> getNeighbourGridCellDivisions() const {
-        return this->neighbourGrid->getCellDivisions();
+        auto cellDivisions = this->neighbourGrid->getCellDivisions();
+        for (auto &cellDivision : cellDivisions)
+            cellDivision /= this->neighbourGridCellSubdivisions;
+        return cellDivisions;
     }
 
+    /**
+     * @brief Returns the requested neighbour grid cell size (real cells are not smaller) or 0 if the neighbour grid is
+     * not used.
+     */
+    [[nodiscard]] double getNeighbourGridCellSize() const;
+
+    /**
+     * @brief Sets the minimal neighbour grid cell size in the units of the mean distance between particles,
+     * <em>cbrt(V/N)</em>.
+     * @details The cell size is the maximum of the interaction range and the minimal one. Small factors give small
+     * cells only in dilute systems. Larger factors make cells larger also in dense systems, which decreases the number
+     * of cells to traverse at the cost of more distant neighbours. The neighbour grid is rebuilt if the packing is not
+     * empty.
+     */
+    void setNeighbourGridCellSizeFactor(double factor);
+
+    /**
+     * @brief Returns the factor set by Packing::setNeighbourGridCellSizeFactor.
+     */
+    [[nodiscard]] double getNeighbourGridCellSizeFactor() const { return this->neighbourGridCellSizeFactor; }
+
+    /**
+     * @brief Divides each neighbour grid cell into @a subdivisions parts in each direction.
+     * @details The cells are then a fraction of the interaction range (for example a half for @a subdivisions equal
+     * 2) and the cells in the corners of the cube spanning the range which cannot contain interacting particles are not
+     * visited (see NeighbourGrid::getExtendedNeighbouringCells), which decreases the volume searched for neighbours.
+     * The neighbour grid is rebuilt if the packing is not empty.
+     */
+    void setNeighbourGridCellSubdivisions(std::size_t subdivisions);
+
+    /**
+     * @brief Returns the number of subdivisions set by Packing::setNeighbourGridCellSubdivisions.
+     */
+    [[nodiscard]] std::size_t getNeighbourGridCellSubdivisions() const {
+        return this->neighbourGridCellSubdivisions;
+    }
+
+    /**
+     * @brief Toggles keeping only a single neighbour grid.
+     * @details By default, if the number of neighbour grid cells changes during Packing::tryScaling, a new grid is
+     * built and the old one is kept, so that Packing::revertScaling only swaps them back. If toggled @a true, the only
+     * grid is rebuilt for the new box and once again for the old box if the move is rejected. It halves the memory
+     * used by the neighbour grid at the cost of slower rejections of volume moves changing the number of cells (which
+     * are rare for large systems). The second grid is freed immediately.
+     */
+    void toggleLeanNeighbourGrid(bool lean);
+
+    /**
+     * @brief Returns @a true if only a single neighbour grid is kept (see Packing::toggleLeanNeighbourGrid).
+     */
+    [[nodiscard]] bool isNeighbourGridLean() const { return this->leanNeighbourGrid; }
+
     /**
      * @brief Toggles if overlaps should be counted when performing moves. If toggled @a false, early exit will
      * performed in methods like Packing::tryMove and Packing::tryScaling when the first overlap is found.
@@ -432,6 +791,11 @@ public:
      */
     [[nodiscard]] double getNeighbourGridRebuildMicroseconds() const { return this->neighbourGridRebuildMicroseconds; }
 
+    /**
+     * @brief Returns the number of Verlet list rebuilds since the last reset.
+     */
+    [[nodiscard]] std::size_t getVerletListRebuilds() const { return this->verletListRebuilds; }
+
     /**
      * @brief Returns an average number of neighbour per particles according to neighbour grid.
      */
@@ -458,6 +822,52 @@ public:
      */
     void resetNGRaceConditionSanitizer();
 
+    /**
+     * @brief Enables Verlet lists with a given @a skin or disables them if @a skin is 0.
+     * @details For each interaction centre (or particle if there are no interaction centres), a list of all centres
+     * closer than the interaction range plus @a skin is stored. As long as no centre is displaced by more than half of
+     * the skin since the lists were built, they contain all potentially interacting pairs and are used in molecule
+     * moves instead of traversing all neighbouring cells of the neighbour grid. A particle displaced further than that
+     * (or a box scaling) invalidates the lists - then the neighbour grid is used until they are rebuilt by
+     * Packing::updateVerletLists. Neighbour grid cells are enlarged by @a skin to make the rebuilds cheap. Verlet lists
+     * are not used if the packing is too small to have a neighbour grid.
+     */
+    void setVerletListSkin(double skin);
+
+    /**
+     * @brief Returns the Verlet list skin (0 if Verlet lists are disabled).
+     */
+    [[nodiscard]] double getVerletListSkin() const { return this->verletSkin; }
+
+    /**
+     * @brief Rebuilds Verlet lists if they are enabled and were invalidated (see Packing::setVerletListSkin). It should
+     * be called periodically, but not concurrently with molecule moves.
+     * @return @a true if the lists were rebuilt
+     */
+    bool updateVerletLists();
+
+    /**
+     * @brief Enables or disables the cache of separating directions for pairs of interaction centres from Verlet lists.
+     * @details For each pair from Verlet lists, the last direction separating it (found by
+     * Interaction::overlapBetweenWithHint) is stored. Since a single move changes the configuration only slightly, in
+     * most cases the pair is still separated along it and the full overlap test is skipped. The cache is reset each
+     * time the lists are rebuilt. It has any effect only with Verlet lists enabled (see Packing::setVerletListSkin)
+     * and an interaction making use of it (see Interaction::usesSeparatingDirections).
+     */
+    void toggleSeparatingDirectionCache(bool cache);
+
+    /**
+     * @brief Returns @a true if the cache of separating directions is enabled (see
+     * Packing::toggleSeparatingDirectionCache).
+     */
+    [[nodiscard]] bool isSeparatingDirectionCacheEnabled() const { return this->separatingDirectionCache; }
+
+    /**
+     * @brief Compacts the storage of the neighbour grid if it became fragmented due to molecule moves (see
+     * NeighbourGrid::compactIfNeeded). It should be called periodically, but not concurrently with molecule moves.
+     */
+    void compactNeighbourGrid();
+
     /**
      * @brief Returns the list of named points with name @a pointName specified in ShapeGeometry  @a geometryof all
      * molecules in the packing.
@@ -138,11 +138,20 @@ void Simulation::integrate(Environment env, const IntegrationParameters &params,
     } else {
         logger.info() << "Starting thermalisation..." << std::endl;
         for (std::size_t i{}; i < params.thermalisationCycles; i++) {
+            auto cycleStart = std::chrono::high_resolution_clock::now();
             this->performCycle(logger, shapeTraits);
+            auto cycleEnd = std::chrono::high_resolution_clock::now();
             this->updateThermodynamicParameters();
 
+            if (this->neighbourGridCellSizeTuner.has_value()) {
+                double cycleMicroseconds = std::chrono::duration<double, std::micro>(cycleEnd - cycleStart).count();
+                this->tuneNeighbourGridCellSize(cycleMicroseconds, logger);
+            }
+
             if (this->totalCycles % params.rotationMatrixFixEvery == 0)
                 this->fixRotationMatrices(shapeTraits.getInteraction(), logger);
+            if (params.particleReorderEvery != 0 && this->totalCycles % params.particleReorderEvery == 0)
+                this->packing->reorderParticles();
             if (this->totalCycles % params.snapshotEvery == 0) {
                 this->observablesCollector->addSnapshot(*this->packing, this->totalCycles, shapeTraits);
                 if (!simulationRecorders.empty())
@@ -172,6 +181,8 @@ void Simulation::integrate(Environment env, const IntegrationParameters &params,
 
             if (this->totalCycles % params.rotationMatrixFixEvery == 0)
                 this->fixRotationMatrices(shapeTraits.getInteraction(), logger);
+            if (params.particleReorderEvery != 0 && this->totalCycles % params.particleReorderEvery == 0)
+                this->packing->reorderParticles();
             if (this->totalCycles % params.snapshotEvery == 0) {
                 this->observablesCollector->addSnapshot(*this->packing, this->totalCycles, shapeTraits);
                 if (!simulationRecorders.empty())
@@ -259,6 +270,8 @@ void Simulation::relaxOverlaps(Environment env, const OverlapRelaxationParameter
 
         if (this->totalCycles % params.rotationMatrixFixEvery == 0)
             this->fixRotationMatrices(shapeTraits.getInteraction(), logger);
+        if (params.particleReorderEvery != 0 && this->totalCycles % params.particleReorderEvery == 0)
+            this->packing->reorderParticles();
         if (this->totalCycles % params.snapshotEvery == 0) {
             this->observablesCollector->addSnapshot(*this->packing, this->totalCycles, shapeTraits);
             if (!simulationRecorders.empty())
@@ -322,6 +335,27 @@ void Simulation::reset() {
     sigint_received = false;
 }
 
+void Simulation::tuneNeighbourGridCellSize(double cycleMicroseconds, Logger &logger) {
+    auto &tuner = *this->neighbourGridCellSizeTuner;
+    bool wasTuned = tuner.isTuned();
+    double numberDensity = static_cast<double>(this->packing->size()) / this->packing->getVolume();
+    if (tuner.registerCycle(cycleMicroseconds, numberDensity))
+        this->packing->setNeighbourGridCellSizeFactor(tuner.getFactor());
+
+    if (!wasTuned && tuner.isTuned()) {
+        logger.info() << "Neighbour grid cell size factor tuned to " << tuner.getFactor() << " (cell size: ";
+        logger << this->packing->getNeighbourGridCellSize() << ")" << std::endl;
+    } else if (wasTuned && !tuner.isTuned()) {
+        logger.info() << "Density changed; tuning neighbour grid cell size again..." << std::endl;
+    }
+}
+
+void Simulation::setNeighbourGridCellSizeTuner(std::optional<NeighbourGridCellSizeTuner> tuner) {
+    this->neighbourGridCellSizeTuner = std::move(tuner);
+    if (this->neighbourGridCellSizeTuner.has_value())
+        this->packing->setNeighbourGridCellSizeFactor(this->neighbourGridCellSizeTuner->getFactor());
+}
+
 void Simulation::performCycle(Logger &logger, const ShapeTraits &shapeTraits) {
     const auto &interaction = shapeTraits.getInteraction();
 
@@ -365,6 +399,9 @@ void Simulation::performCycle(Logger &logger, const ShapeTraits &shapeTraits) {
 void Simulation::performMoves(const ShapeTraits &shapeTraits, Logger &logger) {
     auto previousDomainDivision = this->domainDivisions;
 
+    // Verlet lists could have been invalidated by the last moves or box scaling
+    this->packing->updateVerletLists();
+
     while (true) {
         try {
             if (this->numDomains == 1)
@@ -379,6 +416,9 @@ void Simulation::performMoves(const ShapeTraits &shapeTraits, Logger &logger) {
         }
     }
 
+    // Accepted moves may have grown some neighbour grid cells beyond their capacity
+    this->packing->compactNeighbourGrid();
+
     if (this->domainDivisions != previousDomainDivision) {
         logger.warn() << "Domains are too narrow; reducing their number to [";
         logger << this->domainDivisions[0] << ", " << this->domainDivisions[1] << ", " << this->domainDivisions[2];
@@ -748,6 +788,10 @@ std::vector<Simulation::MoveStatistics> Simulation::getMovesStatistics() const {
 }
 
 void Simulation::fixRotationMatrices(const Interaction &interaction, Logger &logger) {
+    // Quaternion orientations are normalized after each rotation, so there is nothing to fix
+    if constexpr (Packing::areOrientationsDriftFree())
+        return;
+
     if (this->areOverlapsCounted) {
         this->packing->renormalizeOrientations(interaction, true);
     } else {
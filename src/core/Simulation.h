@@ -29,6 +29,7 @@
 #include "SimulationRecorder.h"
 #include "DynamicParameter.h"
 #include "DomainDecomposition.h"
+#include "NeighbourGridCellSizeTuner.h"
 
 
 /**
@@ -171,6 +172,7 @@ public:
         std::size_t snapshotEvery = 100;
         std::size_t inlineInfoEvery = 100;
         std::size_t rotationMatrixFixEvery = 10000;
+        std::size_t particleReorderEvery{};
         std::size_t cycleOffset{};
     };
 
@@ -178,6 +180,7 @@ public:
         std::size_t snapshotEvery = 100;
         std::size_t inlineInfoEvery = 100;
         std::size_t rotationMatrixFixEvery = 10000;
+        std::size_t particleReorderEvery{};
         std::size_t cycleOffset{};
     };
 
@@ -230,6 +233,7 @@ private:
     std::size_t numDomains{};
 
     std::shared_ptr<ObservablesCollector> observablesCollector;
+    std::optional<NeighbourGridCellSizeTuner> neighbourGridCellSizeTuner;
 
     static std::vector<std::unique_ptr<MoveSampler>> makeRototranslation(double translationStepSize,
                                                                          double rotationStepSize);
@@ -255,6 +259,7 @@ private:
     void printInlineInfo(std::size_t cycleNumber, const ShapeTraits &traits, Logger &logger, bool displayOverlaps);
     [[nodiscard]] std::vector<std::size_t> calculateMoveTypeAccumulations(std::size_t numParticles) const;
     void fixRotationMatrices(const Interaction &interaction, Logger &logger);
+    void tuneNeighbourGridCellSize(double cycleMicroseconds, Logger &logger);
     static double getRotationMatrixDeviation(const Matrix<3, 3> &rotation);
 
     [[nodiscard]] MoveStatistics getScalingStatistics() const;
@@ -404,6 +409,21 @@ public:
 
     [[nodiscard]] const Packing &getPacking() const { return *this->packing; }
 
+    /**
+     * @brief Enables automatic tuning of the neighbour grid cell size during thermalisation using @a tuner (see
+     * NeighbourGridCellSizeTuner) or disables it if @a tuner is @a std::nullopt.
+     * @details The tuner measures the duration of thermalisation cycles and sets
+     * Packing::setNeighbourGridCellSizeFactor accordingly. The tuned factor is kept for next runs.
+     */
+    void setNeighbourGridCellSizeTuner(std::optional<NeighbourGridCellSizeTuner> tuner);
+
+    /**
+     * @brief Returns the neighbour grid cell size tuner, if set (see Simulation::setNeighbourGridCellSizeTuner).
+     */
+    [[nodiscard]] const std::optional<NeighbourGridCellSizeTuner> &getNeighbourGridCellSizeTuner() const {
+        return this->neighbourGridCellSizeTuner;
+    }
+
 
     [[nodiscard]] std::size_t getTotalCycles() const { return this->totalCycles; }
 
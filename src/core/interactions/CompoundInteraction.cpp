@@ -33,6 +33,22 @@ CompoundInteraction::CompoundInteraction(const Interaction &interaction1, const
     this->rangeRadius = std::max(this->interaction1.getRangeRadius(), this->interaction2.getRangeRadius());
     this->totalRangeRadius = std::max(this->interaction1.getTotalRangeRadius(),
                                       this->interaction2.getTotalRangeRadius());
+
+    // Centre ranges are combined elementwise. If only one interaction specifies them, the other one is uniform
+    auto ranges1 = this->interaction1.getInteractionCentreRanges();
+    auto ranges2 = this->interaction2.getInteractionCentreRanges();
+    if (!ranges1.empty() || !ranges2.empty()) {
+        std::size_t numCentres = std::max(ranges1.size(), ranges2.size());
+        if (ranges1.empty())
+            ranges1.resize(numCentres, this->interaction1.getRangeRadius() / 2);
+        if (ranges2.empty())
+            ranges2.resize(numCentres, this->interaction2.getRangeRadius() / 2);
+        Expects(ranges1.size() == ranges2.size());
+
+        this->interactionCentreRanges.resize(numCentres);
+        for (std::size_t i{}; i < numCentres; i++)
+            this->interactionCentreRanges[i] = std::max(ranges1[i], ranges2[i]);
+    }
 }
 
 double CompoundInteraction::calculateEnergyBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
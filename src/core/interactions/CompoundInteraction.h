@@ -17,6 +17,7 @@ private:
     const Interaction &interaction2;
 
     std::vector<Vector<3>> interactionCentres;
+    std::vector<double> interactionCentreRanges;
     double rangeRadius{};
     double totalRangeRadius{};
     bool hasSoftPart1{};
@@ -40,6 +41,9 @@ public:
     [[nodiscard]] bool isConvex() const override { return this->isThisConvex; }
     [[nodiscard]] double getRangeRadius() const override { return this->rangeRadius; }
     [[nodiscard]] std::vector<Vector<3>> getInteractionCentres() const override { return this->interactionCentres; }
+    [[nodiscard]] std::vector<double> getInteractionCentreRanges() const override {
+        return this->interactionCentreRanges;
+    }
     [[nodiscard]] double getTotalRangeRadius() const override { return this->totalRangeRadius; }
 
     [[nodiscard]] double calculateEnergyBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
@@ -0,0 +1,156 @@
+#include <algorithm>
+#include <cmath>
+#include <numeric>
+
+#include "MoleculeInteraction.h"
+#include "core/FreeBoundaryConditions.h"
+#include "geometry/SegmentDistanceCalculator.h"
+#include "utils/Exceptions.h"
+
+
+MoleculeInteraction::MoleculeInteraction(const Interaction &interaction) : interaction{interaction} {
+    auto originalCentres = this->interaction.getInteractionCentres();
+    Expects(!originalCentres.empty());
+    std::size_t numCentres = originalCentres.size();
+
+    double originalRange = this->interaction.getRangeRadius();
+    auto originalRanges = this->interaction.getInteractionCentreRanges();
+    if (originalRanges.empty())
+        originalRanges.resize(numCentres, originalRange / 2);
+    Expects(originalRanges.size() == numCentres);
+
+    this->rangeRadius = this->interaction.getTotalRangeRadius();
+    ExpectsMsg(std::isfinite(this->rangeRadius), "MoleculeInteraction: interaction range has to be finite");
+
+    // The axis joins two most distant centres. For a chain it is the chain axis
+    double maxDistance2{};
+    this->axis = {0, 0, 1};
+    for (std::size_t i{}; i < numCentres; i++) {
+        for (std::size_t j = i + 1; j < numCentres; j++) {
+            Vector<3> diff = originalCentres[j] - originalCentres[i];
+            double distance2 = diff.norm2();
+            if (distance2 > maxDistance2) {
+                maxDistance2 = distance2;
+                this->axis = diff.normalized();
+            }
+        }
+    }
+
+    this->centreIndices.resize(numCentres);
+    std::iota(this->centreIndices.begin(), this->centreIndices.end(), 0);
+    std::sort(this->centreIndices.begin(), this->centreIndices.end(),
+              [&originalCentres, this](std::size_t i, std::size_t j) {
+                  return originalCentres[i] * this->axis < originalCentres[j] * this->axis;
+              });
+
+    for (std::size_t idx : this->centreIndices) {
+        const auto &centre = originalCentres[idx];
+        this->centres.push_back(centre);
+        this->centreRanges.push_back(originalRanges[idx]);
+        double axialCoordinate = centre * this->axis;
+        this->axialCoordinates.push_back(axialCoordinate);
+        double perpendicularDistance = (centre - axialCoordinate * this->axis).norm();
+        this->capsuleRadius = std::max(this->capsuleRadius, perpendicularDistance + originalRanges[idx]);
+    }
+    this->axialMin = this->axialCoordinates.front();
+    this->axialMax = this->axialCoordinates.back();
+    this->maxCentreRange = *std::max_element(this->centreRanges.begin(), this->centreRanges.end());
+
+    this->hardPart = this->interaction.hasHardPart();
+    this->softPart = this->interaction.hasSoftPart();
+    this->wallPart = this->interaction.hasWallPart();
+    this->isThisConvex = this->interaction.isConvex();
+}
+
+template<typename PairHandler>
+bool MoleculeInteraction::forEachCentrePairInRange(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                                   const Vector<3> &pos2, const Matrix<3, 3> &orientation2,
+                                                   PairHandler &&handler) const
+{
+    if ((pos2 - pos1).norm2() > this->rangeRadius * this->rangeRadius)
+        return false;
+
+    Vector<3> axis1 = orientation1 * this->axis;
+    Vector<3> axis2 = orientation2 * this->axis;
+    double capsuleDistance2 = SegmentDistanceCalculator::calculate(pos1 + this->axialMin * axis1,
+                                                                   pos1 + this->axialMax * axis1,
+                                                                   pos2 + this->axialMin * axis2,
+                                                                   pos2 + this->axialMax * axis2);
+    if (capsuleDistance2 > 4 * this->capsuleRadius * this->capsuleRadius)
+        return false;
+
+    for (std::size_t i{}; i < this->centres.size(); i++) {
+        Vector<3> centrePos1 = pos1 + orientation1 * this->centres[i];
+        Vector<3> relativePos1 = centrePos1 - pos2;
+        double range1 = this->centreRanges[i];
+        double axialPos1 = relativePos1 * axis2;
+        double capsulePos1 = std::clamp(axialPos1, this->axialMin, this->axialMax);
+        double maxCapsuleDistance = range1 + this->capsuleRadius;
+        if ((relativePos1 - capsulePos1 * axis2).norm2() > maxCapsuleDistance * maxCapsuleDistance)
+            continue;
+
+        // The distance between centres is not smaller than the distance between their projections onto axis2, so
+        // only centres within the window [axialPos1 - maxRange, axialPos1 + maxRange] have to be checked
+        double maxRange = range1 + this->maxCentreRange;
+        auto first = std::lower_bound(this->axialCoordinates.begin(), this->axialCoordinates.end(),
+                                      axialPos1 - maxRange);
+        for (std::size_t j = first - this->axialCoordinates.begin(); j < this->centres.size(); j++) {
+            if (this->axialCoordinates[j] > axialPos1 + maxRange)
+                break;
+
+            Vector<3> centrePos2 = pos2 + orientation2 * this->centres[j];
+            double pairRange = range1 + this->centreRanges[j];
+            if ((centrePos2 - centrePos1).norm2() > pairRange * pairRange)
+                continue;
+
+            if (handler(centrePos1, this->centreIndices[i], centrePos2, this->centreIndices[j]))
+                return true;
+        }
+    }
+    return false;
+}
+
+double MoleculeInteraction::calculateEnergyBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                                   [[maybe_unused]] std::size_t idx1, const Vector<3> &pos2,
+                                                   const Matrix<3, 3> &orientation2,
+                                                   [[maybe_unused]] std::size_t idx2,
+                                                   const BoundaryConditions &bc) const
+{
+    // Periodic translation is applied to the whole molecule
+    Vector<3> pos2bc = pos2 + bc.getTranslation(pos1, pos2);
+    FreeBoundaryConditions noTranslation;
+    double energy{};
+    this->forEachCentrePairInRange(pos1, orientation1, pos2bc, orientation2,
+        [&](const Vector<3> &centrePos1, std::size_t centre1, const Vector<3> &centrePos2, std::size_t centre2) {
+            energy += this->interaction.calculateEnergyBetween(centrePos1, orientation1, centre1, centrePos2,
+                                                               orientation2, centre2, noTranslation);
+            return false;
+        });
+    return energy;
+}
+
+bool MoleculeInteraction::overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                         [[maybe_unused]] std::size_t idx1, const Vector<3> &pos2,
+                                         const Matrix<3, 3> &orientation2, [[maybe_unused]] std::size_t idx2,
+                                         const BoundaryConditions &bc) const
+{
+    Vector<3> pos2bc = pos2 + bc.getTranslation(pos1, pos2);
+    FreeBoundaryConditions noTranslation;
+    return this->forEachCentrePairInRange(pos1, orientation1, pos2bc, orientation2,
+        [&](const Vector<3> &centrePos1, std::size_t centre1, const Vector<3> &centrePos2, std::size_t centre2) {
+            return this->interaction.overlapBetween(centrePos1, orientation1, centre1, centrePos2, orientation2,
+                                                    centre2, noTranslation);
+        });
+}
+
+bool MoleculeInteraction::overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation,
+                                          [[maybe_unused]] std::size_t idx, const Vector<3> &wallOrigin,
+                                          const Vector<3> &wallVector) const
+{
+    for (std::size_t i{}; i < this->centres.size(); i++) {
+        Vector<3> centrePos = pos + orientation * this->centres[i];
+        if (this->interaction.overlapWithWall(centrePos, orientation, this->centreIndices[i], wallOrigin, wallVector))
+            return true;
+    }
+    return false;
+}
@@ -0,0 +1,85 @@
+#ifndef RAMPACK_MOLECULEINTERACTION_H
+#define RAMPACK_MOLECULEINTERACTION_H
+
+#include <vector>
+
+#include "core/Interaction.h"
+
+
+/**
+ * @brief The class presenting a multi-centre interaction as a single-centre one, so that whole molecules (and not
+ * individual interaction centres) are stored in the neighbour grid.
+ * @details Interaction centres are sorted along the axis joining the two most distant ones and enclosed (together
+ * with their ranges) in a capsule (spherocylinder) along this axis. Two molecules are compared centre-by-centre only
+ * if their capsules intersect. Then, centres of the first molecule too far from the capsule of the second one are
+ * skipped and, for the remaining ones, only a window of centres of the second molecule, whose projections onto its
+ * axis are close enough, is scanned. For long chain-like molecules it is much fewer than all pairs of centres. The
+ * results are the same as for the original interaction, since centre pairs further than the sum of their ranges (see
+ * Interaction::getInteractionCentreRanges) do not interact. Indices of centres passed to the original interaction are
+ * the original ones.
+ */
+class MoleculeInteraction : public Interaction {
+private:
+    const Interaction &interaction;
+
+    // Centres, their ranges and original indices, sorted by the axial coordinate
+    std::vector<Vector<3>> centres;
+    std::vector<double> centreRanges;
+    std::vector<std::size_t> centreIndices;
+    std::vector<double> axialCoordinates;
+    Vector<3> axis;
+    double maxCentreRange{};
+    // The capsule (spherocylinder) along the axis enclosing all centres enlarged by their ranges
+    double axialMin{};
+    double axialMax{};
+    double capsuleRadius{};
+    double rangeRadius{};
+    bool hardPart{};
+    bool softPart{};
+    bool wallPart{};
+    bool isThisConvex{};
+
+    template<typename PairHandler>
+    bool forEachCentrePairInRange(const Vector<3> &pos1, const Matrix<3, 3> &orientation1, const Vector<3> &pos2,
+                                  const Matrix<3, 3> &orientation2, PairHandler &&handler) const;
+
+public:
+    /**
+     * @brief Creates the object for a given multi-centre @a interaction.
+     * @details The interaction has to have at least one interaction centre (see Interaction::getInteractionCentres)
+     * and a finite range. The reference to @a interaction is stored, so it has to outlive this object.
+     */
+    explicit MoleculeInteraction(const Interaction &interaction);
+
+    [[nodiscard]] bool hasHardPart() const override { return this->hardPart; }
+    [[nodiscard]] bool hasSoftPart() const override { return this->softPart; }
+    [[nodiscard]] bool hasWallPart() const override { return this->wallPart; }
+    [[nodiscard]] bool isConvex() const override { return this->isThisConvex; }
+
+    /**
+     * @brief Returns the diameter of the bounding sphere of the molecule enlarged by the range of interaction
+     * centres, i.e. Interaction::getTotalRangeRadius of the original interaction.
+     */
+    [[nodiscard]] double getRangeRadius() const override { return this->rangeRadius; }
+
+    [[nodiscard]] double calculateEnergyBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                                std::size_t idx1, const Vector<3> &pos2,
+                                                const Matrix<3, 3> &orientation2, std::size_t idx2,
+                                                const BoundaryConditions &bc) const override;
+
+    [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1, std::size_t idx1,
+                                      const Vector<3> &pos2, const Matrix<3, 3> &orientation2, std::size_t idx2,
+                                      const BoundaryConditions &bc) const override;
+
+    [[nodiscard]] bool overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation, std::size_t idx,
+                                       const Vector<3> &wallOrigin, const Vector<3> &wallVector) const override;
+
+    /**
+     * @brief Returns the axis (in the molecule's own coordinate system) along which the interaction centres are
+     * sorted.
+     */
+    [[nodiscard]] const Vector<3> &getAxis() const { return this->axis; }
+};
+
+
+#endif //RAMPACK_MOLECULEINTERACTION_H
@@ -2,10 +2,11 @@
 // Created by pkua on 08.06.22.
 //
 
+#include <algorithm>
+
 #include "LayerWiseCellOptimizationTransformer.h"
 #include "LatticeTraits.h"
 #include "core/PeriodicBoundaryConditions.h"
-#include "core/Packing.h"
 
 
 LayerWiseCellOptimizationTransformer::LayerWiseCellOptimizationTransformer(LatticeTraits::Axis layerAxis,
@@ -28,13 +29,12 @@ void LayerWiseCellOptimizationTransformer::transform(Lattice &lattice, const Sha
     auto layerAssociation = LatticeTraits::getLayerAssociation(lattice.getUnitCell(), this->layerAxis);
     TransformerValidateMsg(!layerAssociation.empty(), "Lattice is empty; cannot perform layerwise optimization");
 
-    auto pbc = std::make_unique<PeriodicBoundaryConditions>();
-    Packing testPacking(lattice.getLatticeBox(), lattice.generateMolecules(), std::move(pbc), interaction);
-    TransformerValidateMsg(!testPacking.countTotalOverlaps(interaction),
+    TransformerValidateMsg(!this->areShapesOverlapping(lattice.getCellBox(), lattice.getUnitCellMolecules(),
+                                                       lattice.getDimensions(), interaction),
                            "Overlaps are present at the beginning of layerwise optimization");
 
-    this->optimizeLayers(lattice, layerAssociation, testPacking, interaction);
-    this->optimizeCell(lattice, testPacking, interaction);
+    this->optimizeLayers(lattice, layerAssociation, interaction);
+    this->optimizeCell(lattice, interaction);
     this->introduceSpacing(lattice, layerAssociation);
     this->centerShapesInCell(lattice.modifyUnitCellMolecules());
 
@@ -44,18 +44,31 @@ void LayerWiseCellOptimizationTransformer::transform(Lattice &lattice, const Sha
 bool LayerWiseCellOptimizationTransformer::areShapesOverlapping(const TriclinicBox &box,
                                                                 const std::vector<Shape> &shapes,
                                                                 const std::array<std::size_t, 3> &latticeDim,
-                                                                Packing &testPacking,
                                                                 const Interaction &interaction) const
 {
     Lattice testLattice(UnitCell(box, shapes), latticeDim);
     testLattice.normalize();
-    testPacking.reset(testLattice.generateMolecules(), testLattice.getLatticeBox(), interaction);
-    return testPacking.countTotalOverlaps(interaction);
+    auto molecules = testLattice.generateMolecules();
+    PeriodicBoundaryConditions pbc(testLattice.getLatticeBox());
+    double range = interaction.getTotalRangeRadius();
+
+    // Overlaps are tested directly on double precision positions and not using Packing, which may round them (see
+    // RAMPACK_SINGLE_PRECISION_POSITIONS build option) - bisections below resolve contacts much more accurately than
+    // that. The lattice is regular, so it is enough to test molecules from the first cell against all the other ones
+    for (std::size_t i{}; i < shapes.size(); i++) {
+        for (std::size_t j{}; j < molecules.size(); j++) {
+            if (i == j || pbc.getDistance2(molecules[i].getPosition(), molecules[j].getPosition()) > range*range)
+                continue;
+            if (interaction.overlapBetweenShapes(molecules[i], molecules[j], pbc))
+                return true;
+        }
+    }
+    return false;
 }
 
 void LayerWiseCellOptimizationTransformer::optimizeLayers(Lattice &lattice,
                                                           const LatticeTraits::LayerAssociation &layerAssociation,
-                                                          Packing &testPacking, const Interaction &interaction) const
+                                                          const Interaction &interaction) const
 {
     const auto &cellBox = lattice.getCellBox();
     auto &cellShapes = lattice.modifyUnitCellMolecules();
@@ -78,7 +91,7 @@ void LayerWiseCellOptimizationTransformer::optimizeLayers(Lattice &lattice,
                 shape.setPosition(pos);
             }
 
-            if (this->areShapesOverlapping(cellBox, midShapes, lattice.getDimensions(), testPacking, interaction)) {
+            if (this->areShapesOverlapping(cellBox, midShapes, lattice.getDimensions(), interaction)) {
                 begLayerCoord = midLayerCoord;
             } else {
                 endLayerCoord = midLayerCoord;
@@ -113,8 +126,7 @@ auto LayerWiseCellOptimizationTransformer::rescaleCell(const TriclinicBox &oldBo
     return std::make_pair(TriclinicBox(newCellSides), newShapes);
 }
 
-void LayerWiseCellOptimizationTransformer::optimizeCell(Lattice &lattice, Packing &testPacking,
-                                                        const Interaction &interaction) const
+void LayerWiseCellOptimizationTransformer::optimizeCell(Lattice &lattice, const Interaction &interaction) const
 {
     double range = interaction.getTotalRangeRadius();
     std::size_t axisIdx = LatticeTraits::axisToIndex(this->layerAxis);
@@ -137,8 +149,7 @@ void LayerWiseCellOptimizationTransformer::optimizeCell(Lattice &lattice, Packin
     double begFactor = range * FACTOR_EPSILON / boxHeights[axisIdx];  // Smallest scaling without self-overlap
     double endFactor = 1;
     auto [begBox, begShapes] = this->rescaleCell(initialCellBox, initialShapes, begFactor);
-    TransformerValidateMsg(this->areShapesOverlapping(begBox, begShapes, lattice.getDimensions(), testPacking,
-                                                      interaction),
+    TransformerValidateMsg(this->areShapesOverlapping(begBox, begShapes, lattice.getDimensions(), interaction),
                            "Layerwise optimization: maximally shrunk cell (without PBC image self-overlaps) is not "
                            "overlapping. Use more lattice cells.");
 
@@ -147,7 +158,7 @@ void LayerWiseCellOptimizationTransformer::optimizeCell(Lattice &lattice, Packin
         double midFactor = (begFactor + endFactor) / 2;
         auto [midBox, midShapes] = this->rescaleCell(initialCellBox, initialShapes, midFactor);
 
-        if (this->areShapesOverlapping(midBox, midShapes, lattice.getDimensions(), testPacking, interaction)) {
+        if (this->areShapesOverlapping(midBox, midShapes, lattice.getDimensions(), interaction)) {
             begFactor = midFactor;
         } else {
             endFactor = midFactor;
@@ -8,7 +8,6 @@
 #include "LatticeTransformer.h"
 #include "LatticeTraits.h"
 #include "core/Interaction.h"
-#include "core/Packing.h"
 
 
 /**
@@ -21,13 +20,13 @@ private:
     double spacing;
 
     [[nodiscard]] bool areShapesOverlapping(const TriclinicBox &box, const std::vector<Shape> &shapes,
-                                            const std::array<std::size_t, 3> &latticeDim, Packing &testPacking,
+                                            const std::array<std::size_t, 3> &latticeDim,
                                             const Interaction &interaction) const;
     void optimizeLayers(Lattice &lattice, const LatticeTraits::LayerAssociation &layerAssociation,
-                        Packing &testPacking, const Interaction &interaction) const;
+                        const Interaction &interaction) const;
     [[nodiscard]] auto rescaleCell(const TriclinicBox &oldBox, const std::vector<Shape> &oldShapes,
                                    double factor) const;
-    void optimizeCell(Lattice &lattice, Packing &testPacking, const Interaction &interaction) const;
+    void optimizeCell(Lattice &lattice, const Interaction &interaction) const;
     void introduceSpacing(Lattice &lattice, const LatticeTraits::LayerAssociation &layerAssociation) const;
     void centerShapesInCell(std::vector<Shape> &cellShapes) const;
 
@@ -0,0 +1,81 @@
+#include <algorithm>
+#include <cmath>
+#include <sstream>
+
+#include "EllipsoidTraits.h"
+#include "utils/Exceptions.h"
+#include "geometry/xenocollide/XCPrimitives.h"
+#include "XCObjShapePrinter.h"
+
+
+EllipsoidTraits::EllipsoidTraits(double rx, double ry, double rz)
+        : semiAxes{rx, ry, rz}, boundingBox({0, 0, 0}, {rx, ry, rz}),
+          wolframPrinter{std::make_shared<WolframPrinter>(*this)}
+{
+    Expects(rx > 0);
+    Expects(ry > 0);
+    Expects(rz > 0);
+
+    this->circumsphereRadius = *std::max_element(this->semiAxes.begin(), this->semiAxes.end());
+    this->insphereRadius = *std::min_element(this->semiAxes.begin(), this->semiAxes.end());
+
+    this->registerNamedPoint("cm", {0, 0, 0});
+}
+
+Vector<3> EllipsoidTraits::getPrimaryAxis(const Shape &shape) const {
+    return shape.getOrientation().column(2);
+}
+
+Vector<3> EllipsoidTraits::getSecondaryAxis(const Shape &shape) const {
+    return shape.getOrientation().column(0);
+}
+
+double EllipsoidTraits::getVolume() const {
+    return 4./3*M_PI*this->semiAxes[0]*this->semiAxes[1]*this->semiAxes[2];
+}
+
+bool EllipsoidTraits::overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation,
+                                      [[maybe_unused]] std::size_t idx, const Vector<3> &wallOrigin,
+                                      const Vector<3> &wallVector) const
+{
+    // The extent of the ellipsoid along the wall normal is given by its support function
+    Vector<3> normal = orientation.transpose() * wallVector;
+    double extent{};
+    for (std::size_t i{}; i < 3; i++)
+        extent += std::pow(this->semiAxes[i] * normal[i], 2);
+    extent = std::sqrt(extent);
+
+    return wallVector * (pos - wallOrigin) < extent;
+}
+
+std::shared_ptr<const ShapePrinter>
+EllipsoidTraits::getPrinter(const std::string &format, const std::map<std::string, std::string> &params) const {
+    std::size_t meshSubdivisions = DEFAULT_MESH_SUBDIVISIONS;
+    if (params.find("mesh_divisions") != params.end()) {
+        meshSubdivisions = std::stoul(params.at("mesh_divisions"));
+        Expects(meshSubdivisions >= 1);
+    }
+
+    if (format == "wolfram")
+        return this->wolframPrinter;
+    else if (format == "obj")
+        return std::make_shared<XCObjShapePrinter>(XCEllipsoid(this->semiAxes), meshSubdivisions);
+    else
+        throw NoSuchShapePrinterException("EllipsoidTraits: unknown printer format: " + format);
+}
+
+std::string EllipsoidTraits::WolframPrinter::print(const Shape &shape) const {
+    // Wolfram's Ellipsoid[p, Σ] is the set of points x with (x - p).Inverse[Σ].(x - p) <= 1
+    auto shapeMatrix = EllipsoidContactCalculator::calculateShapeMatrix(shape.getOrientation(),
+                                                                        this->traits.semiAxes);
+    std::ostringstream out;
+    out << std::fixed;
+    out << "Ellipsoid[" << shape.getPosition() << ",{";
+    for (std::size_t i{}; i < 3; i++) {
+        out << Vector<3>{shapeMatrix(i, 0), shapeMatrix(i, 1), shapeMatrix(i, 2)};
+        if (i < 2)
+            out << ",";
+    }
+    out << "}]";
+    return out.str();
+}
@@ -0,0 +1,102 @@
+#ifndef RAMPACK_ELLIPSOIDTRAITS_H
+#define RAMPACK_ELLIPSOIDTRAITS_H
+
+#include "core/ShapeTraits.h"
+#include "geometry/EllipsoidContactCalculator.h"
+#include "geometry/xenocollide/XCBoundingBox.h"
+
+
+/**
+ * @brief Hard ellipsoid with semi-axes along x, y and z axes.
+ * @details The overlap test uses the analytic Perram-Wertheim contact function (see EllipsoidContactCalculator)
+ * preceded by the circumsphere, insphere and oriented bounding box tests, which is faster than the general XenoCollide
+ * test of XCEllipsoid. Primary axis is z axis and secondary axis is x axis. Mass centre coincides with geometric
+ * origin.
+ */
+class EllipsoidTraits : public ShapeTraits, public Interaction, public ShapeGeometry {
+private:
+    class WolframPrinter : public ShapePrinter {
+    private:
+        const EllipsoidTraits &traits;
+
+    public:
+        explicit WolframPrinter(const EllipsoidTraits &traits) : traits{traits} { }
+        [[nodiscard]] std::string print(const Shape &shape) const override;
+    };
+
+    Vector<3> semiAxes;
+    double circumsphereRadius{};
+    double insphereRadius{};
+    XCBoundingBox boundingBox;
+    std::shared_ptr<WolframPrinter> wolframPrinter;
+
+    friend WolframPrinter;
+
+public:
+    /** @brief The default number of sphere subdivisions when printing the shape (see XCPrinter::XCPrinter
+     * @a subdivision parameter) */
+    static constexpr std::size_t DEFAULT_MESH_SUBDIVISIONS = 4;
+
+    /**
+     * @brief Creates an ellipsoid with semi-axes @a rx, @a ry, @a rz along, respectively, x, y and z axes.
+     */
+    EllipsoidTraits(double rx, double ry, double rz);
+
+    [[nodiscard]] const Interaction &getInteraction() const override { return *this; }
+    [[nodiscard]] const ShapeGeometry &getGeometry() const override { return *this; }
+
+    /**
+     * @brief Returns ShapePrinter for a given @a format.
+     * @details The following formats are supported:
+     * <ol>
+     *     <li> `wolfram` - Wolfram Mathematica shape
+     *     <li> `obj` - Wavefront OBJ triangle mesh (it accepts @a mesh_divisions parameter, default: 4)
+     * </ol>
+     */
+    [[nodiscard]] std::shared_ptr<const ShapePrinter>
+    getPrinter(const std::string &format, const std::map<std::string, std::string> &params) const override;
+
+    [[nodiscard]] Vector<3> getPrimaryAxis(const Shape &shape) const override;
+    [[nodiscard]] Vector<3> getSecondaryAxis(const Shape &shape) const override;
+    [[nodiscard]] double getVolume() const override;
+
+    [[nodiscard]] bool hasHardPart() const override { return true; }
+    [[nodiscard]] bool hasWallPart() const override { return true; }
+    [[nodiscard]] bool hasSoftPart() const override { return false; }
+    [[nodiscard]] bool isConvex() const override { return true; }
+
+    [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                      [[maybe_unused]] std::size_t idx1, const Vector<3> &pos2,
+                                      const Matrix<3, 3> &orientation2, [[maybe_unused]] std::size_t idx2,
+                                      const BoundaryConditions &bc) const override
+    {
+        Vector<3> pos2bc = pos2 + bc.getTranslation(pos1, pos2);
+        Vector<3> r = pos2bc - pos1;
+        double distance2 = r.norm2();
+        if (distance2 >= 4 * this->circumsphereRadius * this->circumsphereRadius)
+            return false;
+        if (distance2 < 4 * this->insphereRadius * this->insphereRadius)
+            return true;
+        if (XCBoundingBox::areSeparated(this->boundingBox, orientation1, pos1, this->boundingBox, orientation2, pos2bc))
+            return false;
+
+        return EllipsoidContactCalculator::overlap(
+            EllipsoidContactCalculator::calculateShapeMatrix(orientation1, this->semiAxes),
+            EllipsoidContactCalculator::calculateShapeMatrix(orientation2, this->semiAxes),
+            r
+        );
+    }
+
+    [[nodiscard]] bool overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation, std::size_t idx,
+                                       const Vector<3> &wallOrigin, const Vector<3> &wallVector) const override;
+
+    [[nodiscard]] double getRangeRadius() const override { return 2 * this->circumsphereRadius; }
+
+    /**
+     * @brief Returns the semi-axes along x, y and z axes.
+     */
+    [[nodiscard]] const Vector<3> &getSemiAxes() const { return this->semiAxes; }
+};
+
+
+#endif //RAMPACK_ELLIPSOIDTRAITS_H
@@ -7,31 +7,53 @@
 
 #include <optional>
 #include <map>
+#include <vector>
 
 #include "XenoCollideTraits.h"
 #include "geometry/xenocollide/AbstractXCGeometry.h"
+#include "geometry/xenocollide/XCSupportProgram.h"
 
 
 /**
  * @brief XenoCollideTraits using AbstractXCGeometry as @a CollideGeometry.
  * @details It is an adapter class, which enables one to used some implementation of AbstractXCGeometry, for example
- * coming from XCBodyBuilder.
+ * coming from XCBodyBuilder. The geometry is compiled to XCSupportProgram, so that support points of composite
+ * geometries are evaluated without virtual calls. If the geometry is centered elsewhere than in the origin (see
+ * XCSupportProgram::fitBoundingSpheres), it is placed in a single interaction centre.
  */
 class GenericXenoCollideTraits : public XenoCollideTraits<GenericXenoCollideTraits> {
 private:
-    std::shared_ptr<AbstractXCGeometry> geometry;
+    XCSupportProgram geometry;
+    std::vector<Vector<3>> interactionCentres;
 
 public:
+    /**
+     * @brief Creates the traits for a given compiled @a geometry. If @a geometryCenter is non-zero, the geometry is
+     * placed in the interaction centre @a geometryCenter instead of the origin.
+     * @details The rest of arguments are as in XenoCollideTraits::XenoCollideTraits.
+     */
+    GenericXenoCollideTraits(XCSupportProgram geometry, OptionalAxis primaryAxis, OptionalAxis secondaryAxis,
+                             const Vector<3> &geometricOrigin, double volume,
+                             const ShapeGeometry::NamedPoints &namedPoints, const Vector<3> &geometryCenter = {})
+            : XenoCollideTraits(primaryAxis, secondaryAxis, geometricOrigin, volume, namedPoints),
+              geometry{std::move(geometry)}
+    {
+        if (geometryCenter != Vector<3>{})
+            this->interactionCentres.push_back(geometryCenter);
+    }
+
     GenericXenoCollideTraits(std::shared_ptr<AbstractXCGeometry> geometry, OptionalAxis primaryAxis,
                              OptionalAxis secondaryAxis, const Vector<3> &geometricOrigin, double volume,
                              const ShapeGeometry::NamedPoints &namedPoints)
-            : XenoCollideTraits(primaryAxis, secondaryAxis, geometricOrigin, volume, namedPoints),
-              geometry{std::move(geometry)}
+            : GenericXenoCollideTraits(XCSupportProgram(std::move(geometry)), primaryAxis, secondaryAxis,
+                                       geometricOrigin, volume, namedPoints)
     { }
 
-    [[nodiscard]] const AbstractXCGeometry &getCollideGeometry([[maybe_unused]] std::size_t i = 0) const {
-        return *this->geometry;
+    [[nodiscard]] const XCSupportProgram &getCollideGeometry([[maybe_unused]] std::size_t i = 0) const {
+        return this->geometry;
     }
+
+    [[nodiscard]] std::vector<Vector<3>> getInteractionCentres() const override { return this->interactionCentres; }
 };
 
 
@@ -0,0 +1,37 @@
+#ifndef RAMPACK_MOLECULESHAPETRAITS_H
+#define RAMPACK_MOLECULESHAPETRAITS_H
+
+#include <memory>
+
+#include "core/ShapeTraits.h"
+#include "core/interactions/MoleculeInteraction.h"
+
+
+/**
+ * @brief ShapeTraits wrapper, which replaces the multi-centre interaction of the wrapped ShapeTraits with
+ * MoleculeInteraction, so that the neighbour grid bins whole molecules instead of individual interaction centres.
+ * @details Geometry and printers are taken from the wrapped ShapeTraits.
+ */
+class MoleculeShapeTraits : public ShapeTraits {
+private:
+    std::shared_ptr<ShapeTraits> shapeTraits;
+    MoleculeInteraction moleculeInteraction;
+
+public:
+    /**
+     * @brief Wraps @a shapeTraits, whose interaction has to have at least one interaction centre.
+     */
+    explicit MoleculeShapeTraits(const std::shared_ptr<ShapeTraits> &shapeTraits)
+            : shapeTraits{shapeTraits}, moleculeInteraction(shapeTraits->getInteraction())
+    { }
+
+    [[nodiscard]] const Interaction &getInteraction() const override { return this->moleculeInteraction; }
+    [[nodiscard]] const ShapeGeometry &getGeometry() const override { return this->shapeTraits->getGeometry(); }
+    [[nodiscard]] std::shared_ptr<const ShapePrinter>
+    getPrinter(const std::string &format, const std::map<std::string, std::string> &params) const override {
+        return this->shapeTraits->getPrinter(format, params);
+    }
+};
+
+
+#endif //RAMPACK_MOLECULESHAPETRAITS_H
@@ -75,4 +75,5 @@ PolyhedralWedgeTraits::CollideGeometry::CollideGeometry(double axBottom, double
     double irUp = std::min(axTop, ayTop);
     double irDown = std::min(axBottom, ayBottom);
     this->insphereRadius = std::min(std::min(irUp, irDown), length) / 2;
+    this->boundingBox = XCBoundingBox::forGeometry(*this);
 }
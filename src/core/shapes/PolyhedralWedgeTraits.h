@@ -6,6 +6,7 @@
 #define RAMPACK_POLYHEDRALWEDGETRAITS_H
 
 #include "XenoCollideTraits.h"
+#include "geometry/xenocollide/XCBoundingBox.h"
 
 
 /**
@@ -22,6 +23,7 @@ public:
         Vector<3> vertexDown;
         double circumsphereRadius{};
         double insphereRadius{};
+        XCBoundingBox boundingBox;
 
         friend PolyhedralWedgeTraits;
 
@@ -58,6 +60,7 @@ public:
 
         [[nodiscard]] double getCircumsphereRadius() const { return this->circumsphereRadius; }
         [[nodiscard]] double getInsphereRadius() const { return this->insphereRadius; }
+        [[nodiscard]] const XCBoundingBox &getBoundingBox() const { return this->boundingBox; }
     };
 
 private:
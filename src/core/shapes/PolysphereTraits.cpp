@@ -94,17 +94,6 @@ Vector<3> PolysphereTraits::SphereData::centreForShape(const Shape &shape) const
     return shape.getPosition() + shape.getOrientation() * this->position;
 }
 
-bool PolysphereTraits::HardInteraction::overlapBetween(const Vector<3> &pos1,
-                                                       [[maybe_unused]] const Matrix<3, 3> &orientation1,
-                                                       std::size_t idx1,
-                                                       const Vector<3> &pos2,
-                                                       [[maybe_unused]] const Matrix<3, 3> &orientation2,
-                                                       std::size_t idx2, const BoundaryConditions &bc) const
-{
-    double r = this->sphereData[idx1].radius + this->sphereData[idx2].radius;
-    return bc.getDistance2(pos1, pos2) < r * r;
-}
-
 std::vector<Vector<3>> PolysphereTraits::HardInteraction::getInteractionCentres() const {
     std::vector<Vector<3>> centres;
     centres.reserve(this->sphereData.size());
@@ -120,10 +109,22 @@ double PolysphereTraits::HardInteraction::getRangeRadius() const {
     return 2 * std::max_element(this->sphereData.begin(), this->sphereData.end(), comparator)->radius;
 }
 
+std::vector<double> PolysphereTraits::HardInteraction::getInteractionCentreRanges() const {
+    std::vector<double> ranges;
+    ranges.reserve(this->sphereData.size());
+    for (const auto &data : this->sphereData)
+        ranges.push_back(data.radius);
+    return ranges;
+}
+
 PolysphereTraits::HardInteraction::HardInteraction(std::vector<SphereData> sphereData)
         : sphereData{std::move(sphereData)}
 {
     Expects(!this->sphereData.empty());
+
+    this->radii.reserve(this->sphereData.size());
+    for (const auto &data : this->sphereData)
+        this->radii.push_back(data.radius);
 }
 
 bool PolysphereTraits::HardInteraction::overlapWithWall(const Vector<3> &pos,
@@ -6,6 +6,7 @@
 #define RAMPACK_POLYSPHERETRAITS_H
 
 #include <utility>
+#include <algorithm>
 #include <ostream>
 #include <map>
 #include <optional>
@@ -119,10 +120,14 @@ public:
         [[nodiscard]] bool spheresOverlap() const;
     };
 
-private:
-    class HardInteraction : public Interaction {
+    /**
+     * @brief Hard-core interaction of polyspheres. The pair test is final and defined inline, so that Packing can call
+     * it directly (see visit_devirtualised_interaction).
+     */
+    class HardInteraction final : public Interaction {
     private:
         std::vector<SphereData> sphereData;
+        std::vector<double> radii;
 
     public:
         explicit HardInteraction(std::vector<SphereData> sphereData);
@@ -131,17 +136,49 @@ private:
         [[nodiscard]] bool hasSoftPart() const override { return false; }
         [[nodiscard]] bool hasWallPart() const override { return true; }
         [[nodiscard]] bool isConvex() const override { return false; }
-        [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1, std::size_t idx1,
-                                          const Vector<3> &pos2, const Matrix<3, 3> &orientation2, std::size_t idx2,
-                                          const BoundaryConditions &bc) const override;
+        [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, [[maybe_unused]] const Matrix<3, 3> &orientation1,
+                                          std::size_t idx1, const Vector<3> &pos2,
+                                          [[maybe_unused]] const Matrix<3, 3> &orientation2, std::size_t idx2,
+                                          const BoundaryConditions &bc) const final
+        {
+            double r = this->sphereData[idx1].radius + this->sphereData[idx2].radius;
+            return bc.getDistance2(pos1, pos2) < r * r;
+        }
+
+        [[nodiscard]] std::size_t countOverlapsInBatch([[maybe_unused]] const Vector<3> &pos1,
+                                                       [[maybe_unused]] const Matrix<3, 3> &orientation1,
+                                                       std::size_t idx1, const InteractionBatch &batch,
+                                                       bool earlyExit) const final
+        {
+            double radius1 = this->radii[idx1];
+            const double *radii2 = this->radii.data();
+            const double *distances2 = batch.getDistances2();
+            const std::size_t *centres = batch.getCentres();
+            std::size_t batchSize = batch.size();
+            std::size_t overlapsCounted{};
+            // Branchless count over the whole batch (with radii gathered by centre indices), so that the loop is
+            // vectorised
+            #pragma omp simd reduction(+ : overlapsCounted)
+            for (std::size_t i = 0; i < batchSize; i++) {
+                double r = radius1 + radii2[centres[i]];
+                overlapsCounted += (distances2[i] < r*r);
+            }
+            return earlyExit ? std::min(overlapsCounted, std::size_t{1}) : overlapsCounted;
+        }
+
+        [[nodiscard]] bool needsBatchOrientations() const final { return false; }
+
         [[nodiscard]] bool overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation, std::size_t idx,
                                            const Vector<3> &wallOrigin, const Vector<3> &wallVector) const override;
 
         [[nodiscard]] std::vector<Vector<3>> getInteractionCentres() const override;
 
         [[nodiscard]] double getRangeRadius() const override;
+        [[nodiscard]] std::vector<double> getInteractionCentreRanges() const override;
     };
 
+private:
+
     class WolframPrinter : public ShapePrinter {
     private:
         const PolysphereTraits &traits;
@@ -106,31 +106,6 @@ Vector<3> PolyspherocylinderTraits::SpherocylinderData::halfAxisForShape(const S
     return shape.getOrientation() * this->halfAxis;
 }
 
-bool PolyspherocylinderTraits::overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1, std::size_t idx1,
-                                              const Vector<3> &pos2, const Matrix<3, 3> &orientation2, std::size_t idx2,
-                                              const BoundaryConditions &bc) const
-{
-    const auto &spherocylinderData = this->getSpherocylinderData();
-    const auto &data1 = spherocylinderData[idx1];
-    const auto &data2 = spherocylinderData[idx2];
-
-    Vector<3> pos2bc = pos2 + bc.getTranslation(pos1, pos2);
-    double distance2 = (pos2bc - pos1).norm2();
-    double insphereR = data1.radius + data2.radius;
-    double insphereR2 = insphereR * insphereR;
-    if (distance2 < insphereR2)
-        return true;
-    double circumsphereR = data1.circumsphereRadius + data2.circumsphereRadius;
-    double circumsphereR2 = circumsphereR * circumsphereR;
-    if (distance2 >= circumsphereR2)
-        return false;
-
-    Vector<3> halfAxis1 = orientation1 * data1.halfAxis;
-    Vector<3> halfAxis2 = orientation2 * data2.halfAxis;
-    return SegmentDistanceCalculator::calculate(pos1+halfAxis1, pos1-halfAxis1, pos2bc+halfAxis2, pos2bc-halfAxis2)
-           < insphereR2;
-}
-
 std::vector<Vector<3>> PolyspherocylinderTraits::getInteractionCentres() const {
     std::vector<Vector<3>> centres;
     const auto &spherocylinderData = this->getSpherocylinderData();
@@ -149,6 +124,15 @@ double PolyspherocylinderTraits::getRangeRadius() const {
     return 2 * maxIt->circumsphereRadius;
 }
 
+std::vector<double> PolyspherocylinderTraits::getInteractionCentreRanges() const {
+    const auto &spherocylinderData = this->getSpherocylinderData();
+    std::vector<double> ranges;
+    ranges.reserve(spherocylinderData.size());
+    for (const auto &data : spherocylinderData)
+        ranges.push_back(data.circumsphereRadius);
+    return ranges;
+}
+
 bool PolyspherocylinderTraits::overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation, std::size_t idx,
                                                const Vector<3> &wallOrigin, const Vector<3> &wallVector) const
 {
@@ -8,8 +8,10 @@
 
 #include <ostream>
 #include <map>
+#include <algorithm>
 
 #include "core/ShapeTraits.h"
+#include "geometry/SegmentDistanceCalculator.h"
 #include "geometry/xenocollide/AbstractXCGeometry.h"
 #include "OptionalAxis.h"
 
@@ -155,14 +157,101 @@ public:
     [[nodiscard]] bool hasSoftPart() const override { return false; }
     [[nodiscard]] bool hasWallPart() const override { return true; }
     [[nodiscard]] bool isConvex() const override { return false; }
+
+    /**
+     * @brief Overlap test of two spherocylinders of molecules. It is final and defined inline, so that Packing can
+     * call it directly (see visit_devirtualised_interaction).
+     */
     [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1, std::size_t idx1,
                                       const Vector<3> &pos2, const Matrix<3, 3> &orientation2, std::size_t idx2,
-                                      const BoundaryConditions &bc) const override;
+                                      const BoundaryConditions &bc) const final
+    {
+        const auto &spherocylinderData = this->getSpherocylinderData();
+        const auto &data1 = spherocylinderData[idx1];
+        const auto &data2 = spherocylinderData[idx2];
+
+        Vector<3> pos2bc = pos2 + bc.getTranslation(pos1, pos2);
+        double distance2 = (pos2bc - pos1).norm2();
+        double insphereR = data1.radius + data2.radius;
+        double insphereR2 = insphereR * insphereR;
+        if (distance2 < insphereR2)
+            return true;
+        double circumsphereR = data1.circumsphereRadius + data2.circumsphereRadius;
+        double circumsphereR2 = circumsphereR * circumsphereR;
+        if (distance2 >= circumsphereR2)
+            return false;
+
+        Vector<3> halfAxis1 = orientation1 * data1.halfAxis;
+        Vector<3> halfAxis2 = orientation2 * data2.halfAxis;
+        return SegmentDistanceCalculator::calculate(pos1+halfAxis1, pos1-halfAxis1, pos2bc+halfAxis2,
+                                                    pos2bc-halfAxis2)
+               < insphereR2;
+    }
+
+    /**
+     * @brief Batched version of PolyspherocylinderTraits::overlapBetween.
+     * @details The segment of the first spherocylinder is computed once for the whole batch. Then the segment distance
+     * is calculated for all entries without branches (with spherocylinder data gathered by centre indices), so the
+     * loop is vectorised.
+     */
+    [[nodiscard]] std::size_t countOverlapsInBatch(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                                   std::size_t idx1, const InteractionBatch &batch,
+                                                   bool earlyExit) const final
+    {
+        const SpherocylinderData *spherocylinderData = this->getSpherocylinderData().data();
+        const auto &data1 = spherocylinderData[idx1];
+        Vector<3> halfAxis1 = orientation1 * data1.halfAxis;
+        Vector<3> beg1 = pos1 + halfAxis1;
+        Vector<3> u = (pos1 - halfAxis1) - beg1;
+        double ux = u[0], uy = u[1], uz = u[2];
+        double beg1x = beg1[0], beg1y = beg1[1], beg1z = beg1[2];
+
+        const double *x = batch.getX();
+        const double *y = batch.getY();
+        const double *z = batch.getZ();
+        const double *distances2 = batch.getDistances2();
+        const std::size_t *centres = batch.getCentres();
+        const Matrix<3, 3> *orientations = batch.getOrientations();
+        std::size_t batchSize = batch.size();
+        std::size_t overlapsCounted{};
+        #pragma omp simd reduction(+ : overlapsCounted)
+        for (std::size_t i = 0; i < batchSize; i++) {
+            const auto &data2 = spherocylinderData[centres[i]];
+            double insphereR = data1.radius + data2.radius;
+            double insphereR2 = insphereR * insphereR;
+            double circumsphereR = data1.circumsphereRadius + data2.circumsphereRadius;
+            double circumsphereR2 = circumsphereR * circumsphereR;
+
+            // Raw, row-major elements, since Matrix::operator() checks the bounds
+            const double *orientation2 = orientations[i].begin();
+            const double *halfAxis2 = data2.halfAxis.begin();
+            double hx = orientation2[0] * halfAxis2[0] + orientation2[1] * halfAxis2[1]
+                        + orientation2[2] * halfAxis2[2];
+            double hy = orientation2[3] * halfAxis2[0] + orientation2[4] * halfAxis2[1]
+                        + orientation2[5] * halfAxis2[2];
+            double hz = orientation2[6] * halfAxis2[0] + orientation2[7] * halfAxis2[1]
+                        + orientation2[8] * halfAxis2[2];
+            double beg2x = x[i] + hx;
+            double beg2y = y[i] + hy;
+            double beg2z = z[i] + hz;
+            double segmentDistance2 = SegmentDistanceCalculator::calculateBranchless(
+                ux, uy, uz,
+                (x[i] - hx) - beg2x, (y[i] - hy) - beg2y, (z[i] - hz) - beg2z,
+                beg1x - beg2x, beg1y - beg2y, beg1z - beg2z
+            );
+            // Non-short-circuit operators keep the loop body free of branches
+            overlapsCounted += ((distances2[i] < insphereR2)
+                                | ((distances2[i] < circumsphereR2) & (segmentDistance2 < insphereR2)));
+        }
+        return earlyExit ? std::min(overlapsCounted, std::size_t{1}) : overlapsCounted;
+    }
+
     [[nodiscard]] bool overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation, std::size_t idx,
                                        const Vector<3> &wallOrigin, const Vector<3> &wallVector) const override;
 
     [[nodiscard]] std::vector<Vector<3>> getInteractionCentres() const override;
     [[nodiscard]] double getRangeRadius() const override;
+    [[nodiscard]] std::vector<double> getInteractionCentreRanges() const override;
 
     [[nodiscard]] const Interaction &getInteraction() const override { return *this; }
     [[nodiscard]] const ShapeGeometry &getGeometry() const override { return this->geometry; }
@@ -103,4 +103,6 @@ SmoothWedgeTraits::CollideGeometry::CollideGeometry(double R, double r, double l
     Expects(R > 0);
     Expects(r > 0);
     Expects(l > 0);
+
+    this->boundingBox = XCBoundingBox::forGeometry(*this);
 }
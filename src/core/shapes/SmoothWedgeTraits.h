@@ -6,6 +6,7 @@
 #define RAMPACK_SMOOTHWEDGETRAITS_H
 
 #include "XenoCollideTraits.h"
+#include "geometry/xenocollide/XCBoundingBox.h"
 
 
 /**
@@ -26,6 +27,7 @@ public:
         double rpos{};
         double circumsphereRadius{};
         double insphereRadius{};
+        XCBoundingBox boundingBox;
 
         friend SmoothWedgeTraits;
 
@@ -51,6 +53,7 @@ public:
 
         [[nodiscard]] double getCircumsphereRadius() const { return this->circumsphereRadius; }
         [[nodiscard]] double getInsphereRadius() const { return this->insphereRadius; }
+        [[nodiscard]] const XCBoundingBox &getBoundingBox() const { return this->boundingBox; }
     };
 
 private:
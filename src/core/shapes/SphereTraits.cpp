@@ -53,17 +53,6 @@ std::shared_ptr<ShapePrinter> SphereTraits::createObjPrinter(double radius, std:
     return std::make_unique<XCObjShapePrinter>(XCSphere{radius}, subdivisions);
 }
 
-bool SphereTraits::HardInteraction::overlapBetween(const Vector<3> &pos1,
-                                                   [[maybe_unused]] const Matrix<3, 3> &orientation1,
-                                                   [[maybe_unused]] std::size_t idx1,
-                                                   const Vector<3> &pos2,
-                                                   [[maybe_unused]] const Matrix<3, 3> &orientation2,
-                                                   [[maybe_unused]] std::size_t idx2,
-                                                   const BoundaryConditions &bc) const
-{
-    return bc.getDistance2(pos1, pos2) < std::pow(2 * this->radius, 2);
-}
-
 bool SphereTraits::HardInteraction::overlapWithWall(const Vector<3> &pos,
                                                     [[maybe_unused]] const Matrix<3, 3> &orientation,
                                                     [[maybe_unused]] std::size_t idx,
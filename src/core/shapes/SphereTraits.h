@@ -6,6 +6,7 @@
 #define RAMPACK_SPHERETRAITS_H
 
 #include <variant>
+#include <algorithm>
 
 #include "core/ShapeTraits.h"
 #include "core/interactions/CentralInteraction.h"
@@ -14,8 +15,12 @@
  * @brief Spherical molecules with hard of soft interactions.
  */
 class SphereTraits : public ShapeTraits, public ShapeGeometry {
-private:
-    class HardInteraction : public Interaction {
+public:
+    /**
+     * @brief Hard-core interaction of spheres. The pair test is final and defined inline, so that Packing can call it
+     * directly (see visit_devirtualised_interaction).
+     */
+    class HardInteraction final : public Interaction {
     private:
         double radius{};
 
@@ -26,14 +31,41 @@ private:
         [[nodiscard]] bool hasSoftPart() const override { return false; }
         [[nodiscard]] bool hasWallPart() const override { return true; }
         [[nodiscard]] bool isConvex() const override { return true; }
-        [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1, std::size_t idx1,
-                                          const Vector<3> &pos2, const Matrix<3, 3> &orientation2, std::size_t idx2,
-                                          const BoundaryConditions &bc) const override;
+        [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, [[maybe_unused]] const Matrix<3, 3> &orientation1,
+                                          [[maybe_unused]] std::size_t idx1, const Vector<3> &pos2,
+                                          [[maybe_unused]] const Matrix<3, 3> &orientation2,
+                                          [[maybe_unused]] std::size_t idx2, const BoundaryConditions &bc) const final
+        {
+            double diameter = 2 * this->radius;
+            return bc.getDistance2(pos1, pos2) < diameter * diameter;
+        }
+
+        [[nodiscard]] std::size_t countOverlapsInBatch([[maybe_unused]] const Vector<3> &pos1,
+                                                       [[maybe_unused]] const Matrix<3, 3> &orientation1,
+                                                       [[maybe_unused]] std::size_t idx1,
+                                                       const InteractionBatch &batch, bool earlyExit) const final
+        {
+            double diameter = 2 * this->radius;
+            double diameter2 = diameter * diameter;
+            const double *distances2 = batch.getDistances2();
+            std::size_t batchSize = batch.size();
+            std::size_t overlapsCounted{};
+            // Branchless count over the whole batch, so that the loop is vectorised
+            #pragma omp simd reduction(+ : overlapsCounted)
+            for (std::size_t i = 0; i < batchSize; i++)
+                overlapsCounted += (distances2[i] < diameter2);
+            return earlyExit ? std::min(overlapsCounted, std::size_t{1}) : overlapsCounted;
+        }
+
+        [[nodiscard]] bool needsBatchOrientations() const final { return false; }
+
         [[nodiscard]] bool overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation, std::size_t idx,
                                            const Vector<3> &wallOrigin, const Vector<3> &wallVector) const override;
         [[nodiscard]] double getRangeRadius() const override { return 2 * this->radius; }
     };
 
+private:
+
     class WolframPrinter : public ShapePrinter {
     private:
         double radius{};
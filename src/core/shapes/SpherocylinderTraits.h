@@ -5,7 +5,10 @@
 #ifndef RAMPACK_SPHEROCYLINDERTRAITS_H
 #define RAMPACK_SPHEROCYLINDERTRAITS_H
 
+#include <algorithm>
+
 #include "core/ShapeTraits.h"
+#include "geometry/SegmentDistanceCalculator.h"
 
 /**
  * @brief Hard spherocylinder spanned on Z axis.
@@ -71,9 +74,80 @@ public:
     [[nodiscard]] bool hasWallPart() const override { return true; }
     [[nodiscard]] bool hasSoftPart() const override { return false; }
     [[nodiscard]] bool isConvex() const override { return true; }
-    [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1, std::size_t idx1,
-                                      const Vector<3> &pos2, const Matrix<3, 3> &orientation2, std::size_t idx2,
-                                      const BoundaryConditions &bc) const override;
+
+    /**
+     * @brief Overlap test of two spherocylinders. It is final and defined inline, so that Packing can call it directly
+     * (see visit_devirtualised_interaction).
+     */
+    [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                      [[maybe_unused]] std::size_t idx1, const Vector<3> &pos2,
+                                      const Matrix<3, 3> &orientation2, [[maybe_unused]] std::size_t idx2,
+                                      const BoundaryConditions &bc) const final
+    {
+        Vector<3> pos2bc = pos2 + bc.getTranslation(pos1, pos2);
+        double distance2 = (pos2bc - pos1).norm2();
+        double diameter2 = 4 * this->radius * this->radius;
+        if (distance2 < diameter2)
+            return true;
+        double rangeRadius = 2 * this->radius + this->length;
+        if (distance2 >= rangeRadius * rangeRadius)
+            return false;
+
+        Vector<3> halfAxis1 = orientation1.column(2) * (0.5 * this->length);
+        Vector<3> halfAxis2 = orientation2.column(2) * (0.5 * this->length);
+        return SegmentDistanceCalculator::calculate(pos1 - halfAxis1, pos1 + halfAxis1, pos2bc - halfAxis2,
+                                                    pos2bc + halfAxis2)
+               < diameter2;
+    }
+
+    /**
+     * @brief Batched version of SpherocylinderTraits::overlapBetween.
+     * @details The segment of the first spherocylinder is computed once for the whole batch. Then the segment distance
+     * is calculated for all entries without branches, so the loop is vectorised.
+     */
+    [[nodiscard]] std::size_t countOverlapsInBatch(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                                   [[maybe_unused]] std::size_t idx1, const InteractionBatch &batch,
+                                                   bool earlyExit) const final
+    {
+        double halfLength = 0.5 * this->length;
+        double diameter2 = 4 * this->radius * this->radius;
+        double rangeRadius = 2 * this->radius + this->length;
+        double rangeRadius2 = rangeRadius * rangeRadius;
+
+        Vector<3> halfAxis1 = orientation1.column(2) * halfLength;
+        Vector<3> beg1 = pos1 - halfAxis1;
+        Vector<3> u = (pos1 + halfAxis1) - beg1;
+        double ux = u[0], uy = u[1], uz = u[2];
+        double beg1x = beg1[0], beg1y = beg1[1], beg1z = beg1[2];
+
+        const double *x = batch.getX();
+        const double *y = batch.getY();
+        const double *z = batch.getZ();
+        const double *distances2 = batch.getDistances2();
+        const Matrix<3, 3> *orientations = batch.getOrientations();
+        std::size_t batchSize = batch.size();
+        std::size_t overlapsCounted{};
+        #pragma omp simd reduction(+ : overlapsCounted)
+        for (std::size_t i = 0; i < batchSize; i++) {
+            // Raw, row-major elements, since Matrix::operator() checks the bounds
+            const double *orientation2 = orientations[i].begin();
+            double hx = orientation2[2] * halfLength;
+            double hy = orientation2[5] * halfLength;
+            double hz = orientation2[8] * halfLength;
+            double beg2x = x[i] - hx;
+            double beg2y = y[i] - hy;
+            double beg2z = z[i] - hz;
+            double segmentDistance2 = SegmentDistanceCalculator::calculateBranchless(
+                ux, uy, uz,
+                (x[i] + hx) - beg2x, (y[i] + hy) - beg2y, (z[i] + hz) - beg2z,
+                beg1x - beg2x, beg1y - beg2y, beg1z - beg2z
+            );
+            // Non-short-circuit operators keep the loop body free of branches
+            overlapsCounted += ((distances2[i] < diameter2)
+                                | ((distances2[i] < rangeRadius2) & (segmentDistance2 < diameter2)));
+        }
+        return earlyExit ? std::min(overlapsCounted, std::size_t{1}) : overlapsCounted;
+    }
 
     [[nodiscard]] bool overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation, std::size_t idx,
                                        const Vector<3> &wallOrigin, const Vector<3> &wallVector) const override;
@@ -0,0 +1,45 @@
+#ifndef RAMPACK_XCNARROWPHASESELECTOR_H
+#define RAMPACK_XCNARROWPHASESELECTOR_H
+
+#include <string>
+
+
+/**
+ * @brief Algorithm used by XenoCollideTraits for pairs of shapes not resolved by the bounding volumes.
+ */
+enum class XCNarrowPhase {
+    /** @brief Minkowski Portal Refinement (XenoCollide) */
+    MPR,
+    /** @brief Gilbert-Johnson-Keerthi algorithm (GJK) */
+    GJK
+};
+
+
+/**
+ * @brief Non-template base of XenoCollideTraits storing the selected XCNarrowPhase, so that the selection can be
+ * inspected without knowing the concrete XenoCollideTraits type.
+ */
+class XCNarrowPhaseSelector {
+protected:
+    XCNarrowPhase narrowPhase = XCNarrowPhase::MPR;
+
+    ~XCNarrowPhaseSelector() = default;
+
+public:
+    /**
+     * @brief Selects the algorithm used for pairs of shapes not resolved by the bounding volumes.
+     */
+    void setNarrowPhase(XCNarrowPhase narrowPhase_) { this->narrowPhase = narrowPhase_; }
+
+    [[nodiscard]] XCNarrowPhase getNarrowPhase() const { return this->narrowPhase; }
+
+    /**
+     * @brief Returns the name of the selected algorithm, as used in the input file (@a mpr or @a gjk).
+     */
+    [[nodiscard]] std::string getNarrowPhaseName() const {
+        return this->narrowPhase == XCNarrowPhase::GJK ? "gjk" : "mpr";
+    }
+};
+
+
+#endif //RAMPACK_XCNARROWPHASESELECTOR_H
@@ -5,19 +5,27 @@
 #ifndef RAMPACK_XENOCOLLIDETRAITS_H
 #define RAMPACK_XENOCOLLIDETRAITS_H
 
+#include <cmath>
 #include <map>
+#include <random>
 #include <utility>
 #include <sstream>
+#include <limits>
 #include <optional>
+#include <type_traits>
+#include <vector>
 
 #include "core/ShapeTraits.h"
 #include "geometry/xenocollide/AbstractXCGeometry.h"
 #include "geometry/xenocollide/XenoCollide.h"
+#include "geometry/xenocollide/XCBoundingBox.h"
+#include "geometry/xenocollide/GJK.h"
 #include "XCWolframShapePrinter.h"
 #include "XCObjShapePrinter.h"
 #include "geometry/Polyhedron.h"
 #include "utils/Exceptions.h"
 #include "OptionalAxis.h"
+#include "XCNarrowPhaseSelector.h"
 
 
 /**
@@ -42,9 +50,18 @@
  * // should be ignored, but signature must not be altered
  * const CollideGeometry &ConcreteCollideTraits::getCollideGeometry(std::size_t idx) const
  * @endcode
+ * If @a CollideGeometry additionally has a method
+ * @code
+ * const XCBoundingBox &CollideGeometry::getBoundingBox() const
+ * @endcode
+ * the bounding boxes are tested (see XCBoundingBox::areSeparated) for pairs not resolved by circumsphere and insphere
+ * radii, before XenoCollide is run. By default, the final test is done using XenoCollide (MPR), but GJK can be selected
+ * instead - manually (see XCNarrowPhaseSelector::setNarrowPhase) or based on the cost on random pairs (see
+ * XenoCollideTraits::calibrateNarrowPhase). MPR reports shapes overlapping by less than its boundary tolerance as
+ * separated, while GJK does not have such a tolerance, so the two may disagree for nearly touching shapes.
  */
 template<typename ConcreteCollideTraits>
-class XenoCollideTraits : public ShapeTraits, public Interaction, public ShapeGeometry {
+class XenoCollideTraits : public ShapeTraits, public Interaction, public ShapeGeometry, public XCNarrowPhaseSelector {
 private:
     std::optional<Vector<3>> primaryAxis;
     std::optional<Vector<3>> secondaryAxis;
@@ -53,6 +70,61 @@ private:
 
     mutable std::optional<double> rangeRadius;
 
+    // CollideGeometry wrapper counting the evaluations of support points - a cost measure of narrow phase algorithms,
+    // which, contrary to timings, is deterministic
+    template<typename CollideGeometry>
+    class SupportCountingGeometry {
+    private:
+        const CollideGeometry &geometry;
+        std::size_t &numSupportPoints;
+
+    public:
+        SupportCountingGeometry(const CollideGeometry &geometry, std::size_t &numSupportPoints)
+                : geometry{geometry}, numSupportPoints{numSupportPoints}
+        { }
+
+        [[nodiscard]] Vector<3> getSupportPoint(const Vector<3> &n) const {
+            this->numSupportPoints++;
+            return this->geometry.getSupportPoint(n);
+        }
+
+        [[nodiscard]] Vector<3> getCenter() const { return this->geometry.getCenter(); }
+    };
+
+    template<typename CollideGeometry, typename = void>
+    struct HasBoundingBox : std::false_type { };
+
+    template<typename CollideGeometry>
+    struct HasBoundingBox<CollideGeometry, std::void_t<decltype(std::declval<CollideGeometry>().getBoundingBox())>>
+            : std::true_type { };
+
+    template<typename CollideGeometry>
+    static bool areBoundingBoxesSeparated(const CollideGeometry &geometry1, const Matrix<3, 3> &orientation1,
+                                          const Vector<3> &pos1, const CollideGeometry &geometry2,
+                                          const Matrix<3, 3> &orientation2, const Vector<3> &pos2)
+    {
+        if constexpr (HasBoundingBox<const CollideGeometry &>::value) {
+            return XCBoundingBox::areSeparated(geometry1.getBoundingBox(), orientation1, pos1,
+                                               geometry2.getBoundingBox(), orientation2, pos2);
+        } else {
+            return false;
+        }
+    }
+
+    template<typename CollideGeometry>
+    bool intersect(XCNarrowPhase algorithm, const CollideGeometry &geometry1, const Matrix<3, 3> &orientation1,
+                   const Vector<3> &pos1, const CollideGeometry &geometry2, const Matrix<3, 3> &orientation2,
+                   const Vector<3> &pos2, Vector<3> *separatingDirection = nullptr) const
+    {
+        if (algorithm == XCNarrowPhase::GJK) {
+            return GJK<CollideGeometry>::Intersect(geometry1, orientation1, pos1, geometry2, orientation2, pos2,
+                                                   1.0e-12, separatingDirection);
+        } else {
+            return XenoCollide<CollideGeometry>::Intersect(geometry1, orientation1, pos1, geometry2, orientation2,
+                                                           pos2, 1.0e-12, separatingDirection);
+        }
+    }
+
     template<typename Printer>
     std::shared_ptr<Printer> createPrinter(std::size_t meshSubdivisions) const {
         auto centers = this->getInteractionCentres();
@@ -147,6 +219,39 @@ public:
     [[nodiscard]] bool overlapBetween(const Vector<3> &pos1, const Matrix<3, 3> &orientation1, std::size_t idx1,
                                       const Vector<3> &pos2, const Matrix<3, 3> &orientation2, std::size_t idx2,
                                       const BoundaryConditions &bc) const override
+    {
+        const auto &thisConcreteTraits = static_cast<const ConcreteCollideTraits &>(*this);
+        const auto &collideGeometry1 = thisConcreteTraits.getCollideGeometry(idx1);
+        const auto &collideGeometry2 = thisConcreteTraits.getCollideGeometry(idx2);
+        double rCircumsphere = collideGeometry1.getCircumsphereRadius() + collideGeometry2.getCircumsphereRadius();
+        double rInsphere = collideGeometry1.getInsphereRadius() + collideGeometry2.getInsphereRadius();
+
+        Vector<3> pos2bc = pos2 + bc.getTranslation(pos1, pos2);
+        double dist2 = (pos2bc - pos1).norm2();
+        if (dist2 > rCircumsphere*rCircumsphere)
+            return false;
+        if (dist2 < rInsphere*rInsphere)
+            return true;
+        if (XenoCollideTraits::areBoundingBoxesSeparated(collideGeometry1, orientation1, pos1,
+                                                         collideGeometry2, orientation2, pos2bc))
+        {
+            return false;
+        }
+
+        return this->intersect(this->narrowPhase, collideGeometry1, orientation1, pos1,
+                               collideGeometry2, orientation2, pos2bc);
+    }
+
+    /**
+     * @brief The same as XenoCollideTraits::overlapBetween, but the XenoCollide test is skipped if the shapes are
+     * still separated along @a separatingDirection. Otherwise, the separating direction found by XenoCollide (if
+     * any) is stored in @a separatingDirection.
+     */
+    [[nodiscard]] bool overlapBetweenWithHint(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                              std::size_t idx1, const Vector<3> &pos2,
+                                              const Matrix<3, 3> &orientation2, std::size_t idx2,
+                                              const BoundaryConditions &bc,
+                                              Vector<3> &separatingDirection) const override
     {
         const auto &thisConcreteTraits = static_cast<const ConcreteCollideTraits &>(*this);
         const auto &collideGeometry1 = thisConcreteTraits.getCollideGeometry(idx1);
@@ -161,10 +266,72 @@ public:
             return false;
         if (dist2 < rInsphere*rInsphere)
             return true;
+        if (XenoCollideTraits::areBoundingBoxesSeparated(collideGeometry1, orientation1, pos1,
+                                                         collideGeometry2, orientation2, pos2bc))
+        {
+            return false;
+        }
+
+        if (separatingDirection != Vector<3>{}
+            && XenoCollide<XCGeometry>::AreSeparatedAlong(collideGeometry1, orientation1, pos1,
+                                                          collideGeometry2, orientation2, pos2bc,
+                                                          separatingDirection))
+        {
+            return false;
+        }
+
+        return this->intersect(this->narrowPhase, collideGeometry1, orientation1, pos1,
+                               collideGeometry2, orientation2, pos2bc, &separatingDirection);
+    }
+
+    [[nodiscard]] bool usesSeparatingDirections() const override { return true; }
+
+    [[nodiscard]] std::size_t countOverlapsInBatch(const Vector<3> &pos1, const Matrix<3, 3> &orientation1,
+                                                   std::size_t idx1, const InteractionBatch &batch,
+                                                   bool earlyExit) const override
+    {
+        if (batch.empty() || !batch.hasCommonCentre())
+            return Interaction::countOverlapsInBatch(pos1, orientation1, idx1, batch, earlyExit);
+
+        const auto &thisConcreteTraits = static_cast<const ConcreteCollideTraits &>(*this);
+        const auto &collideGeometry1 = thisConcreteTraits.getCollideGeometry(idx1);
+        const auto &collideGeometry2 = thisConcreteTraits.getCollideGeometry(batch.getCentre(0));
+        double rCircumsphere = collideGeometry1.getCircumsphereRadius() + collideGeometry2.getCircumsphereRadius();
+        double rInsphere = collideGeometry1.getInsphereRadius() + collideGeometry2.getInsphereRadius();
+        double rCircumsphere2 = rCircumsphere * rCircumsphere;
+        double rInsphere2 = rInsphere * rInsphere;
+
+        // Vectorised prefilter - pairs with intersecting inspheres are counted before any XenoCollide test
+        const double *distances2 = batch.getDistances2();
+        std::size_t batchSize = batch.size();
+        std::size_t overlapsCounted{};
+        #pragma omp simd reduction(+ : overlapsCounted)
+        for (std::size_t i = 0; i < batchSize; i++)
+            overlapsCounted += (distances2[i] < rInsphere2);
+
+        if (earlyExit && overlapsCounted > 0)
+            return 1;
+
+        // XenoCollide is needed only between the insphere and circumsphere distances
+        for (std::size_t i{}; i < batchSize; i++) {
+            if (distances2[i] > rCircumsphere2 || distances2[i] < rInsphere2)
+                continue;
+            const auto &orientation2 = batch.getOrientation(i);
+            Vector<3> pos2 = batch.getPosition(i);
+            if (XenoCollideTraits::areBoundingBoxesSeparated(collideGeometry1, orientation1, pos1,
+                                                             collideGeometry2, orientation2, pos2))
+            {
+                continue;
+            }
 
-        return XenoCollide<XCGeometry>::Intersect(collideGeometry1, orientation1, pos1,
-                                                  collideGeometry2, orientation2, pos2bc,
-                                                  1.0e-12);
+            if (this->intersect(this->narrowPhase, collideGeometry1, orientation1, pos1,
+                                collideGeometry2, orientation2, pos2))
+            {
+                if (earlyExit) return 1;
+                overlapsCounted++;
+            }
+        }
+        return overlapsCounted;
     }
 
     [[nodiscard]] bool overlapWithWall(const Vector<3> &pos, const Matrix<3, 3> &orientation,
@@ -185,6 +352,69 @@ public:
         return true;
     }
 
+    /**
+     * @brief Selects the cheaper narrow phase algorithm (see XCNarrowPhaseSelector::setNarrowPhase) on random pairs of
+     * close shapes and returns the choice.
+     * @details @a numPairs pairs of the shapes of the first interaction center are generated with random orientations
+     * and distances between the sum of insphere and the sum of circumsphere radii. Pairs separated by the bounding
+     * boxes are skipped, since they never reach the narrow phase. Evaluations of support points dominate the cost, but
+     * a GJK iteration has a larger overhead, so GJK is selected only if it needs at least 10% fewer of them than MPR.
+     * Contrary to timings, it does not depend on the load of the machine, so the same shape always gets the same
+     * algorithm, also when a simulation is continued.
+     */
+    XCNarrowPhase calibrateNarrowPhase(std::size_t numPairs = 1000) {
+        const auto &thisConcreteTraits = static_cast<const ConcreteCollideTraits &>(*this);
+        const auto &collideGeometry = thisConcreteTraits.getCollideGeometry(0);
+        double rCircumsphere = 2 * collideGeometry.getCircumsphereRadius();
+        double rInsphere = 2 * collideGeometry.getInsphereRadius();
+
+        std::mt19937 mt(1234);
+        std::uniform_real_distribution<double> unitDistribution;
+        std::normal_distribution<double> normalDistribution;
+        auto randomOrientation = [&]() {
+            return Matrix<3, 3>::rotation(2*M_PI*unitDistribution(mt), 2*M_PI*unitDistribution(mt),
+                                          2*M_PI*unitDistribution(mt));
+        };
+
+        Vector<3> pos1;
+        std::vector<Matrix<3, 3>> orientations1, orientations2;
+        std::vector<Vector<3>> positions2;
+        for (std::size_t i{}; i < 100*numPairs && positions2.size() < numPairs; i++) {
+            Vector<3> direction{normalDistribution(mt), normalDistribution(mt), normalDistribution(mt)};
+            double distance = rInsphere + (rCircumsphere - rInsphere)*unitDistribution(mt);
+            Vector<3> pos2 = distance * direction.normalized();
+            auto orientation1 = randomOrientation();
+            auto orientation2 = randomOrientation();
+            if (XenoCollideTraits::areBoundingBoxesSeparated(collideGeometry, orientation1, pos1,
+                                                             collideGeometry, orientation2, pos2))
+            {
+                continue;
+            }
+
+            orientations1.push_back(orientation1);
+            orientations2.push_back(orientation2);
+            positions2.push_back(pos2);
+        }
+        if (positions2.empty())
+            return this->narrowPhase;
+
+        using CollideGeometry = std::decay_t<decltype(collideGeometry)>;
+        auto countSupportPoints = [&](XCNarrowPhase algorithm) {
+            std::size_t numSupportPoints{};
+            SupportCountingGeometry<CollideGeometry> countingGeometry(collideGeometry, numSupportPoints);
+            for (std::size_t i{}; i < positions2.size(); i++) {
+                this->intersect(algorithm, countingGeometry, orientations1[i], pos1, countingGeometry, orientations2[i],
+                                positions2[i]);
+            }
+            return numSupportPoints;
+        };
+
+        std::size_t mprSupportPoints = countSupportPoints(XCNarrowPhase::MPR);
+        std::size_t gjkSupportPoints = countSupportPoints(XCNarrowPhase::GJK);
+        this->narrowPhase = (10 * gjkSupportPoints < 9 * mprSupportPoints) ? XCNarrowPhase::GJK : XCNarrowPhase::MPR;
+        return this->narrowPhase;
+    }
+
     [[nodiscard]] double getRangeRadius() const override {
         if (this->rangeRadius.has_value())
             return *this->rangeRadius;
@@ -31,6 +31,12 @@ struct BaseParameters {
     std::size_t scalingThreads{};
     std::array<std::size_t, 3> domainDivisions{};
     bool saveOnSignal{};
+    double verletSkin{};
+    bool tuneNeighbourGrid{};
+    std::size_t neighbourGridCellSubdivisions = 1;
+    bool leanNeighbourGrid{};
+    bool separatingDirectionCache{};
+    bool moleculeNeighbourGrid{};
 };
 
 struct IntegrationRun {
@@ -42,6 +48,7 @@ struct IntegrationRun {
     std::size_t averagingEvery{};
     std::size_t inlineInfoEvery{};
     std::size_t orientationFixEvery{};
+    std::size_t particleReorderEvery{};
     std::vector<FileSnapshotWriter> lastSnapshotWriters;
     std::optional<std::string> ramsnapOut;
     std::vector<std::shared_ptr<SimulationRecorderFactory>> simulationRecorders;
@@ -58,6 +65,7 @@ struct OverlapRelaxationRun  {
     std::size_t snapshotEvery{};
     std::size_t inlineInfoEvery{};
     std::size_t orientationFixEvery{};
+    std::size_t particleReorderEvery{};
     std::shared_ptr<ShapeTraits> helperShapeTraits;
     std::vector<FileSnapshotWriter> lastSnapshotWriters;
     std::optional<std::string> ramsnapOut;
@@ -181,7 +181,7 @@ namespace {
         for (const auto &command : commands)
             builder.processCommand(command);
 
-        auto collideGeometry = builder.releaseCollideGeometry();
+        auto collideGeometry = builder.releaseSupportProgram();
         return std::make_shared<GenericXenoCollideTraits>(
             std::move(collideGeometry), primaryAxis, secondaryAxis, geometricOrigin, volume, namedPoints
         );
@@ -169,6 +169,7 @@ namespace {
                         {"averaging_every", nullableEvery, "0"},
                         {"inline_info_every", notNullEvery, "100"},
                         {"orientation_fix_every", notNullEvery, "10000"},
+                        {"particle_reorder_every", nullableEvery, "0"},
                         {"output_last_snapshot", create_output_last_snapshot(), "[]"},
                         {"record_trajectory", create_record_trajectory(), "[]"},
                         {"averages_out", out_, "None"},
@@ -220,6 +221,7 @@ namespace {
                 run.averagingEvery = integration["averaging_every"].as<std::size_t>();
                 run.inlineInfoEvery = integration["inline_info_every"].as<std::size_t>();
                 run.orientationFixEvery = integration["orientation_fix_every"].as<std::size_t>();
+                run.particleReorderEvery = integration["particle_reorder_every"].as<std::size_t>();
                 run.lastSnapshotWriters = integration["output_last_snapshot"].as<std::vector<FileSnapshotWriter>>();
                 run.ramsnapOut = fetch_ramsnap_out(run.lastSnapshotWriters);
                 run.simulationRecorders
@@ -256,6 +258,7 @@ namespace {
                         {"box_move_type", create_box_scaler(), "None"},
                         {"inline_info_every", notNullEvery, "100"},
                         {"orientation_fix_every", notNullEvery, "10000"},
+                        {"particle_reorder_every", nullableEvery, "0"},
                         {"helper_shape", helperShape, "None"},
                         {"output_last_snapshot", create_output_last_snapshot(), "[]"},
                         {"record_trajectory", create_record_trajectory(), "[]"},
@@ -269,6 +272,7 @@ namespace {
                 run.snapshotEvery = overlaps["snapshot_every"].as<std::size_t>();
                 run.inlineInfoEvery = overlaps["inline_info_every"].as<std::size_t>();
                 run.orientationFixEvery = overlaps["orientation_fix_every"].as<std::size_t>();
+                run.particleReorderEvery = overlaps["particle_reorder_every"].as<std::size_t>();
                 run.helperShapeTraits = overlaps["helper_shape"].as<std::shared_ptr<ShapeTraits>>();
                 run.lastSnapshotWriters = overlaps["output_last_snapshot"].as<std::vector<FileSnapshotWriter>>();
                 run.ramsnapOut = fetch_ramsnap_out(run.lastSnapshotWriters);
@@ -370,6 +374,12 @@ namespace {
         baseParams.scalingThreads = rampack["box_move_threads"].as<std::size_t>();
         baseParams.domainDivisions = rampack["domain_divisions"].as<std::array<std::size_t, 3>>();
         baseParams.saveOnSignal = rampack["handle_signals"].as<bool>();
+        baseParams.verletSkin = rampack["verlet_skin"].as<double>();
+        baseParams.tuneNeighbourGrid = rampack["tune_neighbour_grid"].as<bool>();
+        baseParams.neighbourGridCellSubdivisions = rampack["neighbour_grid_cell_subdivisions"].as<std::size_t>();
+        baseParams.leanNeighbourGrid = rampack["lean_neighbour_grid"].as<bool>();
+        baseParams.separatingDirectionCache = rampack["separating_direction_cache"].as<bool>();
+        baseParams.moleculeNeighbourGrid = rampack["molecule_neighbour_grid"].as<bool>();
 
         return baseParams;
     }
@@ -393,7 +403,13 @@ pyon::matcher::MatcherDataclass RampackMatcher::create() {
                     {"walls", walls, "[False, False, False]"},
                     {"box_move_threads", create_box_move_threads(), "1"},
                     {"domain_divisions", create_domain_divisions(), "[1, 1, 1]"},
-                    {"handle_signals", MatcherBoolean{}, "True"}})
+                    {"handle_signals", MatcherBoolean{}, "True"},
+                    {"verlet_skin", MatcherFloat{}.nonNegative(), "0"},
+                    {"tune_neighbour_grid", MatcherBoolean{}, "False"},
+                    {"neighbour_grid_cell_subdivisions", MatcherInt{}.positive().mapTo<std::size_t>(), "1"},
+                    {"lean_neighbour_grid", MatcherBoolean{}, "False"},
+                    {"separating_direction_cache", MatcherBoolean{}, "False"},
+                    {"molecule_neighbour_grid", MatcherBoolean{}, "False"}})
         .filter([](const DataclassData &rampack) {
             auto runs = rampack["runs"].as<std::vector<Run>>();
             auto runNameVisitor = [](const Run &run) {
@@ -21,6 +21,7 @@
 
 #include "geometry/xenocollide/XCBodyBuilder.h"
 #include "core/shapes/PolyhedralWedgeTraits.h"
+#include "core/shapes/EllipsoidTraits.h"
 
 #include "GenericConvexGeometryMatcher.h"
 
@@ -44,6 +45,7 @@ namespace {
     MatcherDataclass create_polyspherocylinder_matcher();
     MatcherDataclass create_generic_convex_matcher();
     MatcherDataclass create_polyhedral_wedge_matcher();
+    MatcherDataclass create_ellipsoid_matcher();
 
     bool validate_axes(const DataclassData &dataclass);
 
@@ -73,6 +75,21 @@ namespace {
             return points;
         });
 
+    auto narrowPhase = MatcherString{}.anyOf({"auto", "mpr", "gjk"});
+
+    template<typename ConcreteTraits>
+    std::shared_ptr<ShapeTraits> with_narrow_phase(std::shared_ptr<ConcreteTraits> traits,
+                                                   const std::string &narrowPhase)
+    {
+        if (narrowPhase == "mpr")
+            traits->setNarrowPhase(XCNarrowPhase::MPR);
+        else if (narrowPhase == "gjk")
+            traits->setNarrowPhase(XCNarrowPhase::GJK);
+        else
+            traits->calibrateNarrowPhase();
+        return traits;
+    }
+
 
     MatcherDataclass create_lj_matcher() {
         return MatcherDataclass("lj")
@@ -258,7 +275,8 @@ namespace {
             .arguments({{"l", MatcherFloat{}.positive()},
                         {"bottom_r", MatcherFloat{}.positive()},
                         {"top_r", MatcherFloat{}.positive()},
-                        {"subdivisions", MatcherInt{}.positive().mapTo<std::size_t>(), "1"}})
+                        {"subdivisions", MatcherInt{}.positive().mapTo<std::size_t>(), "1"},
+                        {"narrow_phase", narrowPhase, R"("auto")"}})
             .filter([](const DataclassData &wedge){
                 double rDiff = std::abs(wedge["bottom_r"].as<double>() - wedge["top_r"].as<double>());
                 return wedge["l"].as<double>() >= rDiff;
@@ -269,7 +287,8 @@ namespace {
                 auto bottomR = wedge["bottom_r"].as<double>();
                 auto topR = wedge["top_r"].as<double>();
                 auto subdivisions = wedge["subdivisions"].as<std::size_t>();
-                return std::make_shared<SmoothWedgeTraits>(bottomR, topR, length, subdivisions);
+                return with_narrow_phase(std::make_shared<SmoothWedgeTraits>(bottomR, topR, length, subdivisions),
+                                         wedge["narrow_phase"].as<std::string>());
             });
     }
 
@@ -415,7 +434,8 @@ namespace {
                         {"geometric_center", vector, "[0, 0, 0]"},
                         {"primary_axis", axis | MatcherNone{}, "None"},
                         {"secondary_axis", axis | MatcherNone{}, "None"},
-                        {"named_points", namedPoints, "{}"}})
+                        {"named_points", namedPoints, "{}"},
+                        {"narrow_phase", narrowPhase, R"("auto")"}})
             .filter(validate_axes)
             .describe("primary_axis and secondary_axis must be orthogonal")
             .mapTo([](const DataclassData &convex) -> std::shared_ptr<ShapeTraits> {
@@ -432,11 +452,15 @@ namespace {
 
                 XCBodyBuilder builder;
                 script(builder);
-                auto geometry = builder.releaseCollideGeometry();
+                auto geometry = builder.releaseSupportProgram();
+                // Bounds estimated from the building blocks are loose for composite and off-center geometries
+                Vector<3> geometryCenter = geometry.fitBoundingSpheres();
 
-                return std::make_shared<GenericXenoCollideTraits>(
-                    geometry, primaryAxis, secondaryAxis, geometricOrigin, volume, namedPoints
+                auto traits = std::make_shared<GenericXenoCollideTraits>(
+                    std::move(geometry), primaryAxis, secondaryAxis, geometricOrigin, volume, namedPoints,
+                    geometryCenter
                 );
+                return with_narrow_phase(std::move(traits), convex["narrow_phase"].as<std::string>());
             });
     }
 
@@ -447,7 +471,8 @@ namespace {
                         {"top_ax", MatcherFloat{}.nonNegative()},
                         {"top_ay", MatcherFloat{}.nonNegative()},
                         {"l", MatcherFloat{}.positive()},
-                        {"subdivisions", MatcherInt{}.positive().mapTo<std::size_t>(), "1"}})
+                        {"subdivisions", MatcherInt{}.positive().mapTo<std::size_t>(), "1"},
+                        {"narrow_phase", narrowPhase, R"("auto")"}})
             .filter([](const DataclassData &wedge) {
                 auto bottomRx = wedge["bottom_ax"].as<double>();
                 auto bottomRy = wedge["bottom_ay"].as<double>();
@@ -457,7 +482,7 @@ namespace {
             })
             .describe("with at least one pair of non-zero orthogonal a-s, one at the top, one at the bottom")
             .mapTo([](const DataclassData &wedge) -> std::shared_ptr<ShapeTraits> {
-                return std::make_shared<PolyhedralWedgeTraits>(
+                auto traits = std::make_shared<PolyhedralWedgeTraits>(
                     wedge["bottom_ax"].as<double>(),
                     wedge["bottom_ay"].as<double>(),
                     wedge["top_ax"].as<double>(),
@@ -465,6 +490,19 @@ namespace {
                     wedge["l"].as<double>(),
                     wedge["subdivisions"].as<std::size_t>()
                 );
+                return with_narrow_phase(std::move(traits), wedge["narrow_phase"].as<std::string>());
+            });
+    }
+
+    MatcherDataclass create_ellipsoid_matcher() {
+        return MatcherDataclass("ellipsoid")
+            .arguments({{"rx", MatcherFloat{}.positive()},
+                        {"ry", MatcherFloat{}.positive()},
+                        {"rz", MatcherFloat{}.positive()}})
+            .mapTo([](const DataclassData &ellipsoid) -> std::shared_ptr<ShapeTraits> {
+                return std::make_shared<EllipsoidTraits>(
+                    ellipsoid["rx"].as<double>(), ellipsoid["ry"].as<double>(), ellipsoid["rz"].as<double>()
+                );
             });
     }
 
@@ -505,5 +543,6 @@ pyon::matcher::MatcherAlternative ShapeMatcher::create() {
         | create_polysphere_matcher()
         | create_polyspherocylinder_matcher()
         | create_generic_convex_matcher()
-        | create_polyhedral_wedge_matcher();
+        | create_polyhedral_wedge_matcher()
+        | create_ellipsoid_matcher();
 }
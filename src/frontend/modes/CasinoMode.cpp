@@ -11,6 +11,8 @@
 #include "CasinoMode.h"
 #include "utils/Utils.h"
 #include "core/shapes/CompoundShapeTraits.h"
+#include "core/shapes/MoleculeShapeTraits.h"
+#include "core/shapes/XCNarrowPhaseSelector.h"
 #include "core/PeriodicBoundaryConditions.h"
 #include "utils/Fold.h"
 
@@ -98,11 +100,19 @@ int CasinoMode::main(int argc, char **argv) {
 
     RampackParameters rampackParams = this->io.dispatchParams(inputFilename);
     auto &baseParams = rampackParams.baseParameters;
+    // The narrow phase is queried before the interaction is (optionally) wrapped by MoleculeShapeTraits
+    const auto *narrowPhaseSelector
+        = dynamic_cast<const XCNarrowPhaseSelector *>(&baseParams.shapeTraits->getInteraction());
+    std::string narrowPhase = (narrowPhaseSelector == nullptr) ? "" : narrowPhaseSelector->getNarrowPhaseName();
+    if (baseParams.moleculeNeighbourGrid)
+        baseParams.shapeTraits = CasinoMode::toMoleculeShapeTraits(baseParams.shapeTraits);
     const auto &shapeTraits = baseParams.shapeTraits;
 
     this->logger << "--------------------------------------------------------------------" << std::endl;
     this->logger << "Interaction centre range : " << shapeTraits->getInteraction().getRangeRadius() << std::endl;
     this->logger << "Total interaction range  : " << shapeTraits->getInteraction().getTotalRangeRadius() << std::endl;
+    if (!narrowPhase.empty())
+        this->logger << "Narrow phase algorithm   : " << narrowPhase << std::endl;
     this->logger << "--------------------------------------------------------------------" << std::endl;
 
 #ifdef _OPENMP
@@ -160,6 +170,8 @@ int CasinoMode::main(int argc, char **argv) {
         this->logger.warn() << "No runs left to be performed. Exiting." << std::endl;
         return EXIT_SUCCESS;
     }
+    if (baseParams.verletSkin > 0)
+        this->logger.info() << "Using Verlet lists with skin " << baseParams.verletSkin << std::endl;
 
     std::size_t startRunIndex = packingLoader.getStartRunIndex();
     std::size_t cycleOffset = packingLoader.getCycleOffset();
@@ -169,6 +181,10 @@ int CasinoMode::main(int argc, char **argv) {
 
     // Perform simulations starting from initial run
     Simulation simulation(std::move(packing), baseParams.seed, baseParams.domainDivisions, baseParams.saveOnSignal);
+    if (baseParams.tuneNeighbourGrid) {
+        simulation.setNeighbourGridCellSizeTuner(NeighbourGridCellSizeTuner{});
+        this->logger.info() << "Neighbour grid cell size will be tuned during thermalisation" << std::endl;
+    }
 
     for (std::size_t i = startRunIndex; i < rampackParams.runs.size(); i++) {
         const auto &run = rampackParams.runs[i];
@@ -218,6 +234,7 @@ void CasinoMode::performIntegration(Simulation &simulation, Simulation::Environm
     integrationParams.snapshotEvery = run.snapshotEvery;
     integrationParams.inlineInfoEvery = run.inlineInfoEvery;
     integrationParams.rotationMatrixFixEvery = run.orientationFixEvery;
+    integrationParams.particleReorderEvery = run.particleReorderEvery;
     integrationParams.cycleOffset = cycleOffset;
 
     simulation.integrate(env, integrationParams, shapeTraits, std::move(onTheFlyOutput.collector),
@@ -285,13 +302,19 @@ void CasinoMode::performOverlapRelaxation(Simulation &simulation, Simulation::En
 
     OnTheFlyOutput onTheFlyOutput(run, simulation.getPacking().size(), cycleOffset, isContinuation, this->logger);
 
-    if (run.helperShapeTraits != nullptr)
-        shapeTraits = std::make_shared<CompoundShapeTraits>(shapeTraits, run.helperShapeTraits);
+    if (run.helperShapeTraits != nullptr) {
+        auto helperShapeTraits = run.helperShapeTraits;
+        // If molecules are stored in the neighbour grid as a whole, the helper interaction has to be lifted as well
+        if (std::dynamic_pointer_cast<MoleculeShapeTraits>(shapeTraits) != nullptr)
+            helperShapeTraits = CasinoMode::toMoleculeShapeTraits(helperShapeTraits);
+        shapeTraits = std::make_shared<CompoundShapeTraits>(shapeTraits, helperShapeTraits);
+    }
 
     Simulation::OverlapRelaxationParameters relaxParams;
     relaxParams.snapshotEvery = run.snapshotEvery;
     relaxParams.inlineInfoEvery = run.inlineInfoEvery;
     relaxParams.rotationMatrixFixEvery = run.orientationFixEvery;
+    relaxParams.particleReorderEvery = run.particleReorderEvery;
     relaxParams.cycleOffset = cycleOffset;
 
     simulation.relaxOverlaps(env, relaxParams, *shapeTraits, std::move(onTheFlyOutput.collector),
@@ -360,10 +383,22 @@ std::unique_ptr<Packing> CasinoMode::recreatePacking(PackingLoader &loader, cons
     }
 
     packing->toggleWalls(params.walls);
+    if (params.verletSkin > 0)
+        packing->setVerletListSkin(params.verletSkin);
+    packing->setNeighbourGridCellSubdivisions(params.neighbourGridCellSubdivisions);
+    packing->toggleLeanNeighbourGrid(params.leanNeighbourGrid);
+    packing->toggleSeparatingDirectionCache(params.separatingDirectionCache);
 
     return packing;
 }
 
+std::shared_ptr<ShapeTraits> CasinoMode::toMoleculeShapeTraits(const std::shared_ptr<ShapeTraits> &traits) {
+    // Single-centre interactions are already stored in the neighbour grid as whole molecules
+    if (traits->getInteraction().getInteractionCentres().empty())
+        return traits;
+    return std::make_shared<MoleculeShapeTraits>(traits);
+}
+
 void CasinoMode::verifyDynamicParameter(const DynamicParameter &dynamicParameter, const std::string &parameterName,
                                         const IntegrationRun &run, std::size_t cycleOffset) const
 {
@@ -425,6 +460,14 @@ void CasinoMode::printPerformanceInfo(const Simulation &simulation) {
     this->logger << "Neighbour grid resizes/rebuilds : " << ngResizes << "/" << ngRebuilds << std::endl;
     this->logger << "Average neighbours per centre   : " << simulatedPacking.getAverageNumberOfNeighbours();
     this->logger << std::endl;
+    if (simulatedPacking.getVerletListSkin() > 0)
+        this->logger << "Verlet list rebuilds            : " << simulatedPacking.getVerletListRebuilds() << std::endl;
+    this->logger << "Neighbour grid cell size        : " << simulatedPacking.getNeighbourGridCellSize() << " (factor ";
+    this->logger << simulatedPacking.getNeighbourGridCellSizeFactor();
+    const auto &cellSizeTuner = simulation.getNeighbourGridCellSizeTuner();
+    if (cellSizeTuner.has_value())
+        this->logger << (cellSizeTuner->isTuned() ? ", tuned" : ", tuning not finished");
+    this->logger << ")" << std::endl;
     this->logger << "--------------------------------------------------------------------" << std::endl;
     this->logger << "Cycles per second   : " << cyclesPerSecond << std::endl;
     this->logger << "--------------------------------------------------------------------" << std::endl;
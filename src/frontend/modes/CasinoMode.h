@@ -53,6 +53,7 @@ private:
     void printMoveStatistics(const Simulation &simulation) const;
     static std::unique_ptr<Packing> recreatePacking(PackingLoader &loader, const BaseParameters &params,
                                                     const ShapeTraits &traits, std::size_t maxThreads);
+    static std::shared_ptr<ShapeTraits> toMoleculeShapeTraits(const std::shared_ptr<ShapeTraits> &traits);
     static std::string formatMoveKey(const std::string &groupName, const std::string &moveName);
     static bool isStepSizeKey(const std::string &key);
 
@@ -8,6 +8,7 @@
 
 #include "ShapePreviewMode.h"
 #include "core/ShapeTraits.h"
+#include "core/shapes/XCNarrowPhaseSelector.h"
 #include "frontend/RampackParameters.h"
 #include "utils/Utils.h"
 #include "frontend/matchers/ShapeMatcher.h"
@@ -129,6 +130,8 @@ void ShapePreviewMode::printInteractionInfo(const Interaction &interaction) {
     this->logger << "Has wall part            : " << displayBool(interaction.hasWallPart()) << std::endl;
     this->logger << "Interaction center range : " << interaction.getRangeRadius() << std::endl;
     this->logger << "Total range              : " << interaction.getTotalRangeRadius() << std::endl;
+    if (const auto *narrowPhaseSelector = dynamic_cast<const XCNarrowPhaseSelector *>(&interaction))
+        this->logger << "Narrow phase algorithm   : " << narrowPhaseSelector->getNarrowPhaseName() << std::endl;
     this->logger << "Interaction centers      :" << std::endl;
     auto interactionCentres = interaction.getInteractionCentres();
     if (interactionCentres.empty())
@@ -0,0 +1,114 @@
+#ifndef RAMPACK_ELLIPSOIDCONTACTCALCULATOR_H
+#define RAMPACK_ELLIPSOIDCONTACTCALCULATOR_H
+
+#include <array>
+#include <cmath>
+#include <cstddef>
+
+#include "geometry/Vector.h"
+#include "geometry/Matrix.h"
+
+
+/**
+ * @brief Overlap test of two ellipsoids based on the Perram-Wertheim contact function.
+ * @details Ellipsoids are described by shape matrices @f$ \Sigma = R D R^T @f$, where @f$ R @f$ is the orientation
+ * and @f$ D @f$ is the diagonal matrix of squared semi-axes (see EllipsoidContactCalculator::calculateShapeMatrix).
+ * For the vector @f$ r @f$ joining the centers, the contact function
+ * @f[ F(\lambda) = \lambda (1 - \lambda) r^T [(1 - \lambda) \Sigma_1 + \lambda \Sigma_2]^{-1} r @f]
+ * is concave on [0, 1] and the ellipsoids overlap if and only if its maximum is smaller than 1 (see J. W. Perram,
+ * M. S. Wertheim, J. Comput. Phys. 58, 409 (1985)).
+ */
+class EllipsoidContactCalculator {
+private:
+    static constexpr std::size_t MAX_ITERATIONS = 32;
+    static constexpr double LAMBDA_TOLERANCE = 1e-12;
+
+    // Upper triangle of a symmetric matrix: xx, yy, zz, xy, xz, yz
+    using SymmetricMatrix = std::array<double, 6>;
+
+    static SymmetricMatrix toSymmetric(const Matrix<3, 3> &matrix) {
+        const double *m = matrix.begin();
+        return {m[0], m[4], m[8], m[1], m[2], m[5]};
+    }
+
+    static Vector<3> multiply(const SymmetricMatrix &m, const Vector<3> &v) {
+        return {m[0]*v[0] + m[3]*v[1] + m[4]*v[2],
+                m[3]*v[0] + m[1]*v[1] + m[5]*v[2],
+                m[4]*v[0] + m[5]*v[1] + m[2]*v[2]};
+    }
+
+public:
+    /**
+     * @brief Returns the shape matrix @f$ R D R^T @f$ of the ellipsoid with semi-axes @a semiAxes (along x, y and z
+     * axes of its own coordinate system) and the orientation @a orientation.
+     */
+    static Matrix<3, 3> calculateShapeMatrix(const Matrix<3, 3> &orientation, const Vector<3> &semiAxes) {
+        const double *rot = orientation.begin();
+        Matrix<3, 3> result;
+        for (std::size_t i{}; i < 3; i++) {
+            for (std::size_t j = i; j < 3; j++) {
+                double element{};
+                for (std::size_t k{}; k < 3; k++)
+                    element += rot[3*i + k] * semiAxes[k] * semiAxes[k] * rot[3*j + k];
+                result(i, j) = element;
+                result(j, i) = element;
+            }
+        }
+        return result;
+    }
+
+    /**
+     * @brief Returns @a true if the ellipsoids with shape matrices @a shapeMatrix1 and @a shapeMatrix2 and centers
+     * separated by @a r overlap.
+     * @details The maximum of the contact function is found using the Newton method with analytic derivatives. It
+     * terminates as soon as a value of at least 1 is found, which proves the separation, so for well separated pairs
+     * only one or two iterations are performed. If the method does not converge, the overlap is reported.
+     */
+    static bool overlap(const Matrix<3, 3> &shapeMatrix1, const Matrix<3, 3> &shapeMatrix2, const Vector<3> &r) {
+        SymmetricMatrix A = toSymmetric(shapeMatrix1);
+        SymmetricMatrix B = toSymmetric(shapeMatrix2);
+        SymmetricMatrix C;
+        for (std::size_t i{}; i < 6; i++)
+            C[i] = B[i] - A[i];
+
+        double lambda = 0.5;
+        for (std::size_t iteration{}; iteration < MAX_ITERATIONS; iteration++) {
+            // Adjugate of M = (1 - lambda) A + lambda B = A + lambda C
+            SymmetricMatrix M;
+            for (std::size_t i{}; i < 6; i++)
+                M[i] = A[i] + lambda * C[i];
+            SymmetricMatrix adj{M[1]*M[2] - M[5]*M[5], M[0]*M[2] - M[4]*M[4], M[0]*M[1] - M[3]*M[3],
+                                M[4]*M[5] - M[3]*M[2], M[3]*M[5] - M[1]*M[4], M[3]*M[4] - M[0]*M[5]};
+            double det = M[0]*adj[0] + M[3]*adj[3] + M[4]*adj[4];
+
+            // g(lambda) = r^T M^-1 r and its derivatives g' = -x^T C x, g'' = 2 (C x)^T M^-1 C x, where x = M^-1 r
+            Vector<3> x = multiply(adj, r) / det;
+            double g = r * x;
+            double F = lambda * (1 - lambda) * g;
+            if (F >= 1)
+                return false;
+
+            Vector<3> Cx = multiply(C, x);
+            double g1 = -(x * Cx);
+            double g2 = 2 * (Cx * multiply(adj, Cx)) / det;
+            double F1 = (1 - 2*lambda) * g + lambda * (1 - lambda) * g1;
+            double F2 = -2 * g + 2 * (1 - 2*lambda) * g1 + lambda * (1 - lambda) * g2;
+
+            // F is concave, so F2 < 0. Steps outside (0, 1) are replaced by bisection towards the boundary
+            double newLambda = lambda - F1 / F2;
+            if (!(newLambda > 0))
+                newLambda = lambda / 2;
+            else if (!(newLambda < 1))
+                newLambda = (1 + lambda) / 2;
+
+            if (std::abs(newLambda - lambda) < LAMBDA_TOLERANCE)
+                return true;
+            lambda = newLambda;
+        }
+
+        return true;
+    }
+};
+
+
+#endif //RAMPACK_ELLIPSOIDCONTACTCALCULATOR_H
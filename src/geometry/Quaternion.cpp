@@ -55,3 +55,24 @@ Vector<4> Quaternion::fromMatrix(const Matrix<3, 3> &mat) {
 
     return quat.normalized();
 }
+
+Matrix<3, 3> Quaternion::toMatrix(const Vector<4> &quat) {
+    double x = quat[0], y = quat[1], z = quat[2], w = quat[3];
+    double x2 = x*x, y2 = y*y, z2 = z*z;
+    double xy = x*y, xz = x*z, yz = y*z;
+    double xw = x*w, yw = y*w, zw = z*w;
+
+    return {1 - 2*(y2 + z2), 2*(xy - zw),     2*(xz + yw),
+            2*(xy + zw),     1 - 2*(x2 + z2), 2*(yz - xw),
+            2*(xz - yw),     2*(yz + xw),     1 - 2*(x2 + y2)};
+}
+
+Vector<4> Quaternion::multiply(const Vector<4> &quat1, const Vector<4> &quat2) {
+    double x1 = quat1[0], y1 = quat1[1], z1 = quat1[2], w1 = quat1[3];
+    double x2 = quat2[0], y2 = quat2[1], z2 = quat2[2], w2 = quat2[3];
+
+    return {w1*x2 + x1*w2 + y1*z2 - z1*y2,
+            w1*y2 - x1*z2 + y1*w2 + z1*x2,
+            w1*z2 + x1*y2 - y1*x2 + z1*w2,
+            w1*w2 - x1*x2 - y1*y2 - z1*z2};
+}
@@ -10,11 +10,26 @@
 
 
 /**
- * @brief Helper class converting rotation matrix to a quaternion.
+ * @brief Helper class for unit quaternions representing rotations.
+ * @details Quaternions are stored as Vector<4> in the order (x, y, z, w), where w is the real part.
  */
 class Quaternion {
 public:
+    /**
+     * @brief Converts rotation matrix @a mat to a unit quaternion.
+     */
     static Vector<4> fromMatrix(const Matrix<3, 3> &mat);
+
+    /**
+     * @brief Converts unit quaternion @a quat to a rotation matrix.
+     */
+    static Matrix<3, 3> toMatrix(const Vector<4> &quat);
+
+    /**
+     * @brief Returns the Hamilton product of @a quat1 and @a quat2 - rotation which is a composition of @a quat2 and
+     * then @a quat1.
+     */
+    static Vector<4> multiply(const Vector<4> &quat1, const Vector<4> &quat2);
 };
 
 
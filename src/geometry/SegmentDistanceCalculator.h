@@ -5,6 +5,8 @@
 #ifndef RAMPACK_SEGMENTDISTANCECALCULATOR_H
 #define RAMPACK_SEGMENTDISTANCECALCULATOR_H
 
+#include <cmath>
+
 #include "geometry/Vector.h"
 
 class SegmentDistanceCalculator {
@@ -83,6 +85,50 @@ public:
 
         return dP.norm2();   // return the closest distance
     }
+
+    // The same as calculate, but with all branches replaced by selects, so that a loop calling it can be vectorised. The
+    // segments are given by the vectors spanning them: u = s12 - s11, v = s22 - s21 and the difference of their
+    // beginnings w = s11 - s21 (all split into coordinates)
+    #pragma omp declare simd
+    static double calculateBranchless(double ux, double uy, double uz, double vx, double vy, double vz, double wx,
+                                      double wy, double wz)
+    {
+        double a = ux*ux + uy*uy + uz*uz;
+        double b = ux*vx + uy*vy + uz*vz;
+        double c = vx*vx + vy*vy + vz*vz;
+        double d = ux*wx + uy*wy + uz*wz;
+        double e = vx*wx + vy*wy + vz*wz;
+        double D = a * c - b * b;
+
+        // closest points on the infinite lines, clamped to the s = 0 or s = 1 edge
+        bool parallel = D < EPSILON;
+        double sLines = b * e - c * d;
+        double tLines = a * e - b * d;
+        bool sLow = !parallel && sLines < 0.0;
+        bool sHigh = !parallel && !sLow && sLines > D;
+        double sN = (parallel || sLow) ? 0.0 : (sHigh ? D : sLines);
+        double sD = parallel ? 1.0 : D;
+        double tN = (parallel || sLow) ? e : (sHigh ? e + b : tLines);
+        double tD = (parallel || sLow || sHigh) ? c : D;
+
+        // t clamped to the t = 0 or t = 1 edge - s is recomputed for this edge
+        bool tLow = tN < 0.0;
+        bool tHigh = !tLow && tN > tD;
+        double sEdge = tLow ? -d : (-d + b);
+        double sEdgeN = sEdge < 0.0 ? 0.0 : (sEdge > a ? sD : sEdge);
+        double sEdgeD = (sEdge < 0.0 || sEdge > a) ? sD : a;
+        sN = (tLow || tHigh) ? sEdgeN : sN;
+        sD = (tLow || tHigh) ? sEdgeD : sD;
+        tN = tLow ? 0.0 : (tHigh ? tD : tN);
+
+        double sc = (std::abs(sN) < EPSILON ? 0.0 : sN / sD);
+        double tc = (std::abs(tN) < EPSILON ? 0.0 : tN / tD);
+
+        double dPx = wx + sc * ux - tc * vx;
+        double dPy = wy + sc * uy - tc * vy;
+        double dPz = wz + sc * uz - tc * vz;
+        return dPx*dPx + dPy*dPy + dPz*dPz;
+    }
 };
 
 
@@ -0,0 +1,199 @@
+#ifndef RAMPACK_GJK_H
+#define RAMPACK_GJK_H
+
+#include <array>
+
+#include "geometry/Vector.h"
+#include "geometry/Matrix.h"
+#include "XenoCollide.h"
+#include "XCUtils.h"
+
+
+/**
+ * @brief Boolean Gilbert-Johnson-Keerthi (GJK) intersection test, an alternative to XenoCollide (which uses Minkowski
+ * Portal Refinement).
+ * @details The class works on the same XCGeometry objects and has the same interface as XenoCollide (see its
+ * description for the requirements). GJK builds a simplex inside the Minkowski difference of the shapes, which is
+ * evolved towards the origin, and terminates as soon as the simplex encloses the origin (a hit) or a support plane
+ * separating the origin is found (a miss). For some geometries (for example polytopes with many vertices) it requires
+ * fewer support point evaluations than XenoCollide.
+ */
+template<typename XCGeometry>
+class GJK {
+private:
+    static constexpr std::size_t MAX_ITERATIONS = 64;
+
+    using Simplex = std::array<Vector<3>, 4>;
+
+    static inline Vector<3> TransformSupportVert(const XCGeometry &geom, const Matrix<3, 3> &rot, const Vector<3> &pos,
+                                                 const Vector<3> &n)
+    {
+        Vector<3> localNormal = rot.transpose() * n;
+        Vector<3> localSupport = geom.getSupportPoint(localNormal);
+        Vector<3> worldSupport = rot * localSupport + pos;
+        return worldSupport;
+    }
+
+    /* The functions below reduce the simplex (with the newest point at the end) to the feature closest to the origin
+     * and update the search direction. They return true if the origin is enclosed by the simplex (or lies on it). */
+
+    static bool UpdateLine(Simplex &simplex, std::size_t &size, Vector<3> &direction) {
+        const Vector<3> &a = simplex[1];
+        Vector<3> ab = simplex[0] - a;
+        Vector<3> ao = -a;
+
+        if (ab * ao > 0) {
+            direction = (ab ^ ao) ^ ab;
+            // Origin lies on the segment
+            return is_vector_zero(direction);
+        }
+
+        simplex[0] = a;
+        size = 1;
+        direction = ao;
+        return false;
+    }
+
+    static bool UpdateTriangle(Simplex &simplex, std::size_t &size, Vector<3> &direction) {
+        Vector<3> a = simplex[2];
+        Vector<3> b = simplex[1];
+        Vector<3> c = simplex[0];
+        Vector<3> ab = b - a;
+        Vector<3> ac = c - a;
+        Vector<3> ao = -a;
+        Vector<3> abc = ab ^ ac;
+
+        if (((abc ^ ac) * ao) > 0) {
+            if (ac * ao > 0) {
+                simplex[0] = c;
+                simplex[1] = a;
+                size = 2;
+                direction = (ac ^ ao) ^ ac;
+                return is_vector_zero(direction);
+            }
+            simplex[0] = b;
+            simplex[1] = a;
+            size = 2;
+            return UpdateLine(simplex, size, direction);
+        }
+
+        if (((ab ^ abc) * ao) > 0) {
+            simplex[0] = b;
+            simplex[1] = a;
+            size = 2;
+            return UpdateLine(simplex, size, direction);
+        }
+
+        // Origin lies above or below the triangle - the winding is chosen so that (b - a) ^ (c - a) points to it
+        double side = abc * ao;
+        if (side > 0) {
+            direction = abc;
+        } else if (side < 0) {
+            simplex[0] = b;
+            simplex[1] = c;
+            direction = -abc;
+        } else {
+            return true;
+        }
+        return false;
+    }
+
+    static bool UpdateTetrahedron(Simplex &simplex, std::size_t &size, Vector<3> &direction) {
+        Vector<3> a = simplex[3];
+        Vector<3> b = simplex[2];
+        Vector<3> c = simplex[1];
+        Vector<3> d = simplex[0];
+        Vector<3> ao = -a;
+
+        // For each face containing a, its outward normal is compared with the direction to the origin. The face
+        // opposite to a was already checked in the previous iteration
+        auto isOutside = [&a, &ao](const Vector<3> &p1, const Vector<3> &p2, const Vector<3> &opposite) {
+            Vector<3> normal = (p1 - a) ^ (p2 - a);
+            if (normal * (opposite - a) > 0)
+                normal = -normal;
+            return normal * ao > 0;
+        };
+
+        if (isOutside(b, c, d)) {
+            simplex = {c, b, a, {}};
+        } else if (isOutside(c, d, b)) {
+            simplex = {d, c, a, {}};
+        } else if (isOutside(d, b, c)) {
+            simplex = {b, d, a, {}};
+        } else {
+            return true;
+        }
+
+        size = 3;
+        return UpdateTriangle(simplex, size, direction);
+    }
+
+    static bool UpdateSimplex(Simplex &simplex, std::size_t &size, Vector<3> &direction) {
+        switch (size) {
+            case 2:
+                return UpdateLine(simplex, size, direction);
+            case 3:
+                return UpdateTriangle(simplex, size, direction);
+            default:
+                return UpdateTetrahedron(simplex, size, direction);
+        }
+    }
+
+public:
+    /**
+     * @brief Returns @a true, if two shapes, one with position @a pos1, orientation @a rot1 with geometry @a geom1 and
+     * the second one with position @a pos2, orientation @a rot2 with geometry @a geom2 overlap.
+     * @details The arguments have the same meaning as in XenoCollide::Intersect, including the separating direction
+     * reported for a miss. In rare cases, when the simplex does not converge (for shapes nearly touching),
+     * XenoCollide::Intersect with @a boundaryTolerance is used instead.
+     */
+    static bool Intersect(const XCGeometry &geom1, const Matrix<3, 3> &rot1, const Vector<3> &pos1,
+                          const XCGeometry &geom2, const Matrix<3, 3> &rot2, const Vector<3> &pos2,
+                          double boundaryTolerance, Vector<3> *separatingDirection = nullptr)
+    {
+        auto support = [&](const Vector<3> &n) {
+            return TransformSupportVert(geom2, rot2, pos2, n) - TransformSupportVert(geom1, rot1, pos1, -n);
+        };
+        auto miss = [separatingDirection](const Vector<3> &direction) {
+            if (separatingDirection != nullptr)
+                *separatingDirection = direction;
+            return false;
+        };
+
+        // Start from the direction pointing from the center of Minkowski difference to the origin
+        Vector<3> v0 = (rot2 * geom2.getCenter() + pos2) - (rot1 * geom1.getCenter() + pos1);
+        if (is_vector_zero(v0))
+            return true;
+
+        Vector<3> direction = -v0;
+        Simplex simplex;
+        simplex[0] = support(direction);
+        std::size_t size = 1;
+        if (simplex[0] * direction <= 0)
+            return miss(direction);
+
+        direction = -simplex[0];
+        if (is_vector_zero(direction))
+            return true;
+
+        for (std::size_t i{}; i < MAX_ITERATIONS; i++) {
+            // The scale of the direction (a product of cross products) is reset to avoid under- and overflows
+            direction /= direction.norm();
+
+            Vector<3> newPoint = support(direction);
+            // origin outside the support plane ==> miss
+            if (newPoint * direction <= 0)
+                return miss(direction);
+
+            simplex[size++] = newPoint;
+            if (UpdateSimplex(simplex, size, direction))
+                return true;
+        }
+
+        return XenoCollide<XCGeometry>::Intersect(geom1, rot1, pos1, geom2, rot2, pos2, boundaryTolerance,
+                                                  separatingDirection);
+    }
+};
+
+
+#endif //RAMPACK_GJK_H
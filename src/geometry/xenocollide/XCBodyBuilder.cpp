@@ -23,17 +23,50 @@ not be misrepresented as being the original software.
  */
 
 #include <list>
+#include <optional>
 #include <sstream>
 #include <string>
+#include <typeinfo>
 
 #include "XCBodyBuilder.h"
 #include "utils/Utils.h"
 #include "utils/Exceptions.h"
 #include "XCPrimitives.h"
 #include "XCOperations.h"
+#include "XCPolytope.h"
 #include "utils/ParseUtils.h"
 
 
+namespace {
+    // Returns vertices of geometry if it is a polytope (a point, a segment, a rectangle, a cuboid or XCPolytope),
+    // std::nullopt otherwise
+    std::optional<std::vector<Vector<3>>> get_polytope_vertices(const AbstractXCGeometry &geometry) {
+        if (typeid(geometry) == typeid(XCPolytope))
+            return static_cast<const XCPolytope &>(geometry).getVertices();
+
+        // Vertices of the primitives are support points for the directions given below
+        std::vector<Vector<3>> directions;
+        if (typeid(geometry) == typeid(XCPoint))
+            directions = {{0, 0, 1}};
+        else if (typeid(geometry) == typeid(XCSegment))
+            directions = {{0, 0, 1}, {0, 0, -1}};
+        else if (typeid(geometry) == typeid(XCRectangle))
+            directions = {{1, 1, 0}, {1, -1, 0}, {-1, 1, 0}, {-1, -1, 0}};
+        else if (typeid(geometry) == typeid(XCCuboid))
+            directions = {{1, 1, 1}, {1, 1, -1}, {1, -1, 1}, {1, -1, -1},
+                          {-1, 1, 1}, {-1, 1, -1}, {-1, -1, 1}, {-1, -1, -1}};
+        else
+            return std::nullopt;
+
+        std::vector<Vector<3>> vertices;
+        vertices.reserve(directions.size());
+        for (const auto &direction : directions)
+            vertices.push_back(geometry.getSupportPoint(direction));
+        return vertices;
+    }
+}
+
+
 std::shared_ptr<AbstractXCGeometry> XCBodyBuilder::releaseCollideGeometry() {
     if (this->shapeStack.empty()) {
         throw ValidationException("XCBodyBuilder: shape stack is empty");
@@ -47,6 +80,10 @@ std::shared_ptr<AbstractXCGeometry> XCBodyBuilder::releaseCollideGeometry() {
     return geom;
 }
 
+XCSupportProgram XCBodyBuilder::releaseSupportProgram() {
+    return XCSupportProgram(this->releaseCollideGeometry());
+}
+
 void XCBodyBuilder::cuboid(double sideX, double sideY, double sideZ) {
     ValidateMsg(sideX > 0 && sideY > 0 && sideZ > 0, "All cuboid side lengths should be positive");
     auto geom = std::make_shared<XCCuboid>(Vector<3>{sideX / 2, sideY / 2, sideZ / 2});
@@ -182,13 +219,29 @@ void XCBodyBuilder::wrap(std::size_t count) {
     ValidateMsg(this->shapeStack.size() >= count, "Shape stack contains too few shapes; cannot compute convex hull");
 
     auto wrap = std::make_shared<XCMax>();
+    // The convex hull of polytopes is a polytope, which has a faster support function than XCMax
+    std::optional<std::vector<Vector<3>>> polytopeVertices = std::vector<Vector<3>>{};
     for (std::size_t i{}; i < count; i++) {
         auto shape = this->shapeStack.back();
         this->shapeStack.pop_back();
         wrap->add(shape.geometry, shape.pos, shape.orientation);
+
+        if (!polytopeVertices.has_value())
+            continue;
+        auto shapeVertices = get_polytope_vertices(*shape.geometry);
+        if (!shapeVertices.has_value()) {
+            polytopeVertices = std::nullopt;
+            continue;
+        }
+        for (const auto &vertex : *shapeVertices)
+            polytopeVertices->push_back(shape.orientation * vertex + shape.pos);
     }
 
-    this->shapeStack.emplace_back(wrap);
+    // The center is the same as for XCMax
+    if (polytopeVertices.has_value())
+        this->shapeStack.emplace_back(std::make_shared<XCPolytope>(*polytopeVertices, wrap->getCenter()));
+    else
+        this->shapeStack.emplace_back(wrap);
 }
 
 void XCBodyBuilder::processCommand(std::string cmd) {
@@ -30,6 +30,7 @@ not be misrepresented as being the original software.
 #include <utility>
 
 #include "AbstractXCGeometry.h"
+#include "XCSupportProgram.h"
 #include "geometry/Vector.h"
 
 
@@ -91,7 +92,9 @@ public:
     void diff();
     /** @brief Computes Minkowski sum of last @a count shapes in the stack. The sum replaces these ones in the stack. */
     void sum(std::size_t count = 2);
-    /** @brief Computes convex hull of last @a count shapes in the stack. The sum replaces these ones in the stack. */
+    /** @brief Computes convex hull of last @a count shapes in the stack. The sum replaces these ones in the stack. If
+     * all of them are polytopes (points, segments, rectangles, cuboids or their convex hulls), XCPolytope is created
+     * instead of XCMax. */
     void wrap(std::size_t count = 2);
 
     /** @brief Duplicates @a numShape last entries in the stack. */
@@ -117,6 +120,13 @@ public:
      * be fully performed). Position and orientation of that last shape changed using move() and rot() are ignored.
      */
     std::shared_ptr<AbstractXCGeometry> releaseCollideGeometry();
+
+    /**
+     * @brief Releases the geometry built on a stack (see releaseCollideGeometry()) compiled to XCSupportProgram.
+     * @details XCSupportProgram evaluates support points of the whole tree of operations without virtual calls, so it
+     * should be preferred in overlap checks.
+     */
+    XCSupportProgram releaseSupportProgram();
 };
 
 
@@ -0,0 +1,110 @@
+#ifndef RAMPACK_XCBOUNDINGBOX_H
+#define RAMPACK_XCBOUNDINGBOX_H
+
+#include <cmath>
+
+#include "geometry/Vector.h"
+#include "geometry/Matrix.h"
+
+
+/**
+ * @brief Box with edges parallel to the axes of a shape's own coordinate system, which encloses the shape.
+ * @details After rotating the shape, it becomes an oriented bounding box. For flat or elongated shapes aligned with the
+ * axes, it is much tighter than the circumsphere, so XCBoundingBox::areSeparated can reject many pairs of shapes which
+ * are not resolved by the circumsphere and insphere tests, before the more costly XenoCollide test is run.
+ */
+class XCBoundingBox {
+private:
+    Vector<3> center;
+    Vector<3> halfExtents;
+
+public:
+    XCBoundingBox() = default;
+
+    /**
+     * @brief Creates the box with given @a center and half lengths of edges @a halfExtents.
+     */
+    XCBoundingBox(const Vector<3> &center, const Vector<3> &halfExtents)
+            : center{center}, halfExtents{halfExtents}
+    { }
+
+    /**
+     * @brief Creates the smallest box enclosing @a geometry (an object conforming to the template parameter of
+     * XenoCollide) using its support points along the axes.
+     */
+    template<typename XCGeometry>
+    static XCBoundingBox forGeometry(const XCGeometry &geometry) {
+        Vector<3> center, halfExtents;
+        for (std::size_t i{}; i < 3; i++) {
+            Vector<3> axis;
+            axis[i] = 1;
+            double upper = geometry.getSupportPoint(axis)[i];
+            double lower = geometry.getSupportPoint(-axis)[i];
+            center[i] = (upper + lower) / 2;
+            halfExtents[i] = (upper - lower) / 2;
+        }
+        return {center, halfExtents};
+    }
+
+    [[nodiscard]] const Vector<3> &getCenter() const { return this->center; }
+    [[nodiscard]] const Vector<3> &getHalfExtents() const { return this->halfExtents; }
+
+    /**
+     * @brief Returns @a true, if @a box1 rotated by @a rot1 and translated by @a pos1 and @a box2 rotated by @a rot2
+     * and translated by @a pos2 are disjoint.
+     * @details It uses the separating axis theorem with 15 axes: 3 + 3 axes of the boxes and 9 cross products of
+     * them. It is exact up to a small tolerance added for (nearly) parallel edges, for which the cross products
+     * degenerate - in such case, the boxes may be reported as not separated, but never the other way round.
+     */
+    static bool areSeparated(const XCBoundingBox &box1, const Matrix<3, 3> &rot1, const Vector<3> &pos1,
+                             const XCBoundingBox &box2, const Matrix<3, 3> &rot2, const Vector<3> &pos2)
+    {
+        constexpr double EPSILON = 1e-12;
+        const auto &a = box1.halfExtents;
+        const auto &b = box2.halfExtents;
+
+        // Orientation of box2 and the translation between the centers, both in the frame of box1
+        double R[3][3], absR[3][3];
+        for (std::size_t i{}; i < 3; i++) {
+            for (std::size_t j{}; j < 3; j++) {
+                R[i][j] = rot1(0, i)*rot2(0, j) + rot1(1, i)*rot2(1, j) + rot1(2, i)*rot2(2, j);
+                absR[i][j] = std::abs(R[i][j]) + EPSILON;
+            }
+        }
+        Vector<3> translationGlobal = pos2 + rot2*box2.center - pos1 - rot1*box1.center;
+        double t[3];
+        for (std::size_t i{}; i < 3; i++)
+            t[i] = rot1(0, i)*translationGlobal[0] + rot1(1, i)*translationGlobal[1] + rot1(2, i)*translationGlobal[2];
+
+        // Axes of box1
+        for (std::size_t i{}; i < 3; i++)
+            if (std::abs(t[i]) > a[i] + b[0]*absR[i][0] + b[1]*absR[i][1] + b[2]*absR[i][2])
+                return true;
+
+        // Axes of box2
+        for (std::size_t j{}; j < 3; j++) {
+            double tj = t[0]*R[0][j] + t[1]*R[1][j] + t[2]*R[2][j];
+            if (std::abs(tj) > a[0]*absR[0][j] + a[1]*absR[1][j] + a[2]*absR[2][j] + b[j])
+                return true;
+        }
+
+        // Cross products of the axes of box1 (i) and box2 (j)
+        for (std::size_t i{}; i < 3; i++) {
+            std::size_t i1 = (i + 1) % 3;
+            std::size_t i2 = (i + 2) % 3;
+            for (std::size_t j{}; j < 3; j++) {
+                std::size_t j1 = (j + 1) % 3;
+                std::size_t j2 = (j + 2) % 3;
+                double ra = a[i1]*absR[i2][j] + a[i2]*absR[i1][j];
+                double rb = b[j1]*absR[i][j2] + b[j2]*absR[i][j1];
+                if (std::abs(t[i2]*R[i1][j] - t[i1]*R[i2][j]) > ra + rb)
+                    return true;
+            }
+        }
+
+        return false;
+    }
+};
+
+
+#endif //RAMPACK_XCBOUNDINGBOX_H
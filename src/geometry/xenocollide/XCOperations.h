@@ -52,6 +52,8 @@ private:
 
     void recalculateGeometry();
 
+    friend class XCSupportProgram;
+
 public:
     /**
      * @brief Creates an empty Minkowski sum.
@@ -110,6 +112,8 @@ private:
     std::shared_ptr<AbstractXCGeometry> geom1;
     std::shared_ptr<AbstractXCGeometry> geom2;
 
+    friend class XCSupportProgram;
+
 public:
     /**
      * @brief Creates the Minkowski difference for two AbstractXCGeometry -ies with fully specified positions and
@@ -166,6 +170,8 @@ private:
     [[nodiscard]] double calculateInsphereRadius() const;
     [[nodiscard]] double calculateInsphereRadius2() const;
 
+    friend class XCSupportProgram;
+
 public:
     /**
      * @brief Creates an empty convex hull.
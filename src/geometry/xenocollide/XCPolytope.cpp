@@ -0,0 +1,193 @@
+#include <algorithm>
+#include <array>
+#include <cmath>
+#include <iterator>
+#include <limits>
+#include <QuickHull.hpp>
+
+#include "XCPolytope.h"
+#include "utils/Exceptions.h"
+
+
+XCPolytope::XCPolytope(const std::vector<Vector<3>> &points) {
+    Expects(!points.empty());
+
+    this->buildHull(points);
+    for (const auto &vertex : this->vertices)
+        this->center += vertex;
+    this->center /= static_cast<double>(this->vertices.size());
+}
+
+XCPolytope::XCPolytope(const std::vector<Vector<3>> &points, const Vector<3> &center) : center{center} {
+    Expects(!points.empty());
+
+    this->buildHull(points);
+}
+
+bool XCPolytope::isFlat(const std::vector<Vector<3>> &points) {
+    if (points.size() < 4)
+        return true;
+
+    // The plane spanned by the point furthest from the first one and the point furthest from the line joining them
+    const auto &point0 = points.front();
+    auto distanceFromPoint0 = [&point0](const Vector<3> &p1, const Vector<3> &p2) {
+        return (p1 - point0).norm2() < (p2 - point0).norm2();
+    };
+    const auto &point1 = *std::max_element(points.begin(), points.end(), distanceFromPoint0);
+    Vector<3> axis = point1 - point0;
+    double scale = axis.norm();
+    if (scale == 0)
+        return true;
+
+    auto distanceFromAxis = [&point0, &axis](const Vector<3> &p1, const Vector<3> &p2) {
+        return ((p1 - point0) ^ axis).norm2() < ((p2 - point0) ^ axis).norm2();
+    };
+    const auto &point2 = *std::max_element(points.begin(), points.end(), distanceFromAxis);
+    Vector<3> normal = axis ^ (point2 - point0);
+    if (normal.norm() <= 1e-12 * scale * scale)
+        return true;
+    normal = normal.normalized();
+
+    return std::all_of(points.begin(), points.end(), [&point0, &normal, scale](const Vector<3> &point) {
+        return std::abs((point - point0) * normal) <= 1e-12 * scale;
+    });
+}
+
+void XCPolytope::buildHull(const std::vector<Vector<3>> &points) {
+    // Flat polytopes do not have a proper convex hull - all points are kept and scanned linearly
+    if (XCPolytope::isFlat(points)) {
+        this->vertices = points;
+        this->insphereRadius = 0;
+    } else {
+        using QHVector = quickhull::Vector3<double>;
+        std::vector<QHVector> hullPoints;
+        hullPoints.reserve(points.size());
+        std::transform(points.begin(), points.end(), std::back_inserter(hullPoints), [](const Vector<3> &point) {
+            return QHVector{point[0], point[1], point[2]};
+        });
+
+        quickhull::QuickHull<double> qh;
+        auto hull = qh.getConvexHull(hullPoints, true, false);
+        const auto &indexBuffer = hull.getIndexBuffer();
+        const auto &vertexBuffer = hull.getVertexBuffer();
+        Assert(indexBuffer.size() % 3 == 0);
+
+        this->vertices.clear();
+        this->vertices.reserve(vertexBuffer.size());
+        std::transform(vertexBuffer.begin(), vertexBuffer.end(), std::back_inserter(this->vertices),
+                       [](const QHVector &vec) { return Vector<3>{vec.x, vec.y, vec.z}; });
+
+        Vector<3> innerPoint;
+        for (const auto &vertex : this->vertices)
+            innerPoint += vertex;
+        innerPoint /= static_cast<double>(this->vertices.size());
+
+        // Insphere radius is the smallest distance from the origin to face planes (if the origin lies inside)
+        std::vector<std::vector<std::size_t>> adjacency(this->vertices.size());
+        this->insphereRadius = std::numeric_limits<double>::infinity();
+        for (std::size_t i{}; i < indexBuffer.size(); i += 3) {
+            std::array<std::size_t, 3> triangle{indexBuffer[i], indexBuffer[i + 1], indexBuffer[i + 2]};
+            for (std::size_t j{}; j < 3; j++)
+                adjacency[triangle[j]].push_back(triangle[(j + 1) % 3]);
+
+            const auto &vertex0 = this->vertices[triangle[0]];
+            Vector<3> normal = (this->vertices[triangle[1]] - vertex0) ^ (this->vertices[triangle[2]] - vertex0);
+            if (normal.norm2() == 0)
+                continue;
+            normal = normal.normalized();
+            if (normal * (vertex0 - innerPoint) < 0)
+                normal = -normal;
+            this->insphereRadius = std::min(this->insphereRadius, normal * vertex0);
+        }
+        if (!std::isfinite(this->insphereRadius) || this->insphereRadius < 0)
+            this->insphereRadius = 0;
+
+        // Hill-climbing requires edges in both directions
+        if (this->vertices.size() >= HILL_CLIMBING_THRESHOLD) {
+            for (std::size_t i{}; i < adjacency.size(); i++)
+                for (std::size_t j : adjacency[i])
+                    adjacency[j].push_back(i);
+
+            this->neighbourOffsets.reserve(this->vertices.size() + 1);
+            this->neighbourOffsets.push_back(0);
+            for (auto &vertexNeighbours : adjacency) {
+                std::sort(vertexNeighbours.begin(), vertexNeighbours.end());
+                auto newEnd = std::unique(vertexNeighbours.begin(), vertexNeighbours.end());
+                this->neighbours.insert(this->neighbours.end(), vertexNeighbours.begin(), newEnd);
+                this->neighbourOffsets.push_back(this->neighbours.size());
+            }
+        }
+    }
+
+    this->circumsphereRadius = 0;
+    for (const auto &vertex : this->vertices)
+        this->circumsphereRadius = std::max(this->circumsphereRadius, vertex.norm());
+
+    this->findStartingVertices();
+}
+
+void XCPolytope::findStartingVertices() {
+    if (!this->usesHillClimbing())
+        return;
+
+    // Axes and diagonals of the cube
+    for (int x = -1; x <= 1; x++) {
+        for (int y = -1; y <= 1; y++) {
+            for (int z = -1; z <= 1; z++) {
+                int numNonZero = (x != 0) + (y != 0) + (z != 0);
+                if (numNonZero != 1 && numNonZero != 3)
+                    continue;
+                Vector<3> direction{static_cast<double>(x), static_cast<double>(y), static_cast<double>(z)};
+                this->startingVertices.push_back(this->findSupportVertexLinearly(direction));
+            }
+        }
+    }
+
+    std::sort(this->startingVertices.begin(), this->startingVertices.end());
+    auto newEnd = std::unique(this->startingVertices.begin(), this->startingVertices.end());
+    this->startingVertices.erase(newEnd, this->startingVertices.end());
+}
+
+std::size_t XCPolytope::findSupportVertexLinearly(const Vector<3> &n) const {
+    std::size_t supportIdx{};
+    double maxProjection = this->vertices.front() * n;
+    for (std::size_t i = 1; i < this->vertices.size(); i++) {
+        double projection = this->vertices[i] * n;
+        if (projection > maxProjection) {
+            supportIdx = i;
+            maxProjection = projection;
+        }
+    }
+    return supportIdx;
+}
+
+std::size_t XCPolytope::getSupportVertexIndex(const Vector<3> &n) const {
+    if (!this->usesHillClimbing())
+        return this->findSupportVertexLinearly(n);
+
+    std::size_t supportIdx = this->startingVertices.front();
+    double maxProjection = this->vertices[supportIdx] * n;
+    for (std::size_t i : this->startingVertices) {
+        double projection = this->vertices[i] * n;
+        if (projection > maxProjection) {
+            supportIdx = i;
+            maxProjection = projection;
+        }
+    }
+
+    // Steepest ascent along the edges - a vertex without better neighbours is the global maximum for a convex polytope
+    while (true) {
+        std::size_t nextIdx = supportIdx;
+        for (std::size_t i = this->neighbourOffsets[supportIdx]; i < this->neighbourOffsets[supportIdx + 1]; i++) {
+            std::size_t neighbourIdx = this->neighbours[i];
+            double projection = this->vertices[neighbourIdx] * n;
+            if (projection > maxProjection) {
+                nextIdx = neighbourIdx;
+                maxProjection = projection;
+            }
+        }
+        if (nextIdx == supportIdx)
+            return supportIdx;
+        supportIdx = nextIdx;
+    }
+}
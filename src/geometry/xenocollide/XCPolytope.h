@@ -0,0 +1,74 @@
+#ifndef RAMPACK_XCPOLYTOPE_H
+#define RAMPACK_XCPOLYTOPE_H
+
+#include <vector>
+
+#include "AbstractXCGeometry.h"
+
+
+/**
+ * @brief AbstractXCGeometry describing the convex hull of a set of points.
+ * @details Points lying inside the hull are discarded in the constructor and, for each vertex of the hull, the list of
+ * adjacent vertices (connected by an edge) is stored. A support point is then found by hill-climbing: starting from the
+ * best of a few precomputed extreme vertices, it moves to a neighbour with a larger projection on the direction as long
+ * as there is one. For convex polytopes, such a local maximum is the global one, so only a fraction of vertices is
+ * visited. Small and flat polytopes use a linear scan over all vertices instead.
+ */
+class XCPolytope : public AbstractXCGeometry {
+private:
+    // Below this number of vertices a linear scan is faster than hill-climbing
+    static constexpr std::size_t HILL_CLIMBING_THRESHOLD = 16;
+
+    std::vector<Vector<3>> vertices;
+    // Neighbours of vertex i are neighbours[neighbourOffsets[i]], ..., neighbours[neighbourOffsets[i + 1] - 1]
+    std::vector<std::size_t> neighbourOffsets;
+    std::vector<std::size_t> neighbours;
+    // Support vertices for a few fixed directions, from which hill-climbing is started
+    std::vector<std::size_t> startingVertices;
+    Vector<3> center;
+    double circumsphereRadius{};
+    double insphereRadius{};
+
+    static bool isFlat(const std::vector<Vector<3>> &points);
+
+    void buildHull(const std::vector<Vector<3>> &points);
+    void findStartingVertices();
+    [[nodiscard]] std::size_t findSupportVertexLinearly(const Vector<3> &n) const;
+
+public:
+    /**
+     * @brief Creates the convex hull of @a points with the center in the mean position of vertices of the hull.
+     */
+    explicit XCPolytope(const std::vector<Vector<3>> &points);
+
+    /**
+     * @brief Creates the convex hull of @a points with a given @a center (which has to lie inside the hull).
+     */
+    XCPolytope(const std::vector<Vector<3>> &points, const Vector<3> &center);
+
+    /**
+     * @brief Returns the index of the vertex (see XCPolytope::getVertices) being the support point for the direction
+     * @a n.
+     */
+    [[nodiscard]] std::size_t getSupportVertexIndex(const Vector<3> &n) const;
+
+    /**
+     * @brief Returns vertices of the convex hull (points lying inside it are not included).
+     */
+    [[nodiscard]] const std::vector<Vector<3>> &getVertices() const { return this->vertices; }
+
+    /**
+     * @brief Returns @a true if support points are found by hill-climbing (otherwise, all vertices are scanned).
+     */
+    [[nodiscard]] bool usesHillClimbing() const { return !this->neighbours.empty(); }
+
+    [[nodiscard]] Vector<3> getSupportPoint(const Vector<3> &n) const override {
+        return this->vertices[this->getSupportVertexIndex(n)];
+    }
+    [[nodiscard]] Vector<3> getCenter() const override { return this->center; }
+    [[nodiscard]] double getCircumsphereRadius() const override { return this->circumsphereRadius; }
+    [[nodiscard]] double getInsphereRadius() const override { return this->insphereRadius; }
+};
+
+
+#endif //RAMPACK_XCPOLYTOPE_H
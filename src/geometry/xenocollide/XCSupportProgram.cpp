@@ -0,0 +1,217 @@
+#include <algorithm>
+#include <cmath>
+#include <limits>
+#include <numeric>
+#include <optional>
+#include <typeinfo>
+
+#include "XCSupportProgram.h"
+#include "XCOperations.h"
+#include "utils/Exceptions.h"
+
+
+namespace {
+    // Copies geometry to a Primitive variant if its dynamic type is exactly one of the alternatives. Derived classes
+    // are rejected, since they may override getSupportPoint
+    template<typename Primitive, std::size_t I = 0>
+    std::optional<Primitive> to_primitive(const AbstractXCGeometry &geometry) {
+        if constexpr (I == std::variant_size_v<Primitive>) {
+            return std::nullopt;
+        } else {
+            using Alternative = std::variant_alternative_t<I, Primitive>;
+            if (typeid(geometry) == typeid(Alternative))
+                return Primitive(std::in_place_type<Alternative>, static_cast<const Alternative &>(geometry));
+            return to_primitive<Primitive, I + 1>(geometry);
+        }
+    }
+}
+
+XCSupportProgram::XCSupportProgram(std::shared_ptr<AbstractXCGeometry> geometry) : source{std::move(geometry)} {
+    Expects(this->source != nullptr);
+
+    this->center = this->source->getCenter();
+    this->circumsphereRadius = this->source->getCircumsphereRadius();
+    this->insphereRadius = this->source->getInsphereRadius();
+
+    std::size_t numPushed = this->compile(this->source, Matrix<3, 3>::identity(), {});
+    this->addReduction(OpCode::SUM, numPushed);
+    this->calculateMaxStackSize();
+    this->boundingBox = XCBoundingBox::forGeometry(*this);
+}
+
+std::size_t XCSupportProgram::compile(const std::shared_ptr<AbstractXCGeometry> &geometry,
+                                      const Matrix<3, 3> &transform, const Vector<3> &offset)
+{
+    // Sums do not reduce the stack - all points pushed by them are summed by the closest XCMax or at the end. Only
+    // the first summand receives the offset, so that it is added once
+    if (const auto *sum = dynamic_cast<const XCSum *>(geometry.get()); sum != nullptr && !sum->entries.empty()) {
+        std::size_t numPushed{};
+        for (std::size_t i{}; i < sum->entries.size(); i++) {
+            const auto &entry = sum->entries[i];
+            Vector<3> entryOffset = transform * entry.pos + (i == 0 ? offset : Vector<3>{});
+            numPushed += this->compile(entry.geometry, transform * entry.rot, entryOffset);
+        }
+        return numPushed;
+    }
+
+    // A difference is a sum with the second geometry flipped
+    if (const auto *diff = dynamic_cast<const XCDiff *>(geometry.get())) {
+        std::size_t numPushed = this->compile(diff->geom1, transform * diff->rot1, transform * diff->pos1 + offset);
+        numPushed += this->compile(diff->geom2, -(transform * diff->rot2), -(transform * diff->pos2));
+        return numPushed;
+    }
+
+    // All candidates have to be full points in the root frame - then the one with the largest projection on n is also
+    // the one with the largest projection on the local direction of XCMax
+    if (const auto *max = dynamic_cast<const XCMax *>(geometry.get()); max != nullptr && !max->entries.empty()) {
+        for (const auto &entry : max->entries) {
+            std::size_t numPushed = this->compile(entry.geometry, transform * entry.rot,
+                                                  transform * entry.pos + offset);
+            this->addReduction(OpCode::SUM, numPushed);
+        }
+        this->addReduction(OpCode::MAX, max->entries.size());
+        return 1;
+    }
+
+    // Empty sums and convex hulls, as well as points, do not depend on n
+    if (dynamic_cast<const XCSum *>(geometry.get()) != nullptr || dynamic_cast<const XCMax *>(geometry.get()) != nullptr)
+    {
+        this->addLeaf(OpCode::CONSTANT, 0, transform, offset);
+        return 1;
+    }
+    if (typeid(*geometry) == typeid(XCPoint)) {
+        this->addLeaf(OpCode::CONSTANT, 0, transform, transform * geometry->getSupportPoint({}) + offset);
+        return 1;
+    }
+
+    if (auto primitive = to_primitive<Primitive>(*geometry)) {
+        this->primitives.push_back(*primitive);
+        this->addLeaf(OpCode::PRIMITIVE, this->primitives.size() - 1, transform, offset);
+    } else {
+        this->generics.push_back(geometry);
+        this->addLeaf(OpCode::GENERIC, this->generics.size() - 1, transform, offset);
+    }
+    return 1;
+}
+
+void XCSupportProgram::addLeaf(OpCode code, std::size_t index, const Matrix<3, 3> &transform,
+                               const Vector<3> &offset)
+{
+    Op op;
+    op.code = code;
+    op.index = static_cast<std::uint32_t>(index);
+    op.transform = transform;
+    op.transformTransposed = transform.transpose();
+    op.offset = offset;
+    this->program.push_back(op);
+}
+
+void XCSupportProgram::addReduction(OpCode code, std::size_t count) {
+    Expects(count >= 1);
+    if (count == 1)
+        return;
+
+    Op op;
+    op.code = code;
+    op.index = static_cast<std::uint32_t>(count);
+    this->program.push_back(op);
+}
+
+void XCSupportProgram::calculateMaxStackSize() {
+    std::size_t stackSize{};
+    this->maxStackSize = 0;
+    for (const auto &op : this->program) {
+        if (op.code == OpCode::SUM || op.code == OpCode::MAX)
+            stackSize -= op.index - 1;
+        else
+            stackSize++;
+        this->maxStackSize = std::max(this->maxStackSize, stackSize);
+    }
+    Assert(stackSize == 1);
+}
+
+void XCSupportProgram::shift(const Vector<3> &translation) {
+    Op constant;
+    constant.code = OpCode::CONSTANT;
+    constant.offset = translation;
+
+    // The last operation is the reduction of the root - if it is a sum, the translation becomes one more summand
+    if (this->program.back().code == OpCode::SUM) {
+        this->program.back().index++;
+        this->program.insert(std::prev(this->program.end()), constant);
+    } else {
+        this->program.push_back(constant);
+        this->addReduction(OpCode::SUM, 2);
+    }
+    this->calculateMaxStackSize();
+}
+
+Vector<3> XCSupportProgram::fitBoundingSpheres() {
+    // Directions are normalized points of a regular grid on the faces of the cube [-1, 1]^3. A direction from a given
+    // face lies closer than d = sqrt(2)/k (in the plane of the face) to a grid point. The face is at least at the unit
+    // distance from the origin, so the angle between them is at most 2 atan(d/2). The larger angle subtended by the
+    // chord of length d of the unit sphere, 2 asin(d/2), is used as the maximal angular gap to keep a safety margin
+    constexpr std::size_t k = FIT_GRID_DIVISIONS;
+    const double maxAngle = 2 * std::asin(std::sqrt(2.) / (2 * k));
+
+    std::vector<Vector<3>> directions;
+    std::vector<Vector<3>> supportPoints;
+    directions.reserve(6 * (k + 1) * (k + 1));
+    supportPoints.reserve(6 * (k + 1) * (k + 1));
+    for (std::size_t axis{}; axis < 3; axis++) {
+        for (double sign : {-1., 1.}) {
+            for (std::size_t i{}; i <= k; i++) {
+                for (std::size_t j{}; j <= k; j++) {
+                    Vector<3> direction;
+                    direction[axis] = sign;
+                    direction[(axis + 1) % 3] = -1 + 2. * static_cast<double>(i) / k;
+                    direction[(axis + 2) % 3] = -1 + 2. * static_cast<double>(j) / k;
+                    direction = direction.normalized();
+                    directions.push_back(direction);
+                    supportPoints.push_back(this->getSupportPoint(direction));
+                }
+            }
+        }
+    }
+
+    // Conservative radii of the geometry translated by -center (see the description of the method)
+    auto calculateRadii = [&](const Vector<3> &center) {
+        double maxSupport = -std::numeric_limits<double>::infinity();
+        double minSupport = std::numeric_limits<double>::infinity();
+        for (std::size_t i{}; i < directions.size(); i++) {
+            double support = directions[i] * (supportPoints[i] - center);
+            maxSupport = std::max(maxSupport, support);
+            minSupport = std::min(minSupport, support);
+        }
+        double circumsphere = std::min(maxSupport / std::cos(maxAngle), this->circumsphereRadius + center.norm());
+        double insphere = std::max({minSupport - circumsphere * maxAngle, this->insphereRadius - center.norm(), 0.});
+        return std::make_pair(circumsphere, insphere);
+    };
+
+    // Badoiu-Clarkson iteration - the center is moved towards the furthest point by a decreasing fraction of the
+    // distance. It converges to the center of the minimal enclosing sphere of the support points
+    Vector<3> center = std::accumulate(supportPoints.begin(), supportPoints.end(), Vector<3>{})
+                       / static_cast<double>(supportPoints.size());
+    for (std::size_t iteration{}; iteration < FIT_ITERATIONS; iteration++) {
+        auto furthest = std::max_element(supportPoints.begin(), supportPoints.end(),
+                                         [&center](const Vector<3> &p1, const Vector<3> &p2) {
+                                             return (p1 - center).norm2() < (p2 - center).norm2();
+                                         });
+        center += (*furthest - center) / static_cast<double>(iteration + 2);
+    }
+
+    auto [originCircumsphere, originInsphere] = calculateRadii({0, 0, 0});
+    auto [centerCircumsphere, centerInsphere] = calculateRadii(center);
+    if (centerCircumsphere >= FIT_MIN_SHRINK_FACTOR * originCircumsphere) {
+        this->circumsphereRadius = originCircumsphere;
+        this->insphereRadius = originInsphere;
+        return {0, 0, 0};
+    }
+
+    this->shift(-center);
+    this->center -= center;
+    this->circumsphereRadius = centerCircumsphere;
+    this->insphereRadius = centerInsphere;
+    this->boundingBox = XCBoundingBox::forGeometry(*this);
+    return center;
+}
@@ -0,0 +1,197 @@
+#ifndef RAMPACK_XCSUPPORTPROGRAM_H
+#define RAMPACK_XCSUPPORTPROGRAM_H
+
+#include <array>
+#include <cstdint>
+#include <memory>
+#include <variant>
+#include <vector>
+
+#include "AbstractXCGeometry.h"
+#include "XCPrimitives.h"
+#include "XCPolytope.h"
+#include "XCBoundingBox.h"
+#include "geometry/Matrix.h"
+
+
+/**
+ * @brief AbstractXCGeometry evaluating the support function of a tree of AbstractXCGeometry -ies (XCSum, XCDiff, XCMax
+ * and primitives) from a flat list of operations.
+ * @details The tree is compiled in the constructor into a program for a stack machine (in the postfix order). All
+ * positions and orientations of tree nodes (together with sign flips of XCDiff) are folded into a single transformation
+ * for each primitive, which gives its support point directly in the frame of the root. Nested sums are merged into one
+ * and points (XCPoint) become constants. Then the support point is found in a single, non-virtual loop over the program
+ * instead of virtual calls and matrix multiplications on each level of the tree. The class is final, so XenoCollide
+ * instantiated for it evaluates the program directly.
+ *
+ * Geometries which are not known to the compiler (for example PolymorphicXCAdapter) are still used through the virtual
+ * AbstractXCGeometry::getSupportPoint, but only as leaves of the program. The center and the insphere and circumsphere
+ * radii are taken from the root of the tree.
+ */
+class XCSupportProgram final : public AbstractXCGeometry {
+private:
+    enum class OpCode : std::uint8_t {
+        /** @brief Pushes the transformed support point of primitives[index] */
+        PRIMITIVE,
+        /** @brief Pushes the transformed support point of generics[index] (a virtual call) */
+        GENERIC,
+        /** @brief Pushes the offset */
+        CONSTANT,
+        /** @brief Replaces the last count points on the stack with their sum */
+        SUM,
+        /** @brief Replaces the last count points on the stack with the one with the largest projection on n */
+        MAX
+    };
+
+    struct Op {
+        OpCode code{};
+        std::uint32_t index{};  // the index of a primitive or the number of popped points
+        Matrix<3, 3> transform;
+        Matrix<3, 3> transformTransposed;
+        Vector<3> offset;
+    };
+
+    using Primitive = std::variant<XCSegment, XCRectangle, XCCuboid, XCDisk, XCSphere, XCEllipse, XCEllipsoid,
+                                   XCFootball, XCSaucer, XCPolytope>;
+
+    static constexpr std::size_t INLINE_STACK_SIZE = 16;
+    // Cube-sphere grid of directions used in fitBoundingSpheres and the number of iterations of the center fitting
+    static constexpr std::size_t FIT_GRID_DIVISIONS = 48;
+    static constexpr std::size_t FIT_ITERATIONS = 1000;
+    // The center is moved only if it shrinks the circumsphere at least by this factor
+    static constexpr double FIT_MIN_SHRINK_FACTOR = 0.99;
+
+    std::shared_ptr<AbstractXCGeometry> source;
+    std::vector<Op> program;
+    std::vector<Primitive> primitives;
+    std::vector<std::shared_ptr<AbstractXCGeometry>> generics;
+    std::size_t maxStackSize{};
+    Vector<3> center;
+    double circumsphereRadius{};
+    double insphereRadius{};
+    XCBoundingBox boundingBox;
+
+    std::size_t compile(const std::shared_ptr<AbstractXCGeometry> &geometry, const Matrix<3, 3> &transform,
+                        const Vector<3> &offset);
+    void addLeaf(OpCode code, std::size_t index, const Matrix<3, 3> &transform, const Vector<3> &offset);
+    void addReduction(OpCode code, std::size_t count);
+    void calculateMaxStackSize();
+    void shift(const Vector<3> &translation);
+
+    // Matrix::operator* goes through the generic matrix product - the transformations are applied for each leaf in each
+    // evaluation, so a plain 3x3 product is used instead
+    static Vector<3> multiply(const Matrix<3, 3> &matrix, const Vector<3> &v) {
+        const double *m = matrix.begin();
+        return {m[0]*v[0] + m[1]*v[1] + m[2]*v[2],
+                m[3]*v[0] + m[4]*v[1] + m[5]*v[2],
+                m[6]*v[0] + m[7]*v[1] + m[8]*v[2]};
+    }
+
+    Vector<3> evaluate(const Vector<3> &n, Vector<3> *stack) const {
+        std::size_t stackSize{};
+        for (const auto &op : this->program) {
+            switch (op.code) {
+                case OpCode::PRIMITIVE: {
+                    Vector<3> localN = XCSupportProgram::multiply(op.transformTransposed, n);
+                    Vector<3> localSupport = std::visit([&localN](const auto &primitive) {
+                        // Qualified call - the type is known, so there is no need for the virtual dispatch
+                        using PrimitiveType = std::decay_t<decltype(primitive)>;
+                        return primitive.PrimitiveType::getSupportPoint(localN);
+                    }, this->primitives[op.index]);
+                    stack[stackSize++] = XCSupportProgram::multiply(op.transform, localSupport) + op.offset;
+                    break;
+                }
+                case OpCode::GENERIC: {
+                    Vector<3> localN = XCSupportProgram::multiply(op.transformTransposed, n);
+                    Vector<3> localSupport = this->generics[op.index]->getSupportPoint(localN);
+                    stack[stackSize++] = XCSupportProgram::multiply(op.transform, localSupport) + op.offset;
+                    break;
+                }
+                case OpCode::CONSTANT:
+                    stack[stackSize++] = op.offset;
+                    break;
+                case OpCode::SUM: {
+                    std::size_t first = stackSize - op.index;
+                    for (std::size_t i = first + 1; i < stackSize; i++)
+                        stack[first] += stack[i];
+                    stackSize = first + 1;
+                    break;
+                }
+                case OpCode::MAX: {
+                    std::size_t first = stackSize - op.index;
+                    double maxProjection = stack[first] * n;
+                    for (std::size_t i = first + 1; i < stackSize; i++) {
+                        double projection = stack[i] * n;
+                        if (projection > maxProjection) {
+                            stack[first] = stack[i];
+                            maxProjection = projection;
+                        }
+                    }
+                    stackSize = first + 1;
+                    break;
+                }
+            }
+        }
+        return stack[0];
+    }
+
+public:
+    /**
+     * @brief Compiles the support function of @a geometry (which can be a tree of XCSum, XCDiff and XCMax nodes).
+     */
+    explicit XCSupportProgram(std::shared_ptr<AbstractXCGeometry> geometry);
+
+    [[nodiscard]] Vector<3> getSupportPoint(const Vector<3> &n) const override {
+        if (this->maxStackSize <= INLINE_STACK_SIZE) {
+            std::array<Vector<3>, INLINE_STACK_SIZE> stack;
+            return this->evaluate(n, stack.data());
+        } else {
+            std::vector<Vector<3>> stack(this->maxStackSize);
+            return this->evaluate(n, stack.data());
+        }
+    }
+
+    [[nodiscard]] Vector<3> getCenter() const override { return this->center; }
+    [[nodiscard]] double getCircumsphereRadius() const override { return this->circumsphereRadius; }
+    [[nodiscard]] double getInsphereRadius() const override { return this->insphereRadius; }
+
+    /**
+     * @brief Replaces the circumsphere and insphere radii taken from the source tree with near-tight ones and moves
+     * the geometry so that the circumsphere is centered in the origin.
+     * @details The radii of composite geometries (XCSum, XCDiff, XCMax) are only conservative estimates based on the
+     * radii of their children, which moreover are computed around the origin of the tree, not around its actual center.
+     * Here, support points are sampled on a grid of directions with the known maximal angular gap @f$ \delta @f$, the
+     * center @f$ c @f$ of the circumsphere is fitted to them and the radii are computed from the support function
+     * @f$ h @f$ of the geometry translated by @f$ -c @f$: the circumsphere radius is @f$ \max h / \cos\delta @f$ and
+     * the insphere radius is @f$ \min h - R \delta @f$ (h is Lipschitz with the constant R equal to the circumsphere
+     * radius), so both remain conservative. The old bounds are kept if they are tighter. If the fitted center does not
+     * shrink the circumsphere by at least 1%, the geometry is not moved.
+     * @return the vector @f$ c @f$ by which the geometry was moved back (the original geometry is the current one
+     * translated by @f$ c @f$), or the zero vector if it was not moved
+     */
+    Vector<3> fitBoundingSpheres();
+
+    /**
+     * @brief Returns the box enclosing the geometry, with edges parallel to the axes.
+     */
+    [[nodiscard]] const XCBoundingBox &getBoundingBox() const { return this->boundingBox; }
+
+    /**
+     * @brief Returns the number of operations in the program.
+     */
+    [[nodiscard]] std::size_t getProgramSize() const { return this->program.size(); }
+
+    /**
+     * @brief Returns the number of leaves of the program evaluated through the virtual
+     * AbstractXCGeometry::getSupportPoint.
+     */
+    [[nodiscard]] std::size_t getNumberOfGenericLeaves() const { return this->generics.size(); }
+
+    /**
+     * @brief Returns the geometry, from which the program was compiled.
+     */
+    [[nodiscard]] const std::shared_ptr<AbstractXCGeometry> &getSource() const { return this->source; }
+};
+
+
+#endif //RAMPACK_XCSUPPORTPROGRAM_H
@@ -69,12 +69,21 @@ public:
     /**
      * @brief Returns @a true, if two shapes, one with position @a pos1, orientation @a rot1 with geometry @a geom1 and
      * the second one with position @a pos2, orientation @a rot2 with geometry @a geom2 overlap.
-     * @details @a boundaryTolerance determines the numerical precision of reporting a missed overlap.
+     * @details @a boundaryTolerance determines the numerical precision of reporting a missed overlap. If
+     * @a separatingDirection is not @a nullptr and the shapes are found to be separated, the direction proving it is
+     * stored there (see XenoCollide::AreSeparatedAlong). In the rare case of a miss reported due to
+     * @a boundaryTolerance, it is left unchanged.
      */
     static bool Intersect(const XCGeometry &geom1, const Matrix<3, 3> &rot1, const Vector<3> &pos1,
                           const XCGeometry &geom2, const Matrix<3, 3> &rot2, const Vector<3> &pos2,
-                          double boundaryTolerance)
+                          double boundaryTolerance, Vector<3> *separatingDirection = nullptr)
     {
+        auto miss = [separatingDirection](const Vector<3> &direction) {
+            if (separatingDirection != nullptr)
+                *separatingDirection = direction;
+            return false;
+        };
+
         // v0 = center of Minkowski difference
         Vector<3> v0 = (rot2 * geom2.getCenter() + pos2) - (rot1 * geom1.getCenter() + pos1);
         // v0 and origin overlap ==> hit
@@ -86,7 +95,7 @@ public:
         Vector<3> v1 = TransformSupportVert(geom2, rot2, pos2, n) - TransformSupportVert(geom1, rot1, pos1, -n);
         // origin outside v1 support plane ==> miss
         if (v1 * n <= 0)
-            return false;
+            return miss(n);
 
         // v2 = support perpendicular to plane containing origin, v0 and v1
         n = v1 ^ v0;
@@ -96,7 +105,7 @@ public:
         Vector<3> v2 = TransformSupportVert(geom2, rot2, pos2, n) - TransformSupportVert(geom1, rot1, pos1, -n);
         // origin outside v2 support plane ==> miss
         if (v2 * n <= 0)
-            return false;
+            return miss(n);
 
         // v3 = support perpendicular to plane containing v0, v1 and v2
         n = (v1 - v0) ^ (v2 - v0);
@@ -115,7 +124,7 @@ public:
             Vector<3> v3 = TransformSupportVert(geom2, rot2, pos2, n) - TransformSupportVert(geom1, rot1, pos1, -n);
             // origin outside v3 support plane ==> miss
             if (v3 * n <= 0)
-                return false;
+                return miss(n);
 
             // If origin is outside (v1,v0,v3), then portal is invalid -- eliminate v2 and find new support outside face
             if ((v1 ^ v3) * v0 < 0) {
@@ -147,7 +156,9 @@ public:
 
                 // If the origin is outside the support plane or the boundary is thin enough, we have a miss
                 n = n.normalized();
-                if (-(v4 * n) >= 0 || (v4 - v3) * n <= boundaryTolerance)
+                if (-(v4 * n) >= 0)
+                    return miss(n);
+                if ((v4 - v3) * n <= boundaryTolerance)
                     return false;
 
                 // Test origin against the three planes that separate the new portal candidates: (v1,v4,v0) (v2,v4,v0) (v3,v4,v0)
@@ -166,6 +177,24 @@ public:
             }
         }
     }
+
+    /**
+     * @brief Returns @a true, if the shapes (with the same parameters as in XenoCollide::Intersect) are separated by
+     * a plane perpendicular to @a direction.
+     * @details It requires only two support point evaluations, so it is a cheap early exit if a direction which
+     * separated the shapes in the past is known - usually it still does after small moves. The direction points
+     * (roughly) from the second shape to the first one, the same as the one found by XenoCollide::Intersect. A
+     * @a false result does not mean that the shapes overlap.
+     */
+    static bool AreSeparatedAlong(const XCGeometry &geom1, const Matrix<3, 3> &rot1, const Vector<3> &pos1,
+                                  const XCGeometry &geom2, const Matrix<3, 3> &rot2, const Vector<3> &pos2,
+                                  const Vector<3> &direction)
+    {
+        // The origin lies outside the support plane of the Minkowski difference ==> miss
+        Vector<3> support = TransformSupportVert(geom2, rot2, pos2, direction)
+                            - TransformSupportVert(geom1, rot1, pos1, -direction);
+        return support * direction <= 0;
+    }
 };
 
 
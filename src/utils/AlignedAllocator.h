@@ -0,0 +1,52 @@
+#ifndef RAMPACK_ALIGNEDALLOCATOR_H
+#define RAMPACK_ALIGNEDALLOCATOR_H
+
+#include <cstddef>
+#include <new>
+#include <vector>
+
+
+/**
+ * @brief Allocator for STL containers guaranteeing that the storage starts at an address aligned to @a ALIGNMENT
+ * bytes (cache line size by default).
+ * @details It is used for large, contiguous arrays streamed in hot loops, so that no cache line is shared between the
+ * beginning of the array and some unrelated data and vector loads of consecutive elements are aligned.
+ */
+template<typename T, std::size_t ALIGNMENT = 64>
+class AlignedAllocator {
+    static_assert(ALIGNMENT >= alignof(T), "ALIGNMENT weaker than the natural alignment of T");
+    static_assert((ALIGNMENT & (ALIGNMENT - 1)) == 0, "ALIGNMENT has to be a power of 2");
+
+public:
+    using value_type = T;
+
+    template<typename U>
+    struct rebind {
+        using other = AlignedAllocator<U, ALIGNMENT>;
+    };
+
+    AlignedAllocator() noexcept = default;
+
+    template<typename U>
+    explicit AlignedAllocator(const AlignedAllocator<U, ALIGNMENT> &) noexcept { }
+
+    [[nodiscard]] T *allocate(std::size_t n) {
+        return static_cast<T*>(::operator new(n * sizeof(T), std::align_val_t{ALIGNMENT}));
+    }
+
+    void deallocate(T *ptr, [[maybe_unused]] std::size_t n) noexcept {
+        ::operator delete(ptr, std::align_val_t{ALIGNMENT});
+    }
+
+    friend bool operator==(const AlignedAllocator &, const AlignedAllocator &) { return true; }
+    friend bool operator!=(const AlignedAllocator &, const AlignedAllocator &) { return false; }
+};
+
+/**
+ * @brief std::vector with the storage aligned to @a ALIGNMENT bytes.
+ */
+template<typename T, std::size_t ALIGNMENT = 64>
+using AlignedVector = std::vector<T, AlignedAllocator<T, ALIGNMENT>>;
+
+
+#endif //RAMPACK_ALIGNEDALLOCATOR_H
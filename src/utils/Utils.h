@@ -56,8 +56,8 @@ std::string quoted(const std::string &str);
 void die(const std::string &reason);
 void die(const std::string &reason, Logger &logger);
 
-template <typename T>
-std::size_t get_vector_memory_usage(const std::vector<T> &vec) {
+template <typename T, typename Allocator>
+std::size_t get_vector_memory_usage(const std::vector<T, Allocator> &vec) {
     return vec.capacity() * sizeof(T);
 }
 
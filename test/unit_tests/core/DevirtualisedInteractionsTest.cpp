@@ -0,0 +1,36 @@
+#include <catch2/catch.hpp>
+#include <memory>
+#include <typeinfo>
+
+#include "core/DevirtualisedInteractions.h"
+#include "core/interactions/LennardJonesInteraction.h"
+
+
+namespace {
+    template<typename ConcreteInteraction>
+    bool is_visited_as(const Interaction &interaction) {
+        return visit_devirtualised_interaction(interaction, [](const auto &concreteInteraction) {
+            return typeid(decltype(concreteInteraction)) == typeid(const ConcreteInteraction &);
+        });
+    }
+}
+
+TEST_CASE("DevirtualisedInteractions") {
+    SECTION("hard sphere") {
+        SphereTraits traits(0.5);
+        CHECK(get_devirtualised_interaction(traits.getInteraction()) == DevirtualisedInteraction::SPHERE);
+        CHECK(is_visited_as<SphereTraits::HardInteraction>(traits.getInteraction()));
+    }
+
+    SECTION("spherocylinder") {
+        SpherocylinderTraits traits(2, 0.5);
+        CHECK(get_devirtualised_interaction(traits.getInteraction()) == DevirtualisedInteraction::SPHEROCYLINDER);
+        CHECK(is_visited_as<SpherocylinderTraits>(traits.getInteraction()));
+    }
+
+    SECTION("soft sphere falls back to the generic interaction") {
+        SphereTraits traits(0.5, std::make_shared<LennardJonesInteraction>(1, 1));
+        CHECK(get_devirtualised_interaction(traits.getInteraction()) == DevirtualisedInteraction::GENERIC);
+        CHECK(is_visited_as<Interaction>(traits.getInteraction()));
+    }
+}
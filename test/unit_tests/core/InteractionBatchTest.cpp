@@ -0,0 +1,100 @@
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "core/InteractionBatch.h"
+#include "core/FreeBoundaryConditions.h"
+#include "core/shapes/SphereTraits.h"
+#include "core/shapes/KMerTraits.h"
+#include "core/shapes/SpherocylinderTraits.h"
+#include "core/shapes/PolyspherocylinderTraits.h"
+#include "core/shapes/SmoothWedgeTraits.h"
+
+
+namespace {
+    // Compares Interaction::countOverlapsInBatch with Interaction::overlapBetween for random neighbours of a particle
+    // in the origin
+    void check_batch_against_pair_tests(const Interaction &interaction, std::size_t numCentres, double halfSize) {
+        std::mt19937 mt(1234);
+        std::uniform_real_distribution<double> posDist(-halfSize, halfSize);
+        std::uniform_real_distribution<double> angleDist(0, 2*M_PI);
+        std::uniform_int_distribution<std::size_t> centreDist(0, numCentres - 1);
+        FreeBoundaryConditions fbc;
+
+        for (std::size_t trial{}; trial < 20; trial++) {
+            Vector<3> pos1{posDist(mt), posDist(mt), posDist(mt)};
+            auto orientation1 = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+            std::size_t centre1 = centreDist(mt);
+
+            InteractionBatch batch;
+            batch.reset(interaction.needsBatchOrientations());
+            std::size_t expectedOverlaps{};
+            for (std::size_t i{}; i < 30; i++) {
+                Vector<3> pos2{posDist(mt), posDist(mt), posDist(mt)};
+                auto orientation2 = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+                std::size_t centre2 = centreDist(mt);
+                batch.add(pos2, centre2, orientation2);
+                if (interaction.overlapBetween(pos1, orientation1, centre1, pos2, orientation2, centre2, fbc))
+                    expectedOverlaps++;
+            }
+            batch.calculateDistances2(pos1);
+
+            CHECK(interaction.countOverlapsInBatch(pos1, orientation1, centre1, batch, false) == expectedOverlaps);
+            CHECK(interaction.countOverlapsInBatch(pos1, orientation1, centre1, batch, true)
+                  == std::min(expectedOverlaps, std::size_t{1}));
+        }
+    }
+}
+
+TEST_CASE("InteractionBatch: overlaps") {
+    SECTION("hard spheres") {
+        SphereTraits traits(0.5);
+        check_batch_against_pair_tests(traits.getInteraction(), 1, 1.5);
+    }
+
+    SECTION("polyspheres") {
+        KMerTraits traits(3, 0.5, 0.4);
+        check_batch_against_pair_tests(traits.getInteraction(), 3, 1.5);
+    }
+
+    SECTION("spherocylinders") {
+        SpherocylinderTraits traits(2, 0.5);
+        check_batch_against_pair_tests(traits.getInteraction(), 1, 2.5);
+    }
+
+    SECTION("polyspherocylinders") {
+        using Data = PolyspherocylinderTraits::SpherocylinderData;
+        PolyspherocylinderTraits::PolyspherocylinderGeometry geometry({Data{{0, 0, 0}, {0, 0, 1}, 0.5},
+                                                                       Data{{0, 0, 1.5}, {0.5, 0, 0.5}, 0.3}},
+                                                                      std::nullopt, std::nullopt);
+        PolyspherocylinderTraits traits(geometry);
+        check_batch_against_pair_tests(traits.getInteraction(), 2, 2.5);
+    }
+
+    SECTION("XenoCollide") {
+        SmoothWedgeTraits traits(0.6, 0.4, 2);
+        check_batch_against_pair_tests(traits.getInteraction(), 1, 2.5);
+    }
+
+    SECTION("default implementation") {
+        // Many interaction centres - XenoCollideTraits falls back to the default implementation
+        SmoothWedgeTraits traits(0.6, 0.4, 2, 2);
+        check_batch_against_pair_tests(traits.getInteraction(), 2, 2.5);
+    }
+}
+
+TEST_CASE("InteractionBatch: common centre") {
+    InteractionBatch batch;
+    batch.reset(false);
+    batch.add({1, 2, 3}, 2);
+    batch.add({2, 3, 4}, 2);
+    CHECK(batch.hasCommonCentre());
+    batch.add({3, 4, 5}, 1);
+    CHECK_FALSE(batch.hasCommonCentre());
+
+    batch.calculateDistances2({1, 1, 1});
+    CHECK(batch.getDistance2(2) == 4 + 9 + 16);
+
+    batch.reset(false);
+    CHECK(batch.empty());
+    CHECK(batch.hasCommonCentre());
+}
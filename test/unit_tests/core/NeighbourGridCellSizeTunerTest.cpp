@@ -0,0 +1,46 @@
+#include <catch2/catch.hpp>
+
+#include "core/NeighbourGridCellSizeTuner.h"
+
+TEST_CASE("NeighbourGridCellSizeTuner") {
+    NeighbourGridCellSizeTuner tuner({0.2, 1, 2}, 2, 0.1);
+    // Durations of cycles for consecutive candidates - the first one for each candidate is not counted
+    auto measureAll = [&tuner](double density) {
+        std::vector<bool> factorChanged;
+        for (double microseconds : {100., 5., 5., 100., 3., 4., 100., 6., 6.})
+            factorChanged.push_back(tuner.registerCycle(microseconds, density));
+        return factorChanged;
+    };
+
+    REQUIRE_FALSE(tuner.isTuned());
+    REQUIRE(tuner.getFactor() == 0.2);
+
+    SECTION("tuning") {
+        auto factorChanged = measureAll(1);
+
+        CHECK(factorChanged == std::vector<bool>{false, false, true, false, false, true, false, false, true});
+        CHECK(tuner.isTuned());
+        CHECK(tuner.getFactor() == 1);
+        CHECK(tuner.getTunings() == 1);
+    }
+
+    SECTION("density change") {
+        measureAll(1);
+
+        CHECK_FALSE(tuner.registerCycle(100, 1.05));
+        CHECK(tuner.isTuned());
+        CHECK(tuner.registerCycle(100, 1.2));
+        CHECK_FALSE(tuner.isTuned());
+        CHECK(tuner.getFactor() == 0.2);
+
+        measureAll(1.2);
+        CHECK(tuner.isTuned());
+        CHECK(tuner.getTunings() == 2);
+    }
+
+    SECTION("invalid arguments") {
+        CHECK_THROWS(NeighbourGridCellSizeTuner({}, 2, 0.1));
+        CHECK_THROWS(NeighbourGridCellSizeTuner({0.2, 0}, 2, 0.1));
+        CHECK_THROWS(NeighbourGridCellSizeTuner({0.2, 1}, 0, 0.1));
+    }
+}
@@ -4,6 +4,11 @@
 
 #include <catch2/catch.hpp>
 
+#include <random>
+#include <set>
+#include <cmath>
+#include <numeric>
+
 #include "core/NeighbourGrid.h"
 
 namespace {
@@ -171,3 +176,244 @@ TEST_CASE("NeighbourGrid") {
         }
     }
 }
+
+TEST_CASE("NeighbourGrid: rescale") {
+    NeighbourGrid neighbourGrid({10, 10, 10}, 2.4, 3);
+    neighbourGrid.add(0, {1, 1, 1});
+    neighbourGrid.add(1, {3, 1, 1});
+    neighbourGrid.add(2, {9, 9, 9});
+
+    SECTION("the same cell divisions") {
+        REQUIRE(neighbourGrid.rescale(TriclinicBox(std::array<double, 3>{11, 11, 11}), 2.4));
+
+        // Objects are preserved in cells with the same relative coordinates
+        CHECK(make_vector(neighbourGrid.getCell(Vector<3>{1.1, 1.1, 1.1})) == std::vector<std::size_t>{0});
+        CHECK(make_vector(neighbourGrid.getCell(Vector<3>{3.3, 1.1, 1.1})) == std::vector<std::size_t>{1});
+        CHECK(neighbourGrid.getObjectCellNo(2) == neighbourGrid.positionToCellNo({9.9, 9.9, 9.9}));
+        // Translations are updated
+        for (const auto &cell : neighbourGrid.getNeighbouringCells(Vector<3>{1.1, 1.1, 1.1}))
+            for (auto idx : cell.getNeighbours())
+                if (idx == 2)
+                    CHECK(cell.getTranslation() == Vector<3>{-11, -11, -11});
+    }
+
+    SECTION("different cell divisions") {
+        CHECK_FALSE(neighbourGrid.rescale(TriclinicBox(std::array<double, 3>{13, 10, 10}), 2.4));
+        CHECK(neighbourGrid.getCellDivisions() == std::array<std::size_t, 3>{4, 4, 4});
+    }
+
+    SECTION("remove without position") {
+        neighbourGrid.remove(1);
+        neighbourGrid.remove(1);
+
+        CHECK(make_vector(neighbourGrid.getCell(Vector<3>{3, 1, 1})).empty());
+        CHECK(neighbourGrid.getObjectCellNo(1) == std::numeric_limits<std::size_t>::max());
+        CHECK(make_vector(neighbourGrid.getCell(Vector<3>{1, 1, 1})) == std::vector<std::size_t>{0});
+    }
+}
+
+TEST_CASE("NeighbourGrid: build") {
+    NeighbourGrid sequentialGrid({10, 10, 10}, 2.4, 6);
+    NeighbourGrid bulkGrid({10, 10, 10}, 2.4, 6);
+    std::vector<Vector<3>> positions{{1, 1, 1}, {9, 9, 9}, {1.5, 1, 1}, {2, 1, 1}, {9, 9, 8}, {5, 5, 5}};
+    std::vector<std::pair<std::size_t, std::size_t>> objects;
+    for (std::size_t i{}; i < positions.size(); i++) {
+        sequentialGrid.add(i, positions[i]);
+        objects.emplace_back(i, bulkGrid.positionToCellNo(positions[i]));
+    }
+    bulkGrid.add(0, {5, 5, 5});     // should be cleared
+
+    bulkGrid.build(objects, 4);
+
+    for (const auto &pos : positions) {
+        CHECK(make_vector(bulkGrid.getCell(pos)) == make_vector(sequentialGrid.getCell(pos)));
+        CHECK(bulkGrid.getNeighbours(pos) == sequentialGrid.getNeighbours(pos));
+    }
+    CHECK(make_vector(bulkGrid.getCell(Vector<3>{1, 1, 1})) == std::vector<std::size_t>{0, 2, 3});
+    CHECK(bulkGrid.getObjectCellNo(4) == bulkGrid.positionToCellNo({9, 9, 8}));
+}
+
+TEST_CASE("NeighbourGrid: cell growth and compaction") {
+    constexpr std::size_t NUM_OBJECTS = 20000;
+    NeighbourGrid neighbourGrid({10, 10, 10}, 2.4, NUM_OBJECTS + 1);
+    std::vector<std::size_t> expected;
+    for (std::size_t i{}; i < NUM_OBJECTS; i++) {
+        neighbourGrid.add(i, {1, 1, 1});
+        if (i % 2 == 1)
+            expected.push_back(i);
+    }
+    neighbourGrid.add(NUM_OBJECTS, {9, 9, 9});
+    for (std::size_t i{}; i < NUM_OBJECTS; i += 2)
+        neighbourGrid.remove(i);
+
+    REQUIRE_THAT(make_vector(neighbourGrid.getCell(Vector<3>{1, 1, 1})), Catch::UnorderedEquals(expected));
+    REQUIRE(neighbourGrid.compactIfNeeded());
+    CHECK_FALSE(neighbourGrid.compactIfNeeded());
+    CHECK_THAT(make_vector(neighbourGrid.getCell(Vector<3>{1, 1, 1})), Catch::UnorderedEquals(expected));
+    CHECK(make_vector(neighbourGrid.getCell(Vector<3>{9, 9, 9})) == std::vector<std::size_t>{NUM_OBJECTS});
+    CHECK(neighbourGrid.getNeighbours({9, 9, 9}).size() == NUM_OBJECTS / 2 + 1);
+
+    // Cells should be still able to grow after compaction
+    neighbourGrid.add(0, {9, 9, 9});
+    neighbourGrid.add(2, {9, 9, 9});
+    CHECK(make_vector(neighbourGrid.getCell(Vector<3>{9, 9, 9})) == std::vector<std::size_t>{NUM_OBJECTS, 0, 2});
+}
+
+TEST_CASE("NeighbourGrid: crowded cell") {
+    // More objects than fit in 16 bits
+    constexpr std::size_t NUM_OBJECTS = 70000;
+    NeighbourGrid sequentialGrid({10, 10, 10}, 2.4, NUM_OBJECTS);
+    NeighbourGrid bulkGrid({10, 10, 10}, 2.4, NUM_OBJECTS);
+    std::vector<std::pair<std::size_t, std::size_t>> objects;
+    for (std::size_t i{}; i < NUM_OBJECTS; i++) {
+        sequentialGrid.add(i, {1, 1, 1});
+        objects.emplace_back(i, bulkGrid.positionToCellNo({1, 1, 1}));
+    }
+    bulkGrid.build(objects, 4);
+
+    std::vector<std::size_t> expected(NUM_OBJECTS);
+    std::iota(expected.begin(), expected.end(), 0);
+    CHECK(make_vector(sequentialGrid.getCell(Vector<3>{1, 1, 1})) == expected);
+    CHECK(make_vector(bulkGrid.getCell(Vector<3>{1, 1, 1})) == expected);
+    sequentialGrid.remove(NUM_OBJECTS - 1);
+    CHECK(sequentialGrid.getCell(Vector<3>{1, 1, 1}).size() == NUM_OBJECTS - 1);
+
+    // Object cells and slots, the current block of the cell (at least NUM_OBJECTS slots) and the previous one (at least
+    // NUM_OBJECTS/2 slots, not freed before compaction). Both blocks span many overflow pages
+    CHECK(sequentialGrid.getMemoryUsage() >= (2 + 1 + 0.5) * NUM_OBJECTS * sizeof(std::uint32_t));
+}
+
+TEST_CASE("NeighbourGrid: move") {
+    NeighbourGrid neighbourGrid({10, 10, 10}, 2.4, 4);
+    neighbourGrid.add(0, {1, 1, 1});
+    neighbourGrid.add(1, {1.5, 1, 1});
+    neighbourGrid.add(2, {2, 1, 1});
+    neighbourGrid.add(3, {9, 9, 9});
+
+    SECTION("within the same cell") {
+        CHECK_FALSE(neighbourGrid.move(1, Vector<3>{1, 2, 1}));
+        CHECK(make_vector(neighbourGrid.getCell(Vector<3>{1, 1, 1})) == std::vector<std::size_t>{0, 1, 2});
+    }
+
+    SECTION("to a different cell") {
+        CHECK(neighbourGrid.move(0, Vector<3>{9, 9, 8}));
+        CHECK(neighbourGrid.getObjectCellNo(0) == neighbourGrid.positionToCellNo({9, 9, 9}));
+        CHECK_THAT(make_vector(neighbourGrid.getCell(Vector<3>{1, 1, 1})),
+                   Catch::UnorderedEquals(std::vector<std::size_t>{1, 2}));
+        CHECK_THAT(make_vector(neighbourGrid.getCell(Vector<3>{9, 9, 9})),
+                   Catch::UnorderedEquals(std::vector<std::size_t>{0, 3}));
+
+        // Relocated members should still be removable and movable
+        neighbourGrid.remove(2);
+        CHECK(neighbourGrid.move(1, neighbourGrid.positionToCellNo({5, 5, 5})));
+        CHECK(make_vector(neighbourGrid.getCell(Vector<3>{1, 1, 1})).empty());
+        CHECK(make_vector(neighbourGrid.getCell(Vector<3>{5, 5, 5})) == std::vector<std::size_t>{1});
+    }
+}
+
+TEST_CASE("NeighbourGrid: extended neighbouring cells") {
+    // 4 cells of size 2.5 divided into 2 subcells each (in each direction) and 2 reflected layers on each edge
+    NeighbourGrid neighbourGrid(TriclinicBox(10), 2.5, 5, 2, 2);
+    neighbourGrid.add(0, {0.5, 0.5, 0.5});
+    neighbourGrid.add(1, {2.9, 0.5, 0.5});
+    neighbourGrid.add(2, {4.0, 0.5, 0.5});
+    neighbourGrid.add(3, {9.5, 0.5, 0.5});
+    neighbourGrid.add(4, {8.2, 0.5, 0.5});
+
+    REQUIRE(neighbourGrid.getCellDivisions() == std::array<std::size_t, 3>{8, 8, 8});
+
+    auto collect = [&neighbourGrid](std::size_t layers) {
+        std::vector<std::size_t> neighbours;
+        for (const auto &cell : neighbourGrid.getExtendedNeighbouringCells({0.5, 0.5, 0.5}, layers)) {
+            for (auto idx : cell.getNeighbours()) {
+                neighbours.push_back(idx);
+                if (idx == 4)
+                    CHECK(cell.getTranslation() == Vector<3>{-10, 0, 0});
+            }
+        }
+        return neighbours;
+    };
+
+    SECTION("1 layer") {
+        CHECK_THAT(collect(1), Catch::UnorderedEquals(std::vector<std::size_t>{0, 3}));
+    }
+
+    SECTION("2 layers") {
+        CHECK_THAT(collect(2), Catch::UnorderedEquals(std::vector<std::size_t>{0, 1, 3, 4}));
+    }
+
+    SECTION("too many layers") {
+        CHECK_THROWS(neighbourGrid.getExtendedNeighbouringCells({0.5, 0.5, 0.5}, 3));
+    }
+
+    SECTION("too few real cells") {
+        CHECK_THROWS(NeighbourGrid(TriclinicBox(10), 6, 5, 2, 1));
+    }
+}
+
+TEST_CASE("NeighbourGrid: pruned stencils") {
+    // 3 cells of size 2.5 divided into 3 subcells each (in each direction) in sheared boxes - all points closer than
+    // 2.5 have to be found, although some cells in the corners of the 7 x 7 x 7 cube are not visited
+    constexpr double cellSize = 2.5;
+    constexpr std::size_t numPoints = 200;
+    constexpr std::size_t numQueries = 50;
+    auto box = GENERATE(TriclinicBox(std::array<Vector<3>, 3>{Vector<3>{9, 0, 0}, {3, 9, 0}, {1, 2, 9}}),
+                        TriclinicBox(std::array<Vector<3>, 3>{Vector<3>{9, 0, 0}, {4.5, 9, 0}, {-1, 3, 9}}),
+                        TriclinicBox(9));
+    NeighbourGrid neighbourGrid(box, cellSize, numPoints, 3, 3);
+    REQUIRE(neighbourGrid.getCellDivisions() == std::array<std::size_t, 3>{9, 9, 9});
+    REQUIRE(neighbourGrid.getCellSubdivisions() == 3);
+
+    std::mt19937 mt(1234);
+    std::uniform_real_distribution<double> unif(0, 1);
+    std::vector<Vector<3>> points(numPoints);
+    for (std::size_t i{}; i < numPoints; i++) {
+        points[i] = box.relativeToAbsolute({unif(mt), unif(mt), unif(mt)});
+        neighbourGrid.add(i, points[i]);
+    }
+
+    auto sides = box.getSides();
+    std::size_t missingNeighbours{};
+    for (std::size_t queryIdx{}; queryIdx < numQueries; queryIdx++) {
+        const auto &query = points[queryIdx];
+        // Neighbours are identified by the index and the translation in the units of box sides
+        using Neighbour = std::array<long, 4>;
+        std::set<Neighbour> found;
+        std::size_t numCells{};
+        for (const auto &cell : neighbourGrid.getNeighbouringCells(query)) {
+            numCells++;
+            Vector<3> translation = box.absoluteToRelative(cell.getTranslation());
+            for (auto idx : cell.getNeighbours()) {
+                found.insert({static_cast<long>(idx), std::lround(translation[0]), std::lround(translation[1]),
+                              std::lround(translation[2])});
+            }
+        }
+        CHECK(numCells < 7*7*7);
+
+        for (std::size_t idx{}; idx < numPoints; idx++) {
+            for (long i = -1; i <= 1; i++) {
+                for (long j = -1; j <= 1; j++) {
+                    for (long k = -1; k <= 1; k++) {
+                        Vector<3> image = points[idx] + static_cast<double>(i) * sides[0]
+                                          + static_cast<double>(j) * sides[1] + static_cast<double>(k) * sides[2];
+                        Neighbour neighbour{static_cast<long>(idx), i, j, k};
+                        if ((image - query).norm() < cellSize && found.find(neighbour) == found.end())
+                            missingNeighbours++;
+                    }
+                }
+            }
+        }
+    }
+    CHECK(missingNeighbours == 0);
+
+    SECTION("1 layer") {
+        std::size_t numCells{};
+        for ([[maybe_unused]] const auto &cell : neighbourGrid.getExtendedNeighbouringCells(points.front(), 1))
+            numCells++;
+        CHECK(numCells == 27);
+    }
+
+    SECTION("too few reflected layers") {
+        CHECK_THROWS(NeighbourGrid(box, cellSize, numPoints, 2, 3));
+    }
+}
@@ -5,17 +5,27 @@
 #include <catch2/catch.hpp>
 #include <cmath>
 #include <sstream>
+#include <random>
 
 #include "matchers/PackingApproxPositionsCatchMatcher.h"
 #include "matchers/VectorApproxMatcher.h"
+#include "matchers/MatrixApproxMatcher.h"
 
 #include "mocks/MockShapeGeometry.h"
 
 #include "core/Packing.h"
 #include "core/PeriodicBoundaryConditions.h"
 #include "core/Interaction.h"
+#include "core/shapes/SmoothWedgeTraits.h"
 
 namespace {
+    // Positions may be stored in single precision relative to the box (RAMPACK_SINGLE_PRECISION_POSITIONS)
+#ifdef RAMPACK_SINGLE_PRECISION_POSITIONS
+    constexpr double POSITION_EPSILON = 1e-6;
+#else
+    constexpr double POSITION_EPSILON = 1e-9;
+#endif
+
     class SphereHardCoreInteraction : public Interaction {
     private:
         double radius;
@@ -81,6 +91,33 @@ namespace {
 
         [[nodiscard]] std::vector<Vector<3>> getInteractionCentres() const override { return {{0, 0, 0}, {1, 0, 0}}; }
     };
+
+    // Large sphere in the origin and a small one on the x axis
+    class LollipopHardCoreInteraction : public Interaction {
+    private:
+        static constexpr std::array<double, 2> RADII = {1, 0.2};
+
+    public:
+        [[nodiscard]] bool hasHardPart() const override { return true; }
+        [[nodiscard]] bool hasSoftPart() const override { return false; }
+        [[nodiscard]] bool hasWallPart() const override { return false; }
+        [[nodiscard]] bool isConvex() const override { return false; }
+
+        [[nodiscard]] bool overlapBetween(const Vector<3> &pos1,
+                                          [[maybe_unused]] const Matrix<3, 3> &orientaton1, std::size_t idx1,
+                                          const Vector<3> &pos2,
+                                          [[maybe_unused]] const Matrix<3, 3> &orientaton2, std::size_t idx2,
+                                          const BoundaryConditions &bc) const override
+        {
+            return bc.getDistance2(pos1, pos2) < std::pow(RADII[idx1] + RADII[idx2], 2);
+        }
+
+        [[nodiscard]] double getRangeRadius() const override { return 2*RADII[0]; }
+        [[nodiscard]] std::vector<Vector<3>> getInteractionCentres() const override { return {{0, 0, 0}, {1.5, 0, 0}}; }
+        [[nodiscard]] std::vector<double> getInteractionCentreRanges() const override {
+            return {RADII.begin(), RADII.end()};
+        }
+    };
 }
 
 TEST_CASE("Packing: single interaction center operations") {
@@ -105,7 +142,7 @@ TEST_CASE("Packing: single interaction center operations") {
             CHECK(packing.getBox().getHeights()[1] == Approx(5.5));
             CHECK(packing.getBox().getHeights()[2] == Approx(5.5));
             CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.55, 0.55, 0.55}, {4.95, 0.55, 0.55},
-                                                                 {2.75, 2.75, 4.4}}, 1e-9));
+                                                                 {2.75, 2.75, 4.4}}, POSITION_EPSILON));
         }
 
         SECTION("hard core downward without overlapping") {
@@ -116,7 +153,7 @@ TEST_CASE("Packing: single interaction center operations") {
             CHECK(packing.getBox().getHeights()[1] == Approx(2.55));
             CHECK(packing.getBox().getHeights()[2] == Approx(2.55));
             CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.255, 0.255, 0.255}, {2.295, 0.255, 0.255},
-                                                                 {1.275, 1.275, 2.04}}, 1e-9));
+                                                                 {1.275, 1.275, 2.04}}, POSITION_EPSILON));
         }
 
         SECTION("hard core downward with overlapping") {
@@ -131,7 +168,8 @@ TEST_CASE("Packing: single interaction center operations") {
                 CHECK(packing.getBox().getHeights()[0] == Approx(5));
                 CHECK(packing.getBox().getHeights()[1] == Approx(5));
                 CHECK(packing.getBox().getHeights()[2] == Approx(5));
-                CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {4.5, 0.5, 0.5}, {2.5, 2.5, 4.0}}, 1e-9));
+                CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {4.5, 0.5, 0.5},
+                                                                     {2.5, 2.5, 4.0}}, POSITION_EPSILON));
             }
         }
 
@@ -152,17 +190,20 @@ TEST_CASE("Packing: single interaction center operations") {
             // For scale 5, translation {2, 2.5, -3.5} places particle 2 at {4.5, 5, 0.5}, while particle 1 is at
             // {4.5, 0.5, 0.5} - they touch through pbc on y coordinate. Do a little bit less prevents overlap
             CHECK(packing.tryTranslation(2, {2, 2.45, -3.5}, hardCore) == 0);
-            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {4.5, 0.5, 0.5}, {2.5, 2.5, 4.0}}, 1e-9));
+            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {4.5, 0.5, 0.5},
+                                                                 {2.5, 2.5, 4.0}}, POSITION_EPSILON));
             SECTION("accepting the move") {
                 packing.acceptTranslation();
-                CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {4.5, 0.5, 0.5}, {4.5, 4.95, 0.5}}, 1e-9));
+                CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {4.5, 0.5, 0.5},
+                                                                     {4.5, 4.95, 0.5}}, POSITION_EPSILON));
             }
         }
 
         SECTION("overlapping") {
             // Same as above, but we do more instead of less
             CHECK(packing.tryTranslation(2, {2, 2.55, -3.5}, hardCore) == inf);
-            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {4.5, 0.5, 0.5}, {2.5, 2.5, 4.0}}, 1e-9));
+            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {4.5, 0.5, 0.5},
+                                                                 {2.5, 2.5, 4.0}}, POSITION_EPSILON));
         }
 
         SECTION("distance interaction") {
@@ -235,7 +276,8 @@ TEST_CASE("Packing: multiple interaction center moves") {
         SECTION("hard core without overlapping") {
             // For scale 0.5 dimers 0 and 1 are touching (through pbc). So a bit more should prevent any overlaps
             CHECK(packing.tryScaling(0.51, hardCore) == 0);
-            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.255, 0.255, 0.255}, {0.255, 1.785, 0.255}}, 1e-9));
+            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.255, 0.255, 0.255},
+                                                                 {0.255, 1.785, 0.255}}, POSITION_EPSILON));
         }
 
         SECTION("hard core downward with overlapping") {
@@ -244,7 +286,8 @@ TEST_CASE("Packing: multiple interaction center moves") {
 
             SECTION("reverting the move") {
                 packing.revertScaling();
-                CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {0.5, 3.5, 0.5}}, 1e-9));
+                CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5},
+                                                                     {0.5, 3.5, 0.5}}, POSITION_EPSILON));
             }
         }
 
@@ -274,17 +317,18 @@ TEST_CASE("Packing: multiple interaction center moves") {
             // Translation {0, 1, 0} places particle 1 at {0.5, 4.5, 0.5}, while particle 1 is at
             // {0.5, 0.5, 0.5} - they touch through pbc on y coordinate. Do a little bit less prevents overlap
             CHECK(packing.tryTranslation(1, {0, 0.9, 0}, hardCore) == 0);
-            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {0.5, 3.5, 0.5}}, 1e-9));
+            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {0.5, 3.5, 0.5}}, POSITION_EPSILON));
             SECTION("accepting the move") {
                 packing.acceptTranslation();
-                CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {0.5, 4.4, 0.5}}, 1e-9));
+                CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5},
+                                                                     {0.5, 4.4, 0.5}}, POSITION_EPSILON));
             }
         }
 
         SECTION("overlapping") {
             // Same as above, but we do more instead of less
             CHECK(packing.tryTranslation(1, {0, 1.1, 0}, hardCore) == inf);
-            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {0.5, 3.5, 0.5}}, 1e-9));
+            CHECK_THAT(packing, HasParticlesWithApproxPositions({{0.5, 0.5, 0.5}, {0.5, 3.5, 0.5}}, POSITION_EPSILON));
         }
 
         SECTION("distance interaction") {
@@ -314,6 +358,25 @@ TEST_CASE("Packing: multiple interaction center moves") {
     }
 }
 
+TEST_CASE("Packing: interaction centres after many rotations") {
+    // Rotation matrices are not exactly orthogonal, but the interaction centres should stay coherent with (possibly
+    // normalized) orientations, also in quaternion builds, where orientations are never renormalized explicitly
+    DimerDistanceInteraction interaction{};
+    std::vector<Shape> shapes{Shape{{0.5, 0.5, 0.5}}, Shape{{0.5, 3.5, 0.5}}};
+    Packing packing({5, 5, 5}, std::move(shapes), std::make_unique<PeriodicBoundaryConditions>(), interaction);
+    auto rotation = (1 + 1e-9) * Matrix<3, 3>::rotation(0.1, 0.2, 0.3);
+
+    for (std::size_t i{}; i < 1000; i++) {
+        packing.tryRotation(0, rotation, interaction);
+        packing.acceptRotation();
+    }
+    double energy = packing.getTotalEnergy(interaction);
+    // Recalculates all interaction centres from the orientations
+    packing.setupForInteraction(interaction);
+
+    CHECK(packing.getTotalEnergy(interaction) == Approx(energy).epsilon(1e-12));
+}
+
 TEST_CASE("Packing: single interaction center overlap counting") {
     double radius = 0.5;
     SphereHardCoreInteraction hardCore(radius);
@@ -597,6 +660,302 @@ TEST_CASE("Packing: too big NG cell bug") {
     REQUIRE_NOTHROW(Packing({1.1, 100, 100}, std::move(shapes), std::move(pbc), hardCore));
 }
 
+TEST_CASE("Packing: shape access") {
+    double radius = 0.25;
+    SphereHardCoreInteraction hardCore(radius);
+    auto pbc = std::make_unique<PeriodicBoundaryConditions>();
+    std::vector<Shape> shapes;
+    shapes.emplace_back(Vector<3>{0.5, 0.5, 0.5}, Matrix<3, 3>::rotation(0, 0, M_PI/2));
+    shapes.emplace_back(Vector<3>{4.5, 0.5, 0.5});
+    shapes.emplace_back(Vector<3>{2.5, 2.5, 4.0}, Matrix<3, 3>::rotation(M_PI/2, 0, 0));
+    auto shapesCopy = shapes;
+    Packing packing({5, 5, 5}, std::move(shapes), std::move(pbc), hardCore);
+
+    // Positions and orientations are compared approximately, because they may be stored in single precision and as
+    // quaternions, respectively
+    SECTION("random access") {
+        CHECK_THAT(packing[1].getPosition(), IsApproxEqual(shapesCopy[1].getPosition(), POSITION_EPSILON));
+        CHECK_THAT(packing[1].getOrientation(), IsApproxEqual(shapesCopy[1].getOrientation(), 1e-14));
+        CHECK_THAT(packing.front().getPosition(), IsApproxEqual(shapesCopy.front().getPosition(), POSITION_EPSILON));
+        CHECK_THAT(packing.back().getPosition(), IsApproxEqual(shapesCopy.back().getPosition(), POSITION_EPSILON));
+        CHECK_THAT(packing.getPosition(2), IsApproxEqual(shapesCopy[2].getPosition(), POSITION_EPSILON));
+        CHECK_THAT(packing.getOrientation(2), IsApproxEqual(shapesCopy[2].getOrientation(), 1e-14));
+    }
+
+    SECTION("iteration") {
+        REQUIRE(std::distance(packing.begin(), packing.end()) == 3);
+        std::size_t i{};
+        for (const auto &shape : packing) {
+            CHECK_THAT(shape.getPosition(), IsApproxEqual(shapesCopy[i].getPosition(), POSITION_EPSILON));
+            CHECK_THAT(shape.getOrientation(), IsApproxEqual(shapesCopy[i].getOrientation(), 1e-14));
+            i++;
+        }
+    }
+
+    SECTION("accepted move") {
+        auto rotation = Matrix<3, 3>::rotation(0, M_PI/2, 0);
+        REQUIRE(packing.tryMove(1, {0, 1, 0}, rotation, hardCore) == 0);
+        packing.acceptMove();
+
+        CHECK_THAT(packing.getPosition(1), IsApproxEqual(Vector<3>{4.5, 1.5, 0.5}, POSITION_EPSILON));
+        CHECK_THAT(packing.getOrientation(1), IsApproxEqual(rotation, 1e-14));
+        CHECK_THAT(packing.getOrientation(0), IsApproxEqual(shapesCopy[0].getOrientation(), 1e-14));
+    }
+}
+
+TEST_CASE("Packing: particle reordering") {
+    double radius = 0.25;
+    DimerHardCoreInteraction hardCore(radius);
+    auto pbc = std::make_unique<PeriodicBoundaryConditions>();
+    std::vector<Shape> shapes;
+    shapes.emplace_back(Vector<3>{9.5, 9.5, 9.5});
+    shapes.emplace_back(Vector<3>{0.5, 0.5, 0.5}, Matrix<3, 3>::rotation(0, 0, M_PI/2));
+    shapes.emplace_back(Vector<3>{5.5, 0.5, 9.5});
+    shapes.emplace_back(Vector<3>{0.5, 5.5, 5.5}, Matrix<3, 3>::rotation(M_PI/2, 0, 0));
+    auto shapesCopy = shapes;
+    Packing packing({10, 10, 10}, std::move(shapes), std::move(pbc), hardCore);
+    packing.toggleOverlapCounting(true, hardCore);
+
+    packing.reorderParticles();
+
+    SECTION("order seen from the outside is preserved") {
+        REQUIRE(packing.size() == 4);
+        for (std::size_t i{}; i < packing.size(); i++) {
+            CHECK_THAT(packing[i].getPosition(), IsApproxEqual(shapesCopy[i].getPosition(), POSITION_EPSILON));
+            CHECK_THAT(packing.getOrientation(i), IsApproxEqual(shapesCopy[i].getOrientation(), 1e-14));
+        }
+        std::size_t i{};
+        for (const auto &shape : packing)
+            CHECK_THAT(shape.getPosition(), IsApproxEqual(shapesCopy[i++].getPosition(), POSITION_EPSILON));
+        CHECK(packing.getCachedNumberOfOverlaps() == 0);
+        CHECK(packing.countTotalOverlaps(hardCore, false) == 0);
+    }
+
+    SECTION("moves use original indices") {
+        // The translated particle 1 would have its first interaction centre exactly in the first centre of particle 3
+        CHECK(packing.tryTranslation(1, {0, 5, 5}, hardCore) == std::numeric_limits<double>::infinity());
+        REQUIRE(packing.tryTranslation(1, {0, 2, 0}, hardCore) == 0);
+        packing.acceptTranslation();
+        packing.reorderParticles();
+
+        CHECK_THAT(packing.getPosition(1), IsApproxEqual(Vector<3>{0.5, 2.5, 0.5}, POSITION_EPSILON));
+        CHECK_THAT(packing.getPosition(0), IsApproxEqual(shapesCopy[0].getPosition(), POSITION_EPSILON));
+        CHECK(packing.countTotalOverlaps(hardCore, false) == 0);
+    }
+}
+
+TEST_CASE("Packing: Verlet lists") {
+    double radius = 0.5;
+    SphereHardCoreInteraction hardCore(radius);
+    auto pbc = std::make_unique<PeriodicBoundaryConditions>();
+    // Distance 1.4 is within the interaction range plus the skin 0.5
+    std::vector<Shape> shapes{Shape{{1, 1, 1}}, Shape{{2.4, 1, 1}}, Shape{{9.8, 1, 1}}};
+    Packing packing({10, 10, 10}, std::move(shapes), std::move(pbc), hardCore);
+    packing.setVerletListSkin(0.5);
+
+    REQUIRE(packing.updateVerletLists());
+    CHECK_FALSE(packing.updateVerletLists());
+    CHECK(packing.getVerletListRebuilds() == 1);
+
+    SECTION("pairs approaching within the skin") {
+        REQUIRE(packing.tryTranslation(1, {-0.2, 0, 0}, hardCore) == 0);
+        packing.acceptTranslation();
+        CHECK_FALSE(packing.updateVerletLists());
+
+        CHECK(packing.tryTranslation(0, {0.21, 0, 0}, hardCore) == std::numeric_limits<double>::infinity());
+        CHECK(packing.tryTranslation(0, {0.19, 0, 0}, hardCore) == 0);
+        // Periodic image of particle 2
+        CHECK(packing.tryTranslation(0, {-0.21, 0, 0}, hardCore) == std::numeric_limits<double>::infinity());
+    }
+
+    SECTION("displacement larger than a half of the skin") {
+        // Not covered by the lists - neighbour grid should be used
+        CHECK(packing.tryTranslation(0, {0.5, 0, 0}, hardCore) == std::numeric_limits<double>::infinity());
+
+        REQUIRE(packing.tryTranslation(0, {0, 3, 0}, hardCore) == 0);
+        packing.acceptTranslation();
+        CHECK(packing.tryTranslation(0, {1.4, -2.5, 0}, hardCore) == std::numeric_limits<double>::infinity());
+        CHECK(packing.updateVerletLists());
+        CHECK(packing.getVerletListRebuilds() == 2);
+        CHECK(packing.tryTranslation(1, {-1.4, 2.5, 0}, hardCore) == std::numeric_limits<double>::infinity());
+        CHECK(packing.tryTranslation(1, {0.2, 0, 0}, hardCore) == 0);
+    }
+
+    SECTION("scaling") {
+        REQUIRE(packing.tryScaling({1.1, 1.1, 1.1}, hardCore) == 0);
+        packing.revertScaling();
+        CHECK_FALSE(packing.updateVerletLists());
+
+        REQUIRE(packing.tryScaling({1.1, 1.1, 1.1}, hardCore) == 0);
+        CHECK(packing.updateVerletLists());
+    }
+}
+
+TEST_CASE("Packing: neighbour grid cell size factor") {
+    double radius = 0.5;
+    SphereHardCoreInteraction hardCore(radius);
+    auto pbc = std::make_unique<PeriodicBoundaryConditions>();
+    std::vector<Shape> shapes{Shape{{1, 1, 1}}, Shape{{2.4, 1, 1}}, Shape{{9.8, 1, 1}}};
+    Packing packing({10, 10, 10}, std::move(shapes), std::move(pbc), hardCore);
+    double meanDistance = std::cbrt(1000./3);
+
+    REQUIRE(packing.getNeighbourGridCellSizeFactor() == Packing::DEFAULT_NEIGHBOUR_GRID_CELL_SIZE_FACTOR);
+    CHECK(packing.getNeighbourGridCellSize() == Approx(0.2 * meanDistance));
+    CHECK(packing.getNeighbourGridCellDivisions() == std::array<std::size_t, 3>{7, 7, 7});
+
+    SECTION("cells limited by the interaction range") {
+        packing.setNeighbourGridCellSizeFactor(0.1);
+
+        CHECK(packing.getNeighbourGridCellSize() == Approx(1));
+        CHECK(packing.getNeighbourGridCellDivisions() == std::array<std::size_t, 3>{10, 10, 10});
+        CHECK(packing.tryTranslation(2, {0.3, 0, 0}, hardCore) == std::numeric_limits<double>::infinity());
+    }
+
+    SECTION("cells too large for the neighbour grid") {
+        packing.setNeighbourGridCellSizeFactor(1);
+
+        CHECK(packing.getNeighbourGridCellSize() == 0);
+        CHECK(packing.tryTranslation(2, {0.3, 0, 0}, hardCore) == std::numeric_limits<double>::infinity());
+    }
+}
+
+TEST_CASE("Packing: interaction centres of different ranges") {
+    // Small centres are stored in a separate level of the neighbour grid with cells 2 times smaller
+    LollipopHardCoreInteraction lollipop;
+    auto pbc = std::make_unique<PeriodicBoundaryConditions>();
+    auto reversed = Matrix<3, 3>::rotation(0, 0, M_PI);
+    std::vector<Shape> shapes{
+        Shape{{1, 1, 1}}, Shape{{4.45, 1, 1}, reversed}, Shape{{8.2, 5, 1}}, Shape{{1, 5, 1}},
+        Shape{{1, 1, 5}}, Shape{{5, 1, 5}}, Shape{{1, 5, 5}}, Shape{{5, 5, 5}}, Shape{{1, 1, 8}}, Shape{{5, 5, 8}}
+    };
+    Packing packing({10, 10, 10}, std::move(shapes), std::move(pbc), lollipop);
+    REQUIRE(packing.countTotalOverlaps(lollipop, false) == 0);
+
+    constexpr double INF = std::numeric_limits<double>::infinity();
+
+    SECTION("small centres") {
+        CHECK(packing.tryTranslation(1, {-0.1, 0, 0}, lollipop) == INF);
+        CHECK(packing.tryTranslation(1, {-0.04, 0, 0}, lollipop) == 0);
+    }
+
+    SECTION("small and large centre through periodic boundary conditions") {
+        CHECK(packing.tryTranslation(2, {0.15, 0, 0}, lollipop) == INF);
+        CHECK(packing.tryTranslation(2, {0.05, 0, 0}, lollipop) == 0);
+    }
+
+    SECTION("small centres through periodic boundary conditions") {
+        CHECK(packing.tryRotation(3, Matrix<3, 3>::rotation(0, 0, M_PI), lollipop) == INF);
+    }
+
+    SECTION("after moves and scaling") {
+        REQUIRE(packing.tryTranslation(2, {0, 0, 2}, lollipop) == 0);
+        packing.acceptTranslation();
+        REQUIRE(packing.tryScaling({1.01, 1.01, 1.01}, lollipop) == 0);
+        packing.revertScaling();
+        REQUIRE(packing.tryScaling(1.3, lollipop) == 0);
+        packing.revertScaling();
+
+        CHECK(packing.tryTranslation(1, {-0.1, 0, 0}, lollipop) == INF);
+        CHECK(packing.tryTranslation(2, {0.15, 0, -2}, lollipop) == INF);
+        CHECK(packing.tryTranslation(2, {0.15, 0, 0}, lollipop) == 0);
+    }
+}
+
+TEST_CASE("Packing: neighbour grid cell subdivisions") {
+    double radius = 0.5;
+    SphereHardCoreInteraction hardCore(radius);
+    auto pbc = std::make_unique<PeriodicBoundaryConditions>();
+    std::vector<Shape> shapes{Shape{{1, 1, 1}}, Shape{{2.4, 1, 1}}, Shape{{9.8, 1, 1}}, Shape{{1.7, 1.7, 1.7}}};
+    Packing packing({10, 10, 10}, std::move(shapes), std::move(pbc), hardCore);
+    packing.setNeighbourGridCellSizeFactor(0.1);
+    REQUIRE(packing.getNeighbourGridCellDivisions() == std::array<std::size_t, 3>{10, 10, 10});
+
+    packing.setNeighbourGridCellSubdivisions(2);
+
+    CHECK(packing.getNeighbourGridCellSubdivisions() == 2);
+    // Subdivided cells are not reported
+    CHECK(packing.getNeighbourGridCellDivisions() == std::array<std::size_t, 3>{10, 10, 10});
+    CHECK(packing.countTotalOverlaps(hardCore) == 0);
+    CHECK(packing.tryTranslation(2, {0.3, 0, 0}, hardCore) == std::numeric_limits<double>::infinity());
+    CHECK(packing.tryTranslation(1, {-0.3, 0, 0}, hardCore) == 0);
+    CHECK(packing.tryTranslation(3, {-0.15, -0.15, -0.15}, hardCore) == std::numeric_limits<double>::infinity());
+    CHECK(packing.tryScaling(0.95, hardCore) == 0);
+    CHECK(packing.tryScaling(0.75, hardCore) == std::numeric_limits<double>::infinity());
+}
+
+TEST_CASE("Packing: lean neighbour grid") {
+    double radius = 0.5;
+    SphereHardCoreInteraction hardCore(radius);
+    auto pbc = std::make_unique<PeriodicBoundaryConditions>();
+    std::vector<Shape> shapes{Shape{{1, 1, 1}}, Shape{{2.4, 1, 1}}, Shape{{9.8, 1, 1}}};
+    Packing packing({10, 10, 10}, std::move(shapes), std::move(pbc), hardCore);
+    packing.setNeighbourGridCellSizeFactor(0.1);
+    REQUIRE(packing.getNeighbourGridCellDivisions() == std::array<std::size_t, 3>{10, 10, 10});
+    // Reject a scaling changing the number of cells to create the second neighbour grid
+    REQUIRE(packing.tryScaling(0.5, hardCore) == std::numeric_limits<double>::infinity());
+    packing.revertScaling();
+    std::size_t twoGridsMemory = packing.getNeighbourGridMemoryUsage();
+
+    packing.toggleLeanNeighbourGrid(true);
+
+    CHECK(packing.isNeighbourGridLean());
+    CHECK(packing.getNeighbourGridMemoryUsage() < twoGridsMemory);
+    CHECK(packing.tryScaling(0.5, hardCore) == std::numeric_limits<double>::infinity());
+    packing.revertScaling();
+    CHECK(packing.getNeighbourGridCellDivisions() == std::array<std::size_t, 3>{10, 10, 10});
+    CHECK(packing.getNeighbourGridMemoryUsage() < twoGridsMemory);
+    CHECK(packing.tryTranslation(2, {0.3, 0, 0}, hardCore) == std::numeric_limits<double>::infinity());
+    CHECK(packing.tryTranslation(1, {-0.3, 0, 0}, hardCore) == 0);
+    CHECK(packing.tryScaling(0.9, hardCore) == 0);
+    CHECK(packing.getNeighbourGridCellDivisions() == std::array<std::size_t, 3>{9, 9, 9});
+}
+
+TEST_CASE("Packing: separating direction cache") {
+    SmoothWedgeTraits traits(0.6, 0.4, 2);
+    const auto &interaction = traits.getInteraction();
+    std::vector<Shape> shapes;
+    for (std::size_t i{}; i < 8; i++)
+        for (std::size_t j{}; j < 8; j++)
+            for (std::size_t k{}; k < 5; k++)
+                shapes.emplace_back(Vector<3>{1.3*i + 0.5, 1.3*j + 0.5, 3.2*k + 1.6});
+    Packing cached({10.4, 10.4, 16}, shapes, std::make_unique<PeriodicBoundaryConditions>(), interaction);
+    Packing uncached({10.4, 10.4, 16}, shapes, std::make_unique<PeriodicBoundaryConditions>(), interaction);
+    for (auto packing : {&cached, &uncached}) {
+        packing->setVerletListSkin(0.4);
+        REQUIRE(packing->updateVerletLists());
+    }
+    REQUIRE(cached.countTotalOverlaps(interaction) == 0);
+    std::size_t uncachedMemory = cached.getNeighbourGridMemoryUsage();
+
+    cached.toggleSeparatingDirectionCache(true);
+
+    CHECK(cached.isSeparatingDirectionCacheEnabled());
+    CHECK(cached.getNeighbourGridMemoryUsage() > uncachedMemory);
+    // The same sequence of moves should give the same results with and without the cache
+    std::mt19937 mt(1234);
+    std::uniform_real_distribution<double> translationDist(-0.15, 0.15);
+    std::uniform_real_distribution<double> angleDist(-0.2, 0.2);
+    std::uniform_int_distribution<std::size_t> particleDist(0, shapes.size() - 1);
+    std::size_t acceptedMoves{};
+    for (std::size_t i{}; i < 1000; i++) {
+        std::size_t particleIdx = particleDist(mt);
+        Vector<3> translation{translationDist(mt), translationDist(mt), translationDist(mt)};
+        auto rotation = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+        double cachedDE = cached.tryMove(particleIdx, translation, rotation, interaction);
+        REQUIRE(cachedDE == uncached.tryMove(particleIdx, translation, rotation, interaction));
+        if (cachedDE == 0) {
+            cached.acceptMove();
+            uncached.acceptMove();
+            acceptedMoves++;
+        }
+        cached.updateVerletLists();
+        uncached.updateVerletLists();
+    }
+    CHECK(acceptedMoves > 0);
+    CHECK(acceptedMoves < 1000);
+    CHECK(cached.countTotalOverlaps(interaction) == 0);
+}
+
 TEST_CASE("Packing: named points dumping") {
     double radius = 0.5;
     SphereHardCoreInteraction hardCore(radius);
@@ -0,0 +1,96 @@
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "core/interactions/MoleculeInteraction.h"
+#include "core/interactions/LennardJonesInteraction.h"
+#include "core/shapes/PolysphereTraits.h"
+#include "core/PeriodicBoundaryConditions.h"
+
+#include "matchers/VectorApproxMatcher.h"
+
+
+namespace {
+    PolysphereTraits::PolysphereGeometry create_chain_geometry(std::size_t numSpheres) {
+        std::vector<PolysphereTraits::SphereData> spheres;
+        for (std::size_t i{}; i < numSpheres; i++)
+            spheres.emplace_back(Vector<3>{0, 0, static_cast<double>(i) - (numSpheres - 1) / 2.}, 0.5);
+        return PolysphereTraits::PolysphereGeometry(std::move(spheres));
+    }
+}
+
+
+TEST_CASE("MoleculeInteraction: hard chains") {
+    PolysphereTraits traits(create_chain_geometry(10));
+    const Interaction &interaction = traits.getInteraction();
+    MoleculeInteraction moleculeInteraction(interaction);
+    PeriodicBoundaryConditions pbc(20);
+
+    SECTION("basic features") {
+        CHECK(moleculeInteraction.hasHardPart());
+        CHECK_FALSE(moleculeInteraction.hasSoftPart());
+        CHECK(moleculeInteraction.hasWallPart());
+        CHECK(moleculeInteraction.getInteractionCentres().empty());
+        CHECK(moleculeInteraction.getRangeRadius() == Approx(interaction.getTotalRangeRadius()));
+        CHECK_THAT(moleculeInteraction.getAxis(), IsApproxEqual({0, 0, 1}, 1e-12));
+    }
+
+    SECTION("overlap through periodic boundary") {
+        Shape shape1({0.2, 5, 5});
+        Shape shape2({19.21, 5, 8});
+        Shape shape3({19.19, 5, 8});
+
+        CHECK(moleculeInteraction.overlapBetween(shape1.getPosition(), shape1.getOrientation(), 0,
+                                                 shape2.getPosition(), shape2.getOrientation(), 0, pbc));
+        CHECK_FALSE(moleculeInteraction.overlapBetween(shape1.getPosition(), shape1.getOrientation(), 0,
+                                                       shape3.getPosition(), shape3.getOrientation(), 0, pbc));
+    }
+
+    SECTION("agrees with centre-by-centre test") {
+        std::mt19937 mt(1234);
+        std::uniform_real_distribution<double> posDist(0, 6);
+        std::uniform_real_distribution<double> angleDist(0, 2*M_PI);
+        std::size_t overlaps{};
+        for (std::size_t i{}; i < 1000; i++) {
+            Shape shape1({posDist(mt), posDist(mt), posDist(mt)},
+                         Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt)));
+            Shape shape2({posDist(mt), posDist(mt), posDist(mt)},
+                         Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt)));
+
+            bool overlap = interaction.overlapBetweenShapes(shape1, shape2, pbc);
+            CHECK(moleculeInteraction.overlapBetweenShapes(shape1, shape2, pbc) == overlap);
+            overlaps += overlap;
+        }
+        // Make sure that both cases are well represented
+        CHECK(overlaps > 100);
+        CHECK(overlaps < 900);
+    }
+
+    SECTION("wall overlap") {
+        Shape shape({5, 5, 0.49}, Matrix<3, 3>::rotation(M_PI/2, 0, 0));
+        Shape shape2({5, 5, 0.51}, Matrix<3, 3>::rotation(M_PI/2, 0, 0));
+
+        CHECK(moleculeInteraction.overlapWithWallForShape(shape, {0, 0, 0}, {0, 0, 1}));
+        CHECK_FALSE(moleculeInteraction.overlapWithWallForShape(shape2, {0, 0, 0}, {0, 0, 1}));
+        CHECK(moleculeInteraction.overlapWithWallForShape(shape2, {0, 0, 1}, {0, 0, 1}));
+    }
+}
+
+TEST_CASE("MoleculeInteraction: soft chains") {
+    auto lj = std::make_shared<LennardJonesInteraction>(1, 1);
+    PolysphereTraits traits(create_chain_geometry(3), lj);
+    const Interaction &interaction = traits.getInteraction();
+    MoleculeInteraction moleculeInteraction(interaction);
+    PeriodicBoundaryConditions pbc(20);
+
+    CHECK(moleculeInteraction.hasSoftPart());
+    CHECK_FALSE(moleculeInteraction.hasHardPart());
+
+    // All pairs of centres are within the range 3 of LJ
+    Shape shape1({5, 5, 5});
+    Shape shape2({5.8, 5, 5.1});
+    CHECK(moleculeInteraction.calculateEnergyBetweenShapes(shape1, shape2, pbc)
+          == Approx(interaction.calculateEnergyBetweenShapes(shape1, shape2, pbc)));
+
+    Shape farShape({8.5, 5, 5});
+    CHECK(moleculeInteraction.calculateEnergyBetweenShapes(shape1, farShape, pbc) == 0);
+}
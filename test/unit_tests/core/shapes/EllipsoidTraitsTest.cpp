@@ -0,0 +1,103 @@
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "core/shapes/EllipsoidTraits.h"
+#include "core/FreeBoundaryConditions.h"
+#include "core/PeriodicBoundaryConditions.h"
+#include "geometry/xenocollide/XCPrimitives.h"
+#include "geometry/xenocollide/XenoCollide.h"
+
+#include "matchers/VectorApproxMatcher.h"
+
+
+TEST_CASE("Ellipsoid: overlap") {
+    FreeBoundaryConditions fbc;
+
+    SECTION("spheres") {
+        EllipsoidTraits traits(1, 1, 1);
+        auto rotation = Matrix<3, 3>::rotation(0.3, 0.4, 0.5);
+
+        CHECK(traits.overlapBetweenShapes(Shape({0, 0, 0}, rotation), Shape({1.99, 0, 0}, rotation), fbc));
+        CHECK_FALSE(traits.overlapBetweenShapes(Shape({0, 0, 0}, rotation), Shape({2.01, 0, 0}, rotation), fbc));
+    }
+
+    SECTION("side by side and end to end") {
+        EllipsoidTraits traits(0.5, 1, 3);
+
+        CHECK(traits.overlapBetweenShapes(Shape({0, 0, 0}), Shape({0.99, 0, 0}), fbc));
+        CHECK_FALSE(traits.overlapBetweenShapes(Shape({0, 0, 0}), Shape({1.01, 0, 0}), fbc));
+        CHECK(traits.overlapBetweenShapes(Shape({0, 0, 0}), Shape({0, 0, 5.99}), fbc));
+        CHECK_FALSE(traits.overlapBetweenShapes(Shape({0, 0, 0}), Shape({0, 0, 6.01}), fbc));
+    }
+
+    SECTION("T-shape") {
+        EllipsoidTraits traits(0.5, 1, 3);
+        Shape ellipsoid1({0, 0, 0});
+        // The second ellipsoid is lying along x axis above the first one
+        auto rotation = Matrix<3, 3>::rotation(0, M_PI/2, 0);
+
+        CHECK(traits.overlapBetweenShapes(ellipsoid1, Shape({0, 0, 3.49}, rotation), fbc));
+        CHECK_FALSE(traits.overlapBetweenShapes(ellipsoid1, Shape({0, 0, 3.51}, rotation), fbc));
+    }
+
+    SECTION("boundary conditions") {
+        EllipsoidTraits traits(0.5, 1, 3);
+        PeriodicBoundaryConditions pbc(10);
+
+        CHECK(traits.overlapBetweenShapes(Shape({0.2, 5, 5}), Shape({9.21, 5, 5}), pbc));
+        CHECK_FALSE(traits.overlapBetweenShapes(Shape({0.2, 5, 5}), Shape({9.19, 5, 5}), pbc));
+    }
+
+    SECTION("agrees with XenoCollide") {
+        Vector<3> semiAxes{0.5, 1, 2};
+        EllipsoidTraits traits(semiAxes[0], semiAxes[1], semiAxes[2]);
+        XCEllipsoid xcEllipsoid(semiAxes);
+
+        std::mt19937 mt(1234);
+        std::uniform_real_distribution<double> posDist(-2.5, 2.5);
+        std::uniform_real_distribution<double> angleDist(0, 2*M_PI);
+        for (std::size_t i{}; i < 1000; i++) {
+            Vector<3> pos1{posDist(mt), posDist(mt), posDist(mt)};
+            Vector<3> pos2{posDist(mt), posDist(mt), posDist(mt)};
+            auto rot1 = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+            auto rot2 = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+
+            bool xcOverlap = XenoCollide<AbstractXCGeometry>::Intersect(xcEllipsoid, rot1, pos1, xcEllipsoid, rot2,
+                                                                        pos2, 1e-12);
+            CHECK(traits.overlapBetween(pos1, rot1, 0, pos2, rot2, 0, fbc) == xcOverlap);
+        }
+    }
+}
+
+TEST_CASE("Ellipsoid: wall overlap") {
+    EllipsoidTraits traits(0.5, 1, 3);
+    const Interaction &interaction = traits.getInteraction();
+    // The longest semi-axis points along the wall normal
+    auto rotation = Matrix<3, 3>::rotation(0, M_PI/2, 0);
+
+    CHECK(interaction.hasWallPart());
+    CHECK(interaction.overlapWithWallForShape(Shape({2.99, 5, 5}, rotation), {0, 0, 0}, {1, 0, 0}));
+    CHECK_FALSE(interaction.overlapWithWallForShape(Shape({3.01, 5, 5}, rotation), {0, 0, 0}, {1, 0, 0}));
+    CHECK(interaction.overlapWithWallForShape(Shape({5, 5, 0.49}, rotation), {0, 0, 0}, {0, 0, 1}));
+    CHECK_FALSE(interaction.overlapWithWallForShape(Shape({5, 5, 0.51}, rotation), {0, 0, 0}, {0, 0, 1}));
+}
+
+TEST_CASE("Ellipsoid: basic features") {
+    EllipsoidTraits traits(0.5, 1, 3);
+    Shape shape({}, Matrix<3, 3>::rotation(0, M_PI/2, 0));
+
+    CHECK(traits.getVolume() == Approx(2 * M_PI));
+    CHECK(traits.getRangeRadius() == 6);
+    CHECK_THAT(traits.getPrimaryAxis(shape), IsApproxEqual({1, 0, 0}, 1e-12));
+    CHECK_THAT(traits.getSecondaryAxis(shape), IsApproxEqual({0, 0, -1}, 1e-12));
+    CHECK(traits.getGeometry().getNamedPointForShape("cm", {}) == Vector<3>{0, 0, 0});
+}
+
+TEST_CASE("Ellipsoid: toWolfram") {
+    EllipsoidTraits traits(0.5, 1, 3);
+    Shape shape({2, 4, 6});
+
+    auto printer = traits.getPrinter("wolfram", {});
+    CHECK(printer->print(shape) == "Ellipsoid[{2.000000, 4.000000, 6.000000},{{0.250000, 0.000000, 0.000000},"
+                                   "{0.000000, 1.000000, 0.000000},{0.000000, 0.000000, 9.000000}}]");
+}
@@ -75,6 +75,8 @@ TEST_CASE("XenoCollide: spherocylinder overlap") {
     FreeBoundaryConditions fbc;
     double l = 3, r = 2;
     XenoCollideSpherocylinderTraits traits(l, r);
+    auto narrowPhase = GENERATE(XCNarrowPhase::MPR, XCNarrowPhase::GJK);
+    traits.setNarrowPhase(narrowPhase);
 
     Shape sc1{};
     Shape sc2{};
@@ -293,4 +295,21 @@ TEST_CASE("XenoCollide: dimer ranges") {
 
     CHECK(interaction.getRangeRadius() == 2);
     CHECK(interaction.getTotalRangeRadius() == 8);
-}
\ No newline at end of file
+}
+TEST_CASE("XenoCollide: narrow phase selection") {
+    XenoCollideSpherocylinderTraits traits(3, 2);
+    CHECK(traits.getNarrowPhase() == XCNarrowPhase::MPR);
+
+    traits.setNarrowPhase(XCNarrowPhase::GJK);
+    CHECK(traits.getNarrowPhaseName() == "gjk");
+
+    // The choice is deterministic
+    XCNarrowPhase narrowPhase = traits.calibrateNarrowPhase();
+    CHECK(traits.getNarrowPhase() == narrowPhase);
+    traits.setNarrowPhase(narrowPhase == XCNarrowPhase::MPR ? XCNarrowPhase::GJK : XCNarrowPhase::MPR);
+    CHECK(traits.calibrateNarrowPhase() == narrowPhase);
+
+    const auto *selector = dynamic_cast<const XCNarrowPhaseSelector *>(&traits.getInteraction());
+    REQUIRE(selector != nullptr);
+    CHECK(selector->getNarrowPhase() == narrowPhase);
+}
@@ -5,6 +5,7 @@
 #include <catch2/catch.hpp>
 
 #include "matchers/VectorApproxMatcher.h"
+#include "matchers/MatrixApproxMatcher.h"
 
 #include "geometry/Quaternion.h"
 
@@ -32,4 +33,20 @@ TEST_CASE("Quaterion") {
         auto q = Quaternion::fromMatrix(Matrix<3, 3>::rotation(axis, angle));
         CHECK_THAT(q, IsApproxEqual(expected, 1e-14));
     }
-}
\ No newline at end of file
+}
+
+TEST_CASE("Quaternion: to matrix") {
+    auto rotation = Matrix<3, 3>::rotation(Vector<3>{1, 2, 3}.normalized(), 1.2);
+    auto q = Quaternion::fromMatrix(rotation);
+
+    CHECK_THAT(Quaternion::toMatrix(q), IsApproxEqual(rotation, 1e-14));
+}
+
+TEST_CASE("Quaternion: multiplication") {
+    auto rotation1 = Matrix<3, 3>::rotation(Vector<3>{1, 2, 3}.normalized(), 1.2);
+    auto rotation2 = Matrix<3, 3>::rotation(Vector<3>{-1, 0, 2}.normalized(), 0.4);
+    auto q1 = Quaternion::fromMatrix(rotation1);
+    auto q2 = Quaternion::fromMatrix(rotation2);
+
+    CHECK_THAT(Quaternion::toMatrix(Quaternion::multiply(q1, q2)), IsApproxEqual(rotation1 * rotation2, 1e-14));
+}
@@ -0,0 +1,45 @@
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "geometry/xenocollide/GJK.h"
+#include "geometry/xenocollide/XenoCollide.h"
+#include "geometry/xenocollide/XCBodyBuilder.h"
+
+
+TEST_CASE("GJK: agrees with XenoCollide") {
+    auto command = GENERATE(as<std::string>{}, "cuboid 1 2 0.5", "football 2 0.5", "ellipsoid 1 0.5 0.3");
+    DYNAMIC_SECTION(command) {
+        XCBodyBuilder builder;
+        builder.processCommand(command);
+        builder.processCommand("sphere 0.1");
+        builder.processCommand("sum");
+        auto geometry = builder.releaseCollideGeometry();
+
+        std::mt19937 mt(1234);
+        std::uniform_real_distribution<double> posDist(-2, 2);
+        std::uniform_real_distribution<double> angleDist(0, 2*M_PI);
+        std::size_t numOverlaps{};
+        for (std::size_t i{}; i < 1000; i++) {
+            Vector<3> pos1{posDist(mt), posDist(mt), posDist(mt)};
+            Vector<3> pos2{posDist(mt), posDist(mt), posDist(mt)};
+            auto rot1 = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+            auto rot2 = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+
+            Vector<3> separatingDirection;
+            bool gjkResult = GJK<AbstractXCGeometry>::Intersect(*geometry, rot1, pos1, *geometry, rot2, pos2, 1e-12,
+                                                                &separatingDirection);
+            bool mprResult = XenoCollide<AbstractXCGeometry>::Intersect(*geometry, rot1, pos1, *geometry, rot2, pos2,
+                                                                        1e-12);
+            CHECK(gjkResult == mprResult);
+            if (!gjkResult) {
+                CHECK(XenoCollide<AbstractXCGeometry>::AreSeparatedAlong(*geometry, rot1, pos1, *geometry, rot2, pos2,
+                                                                         separatingDirection));
+            }
+            numOverlaps += gjkResult;
+        }
+
+        // Both cases should be well represented
+        CHECK(numOverlaps > 50);
+        CHECK(numOverlaps < 950);
+    }
+}
@@ -0,0 +1,72 @@
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "matchers/VectorApproxMatcher.h"
+
+#include "geometry/xenocollide/XCBoundingBox.h"
+#include "geometry/xenocollide/XCPrimitives.h"
+#include "geometry/xenocollide/XenoCollide.h"
+#include "core/shapes/SmoothWedgeTraits.h"
+
+
+TEST_CASE("XCBoundingBox: for geometry") {
+    SECTION("cuboid") {
+        auto box = XCBoundingBox::forGeometry(XCCuboid({1, 2, 3}));
+
+        CHECK_THAT(box.getCenter(), IsApproxEqual({0, 0, 0}, 1e-12));
+        CHECK_THAT(box.getHalfExtents(), IsApproxEqual({1, 2, 3}, 1e-12));
+    }
+
+    SECTION("smooth wedge") {
+        SmoothWedgeTraits::CollideGeometry wedge(2, 1, 3);
+        const auto &box = wedge.getBoundingBox();
+
+        // Spheres are in {0, 0, -1} and {0, 0, 2}
+        CHECK_THAT(box.getCenter(), IsApproxEqual({0, 0, 0}, 1e-12));
+        CHECK_THAT(box.getHalfExtents(), IsApproxEqual({2, 2, 3}, 1e-12));
+    }
+}
+
+TEST_CASE("XCBoundingBox: separation") {
+    XCBoundingBox box1({0, 0, 0}, {0.5, 1, 0.1});
+    XCBoundingBox box2({0, 0, 0.5}, {0.5, 0.5, 0.5});
+    auto identity = Matrix<3, 3>::identity();
+
+    SECTION("face-face") {
+        CHECK(XCBoundingBox::areSeparated(box1, identity, {0, 0, 0}, box2, identity, {0, 0, 0.11}));
+        CHECK_FALSE(XCBoundingBox::areSeparated(box1, identity, {0, 0, 0}, box2, identity, {0, 0, 0.09}));
+    }
+
+    SECTION("edge-edge") {
+        // The top edge of the first cube (along x) and the bottom edge of the second one (along y) are crossed, so
+        // the cubes are separated only along the cross product of their directions
+        auto rotation1 = Matrix<3, 3>::rotation(M_PI/4, 0, 0);
+        auto rotation2 = Matrix<3, 3>::rotation(0, M_PI/4, 0);
+        XCBoundingBox cube({0, 0, 0}, {0.5, 0.5, 0.5});
+        double distance = 2 * M_SQRT1_2;
+
+        CHECK(XCBoundingBox::areSeparated(cube, rotation1, {0, 0, 0}, cube, rotation2, {0, 0, distance + 0.01}));
+        CHECK_FALSE(XCBoundingBox::areSeparated(cube, rotation1, {0, 0, 0}, cube, rotation2,
+                                                {0, 0, distance - 0.01}));
+    }
+
+    SECTION("agrees with XenoCollide") {
+        std::mt19937 mt(1234);
+        std::uniform_real_distribution<double> posDist(-2, 2);
+        std::uniform_real_distribution<double> angleDist(0, 2*M_PI);
+        XCCuboid cuboid1({0.5, 1, 0.1});
+        XCCuboid cuboid2({0.5, 0.5, 0.5});
+        Vector<3> center2{0, 0, 0.5};
+        for (std::size_t i{}; i < 1000; i++) {
+            Vector<3> pos1{posDist(mt), posDist(mt), posDist(mt)};
+            Vector<3> pos2{posDist(mt), posDist(mt), posDist(mt)};
+            auto rot1 = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+            auto rot2 = Matrix<3, 3>::rotation(angleDist(mt), angleDist(mt), angleDist(mt));
+
+            bool separated = XCBoundingBox::areSeparated(box1, rot1, pos1, box2, rot2, pos2);
+            bool intersect = XenoCollide<AbstractXCGeometry>::Intersect(cuboid1, rot1, pos1,
+                                                                        cuboid2, rot2, pos2 + rot2*center2, 1e-12);
+            CHECK(separated == !intersect);
+        }
+    }
+}
@@ -0,0 +1,92 @@
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "matchers/VectorApproxMatcher.h"
+
+#include "geometry/xenocollide/XCPolytope.h"
+#include "geometry/xenocollide/XCBodyBuilder.h"
+#include "geometry/xenocollide/XCOperations.h"
+
+
+TEST_CASE("XCPolytope: cube") {
+    std::vector<Vector<3>> points{{0.5, 0.5, 0.5}, {0.5, 0.5, -0.5}, {0.5, -0.5, 0.5}, {0.5, -0.5, -0.5},
+                                  {-0.5, 0.5, 0.5}, {-0.5, 0.5, -0.5}, {-0.5, -0.5, 0.5}, {-0.5, -0.5, -0.5},
+                                  {0.1, 0.2, 0.3}, {0, 0, 0}};
+
+    XCPolytope polytope(points);
+
+    CHECK(polytope.getVertices().size() == 8);
+    CHECK_FALSE(polytope.usesHillClimbing());
+    CHECK(polytope.getInsphereRadius() == Approx(0.5));
+    CHECK(polytope.getCircumsphereRadius() == Approx(std::sqrt(3)/2));
+    CHECK_THAT(polytope.getCenter(), IsApproxEqual({0, 0, 0}, 1e-12));
+    CHECK_THAT(polytope.getSupportPoint({1, -2, 3}), IsApproxEqual({0.5, -0.5, 0.5}, 1e-12));
+}
+
+TEST_CASE("XCPolytope: flat") {
+    XCPolytope polytope({{1, 1, 0}, {1, -1, 0}, {-1, 1, 0}, {-1, -1, 0}, {0, 0, 0}}, {0, 0, 0});
+
+    CHECK_FALSE(polytope.usesHillClimbing());
+    CHECK(polytope.getInsphereRadius() == 0);
+    CHECK(polytope.getCircumsphereRadius() == Approx(std::sqrt(2)));
+    CHECK_THAT(polytope.getSupportPoint({1, -2, 3}), IsApproxEqual({1, -1, 0}, 1e-12));
+}
+
+TEST_CASE("XCPolytope: hill-climbing") {
+    std::mt19937 mt(1234);
+    std::normal_distribution<double> normal;
+    std::vector<Vector<3>> points;
+    for (std::size_t i{}; i < 60; i++)
+        points.push_back(Vector<3>{normal(mt), normal(mt), normal(mt)}.normalized());
+    // Points inside should be discarded
+    for (std::size_t i{}; i < 20; i++)
+        points.push_back(0.5 * Vector<3>{normal(mt), normal(mt), normal(mt)}.normalized());
+
+    XCPolytope polytope(points);
+
+    REQUIRE(polytope.usesHillClimbing());
+    CHECK(polytope.getVertices().size() == 60);
+    CHECK(polytope.getCircumsphereRadius() == Approx(1));
+    CHECK(polytope.getInsphereRadius() > 0.5);
+    CHECK(polytope.getInsphereRadius() < 1);
+    for (std::size_t i{}; i < 200; i++) {
+        Vector<3> n{normal(mt), normal(mt), normal(mt)};
+        auto support = std::max_element(points.begin(), points.end(), [&n](const auto &p1, const auto &p2) {
+            return p1 * n < p2 * n;
+        });
+        double maxProjection = *support * n;
+        CHECK(polytope.getSupportPoint(n) * n == Approx(maxProjection));
+    }
+}
+
+TEST_CASE("XCPolytope: XCBodyBuilder::wrap") {
+    XCBodyBuilder builder;
+
+    SECTION("polytopes") {
+        builder.processCommand("segment 1");
+        builder.processCommand("move 0 0.5 0");
+        builder.processCommand("cuboid 1 1 1");
+        builder.processCommand("rot 0 0 45");
+        builder.processCommand("move 0 -1 0");
+        builder.processCommand("point 0 0 2");
+        builder.processCommand("point 0 0 -2");
+        builder.processCommand("wrap 4");
+        auto geometry = builder.releaseCollideGeometry();
+
+        const auto *polytope = dynamic_cast<const XCPolytope *>(geometry.get());
+        REQUIRE(polytope != nullptr);
+        // Vertices of the cuboid pointing towards the segment lie inside the hull
+        CHECK(polytope->getVertices().size() == 10);
+        CHECK_THAT(polytope->getSupportPoint({0, 0, 1}), IsApproxEqual({0, 0, 2}, 1e-12));
+        CHECK_THAT(polytope->getSupportPoint({1, 0, 0.1}), IsApproxEqual({std::sqrt(0.5), -1, 0.5}, 1e-12));
+    }
+
+    SECTION("other shapes") {
+        builder.processCommand("segment 1");
+        builder.processCommand("sphere 1");
+        builder.processCommand("wrap");
+        auto geometry = builder.releaseCollideGeometry();
+
+        CHECK(dynamic_cast<const XCMax *>(geometry.get()) != nullptr);
+    }
+}
@@ -0,0 +1,138 @@
+#include <catch2/catch.hpp>
+#include <random>
+
+#include "matchers/VectorApproxMatcher.h"
+
+#include "geometry/xenocollide/XCSupportProgram.h"
+#include "geometry/xenocollide/XCBodyBuilder.h"
+#include "geometry/xenocollide/XCOperations.h"
+
+
+namespace {
+    std::shared_ptr<AbstractXCGeometry> build(const std::vector<std::string> &commands) {
+        XCBodyBuilder builder;
+        for (const auto &command : commands)
+            builder.processCommand(command);
+        return builder.releaseCollideGeometry();
+    }
+
+    void check_support_points(const AbstractXCGeometry &geometry, const XCSupportProgram &program) {
+        std::mt19937 mt(1234);
+        std::normal_distribution<double> dist;
+        for (std::size_t i{}; i < 100; i++) {
+            Vector<3> n{dist(mt), dist(mt), dist(mt)};
+            CHECK_THAT(program.getSupportPoint(n), IsApproxEqual(geometry.getSupportPoint(n), 1e-12));
+        }
+        CHECK_THAT(program.getCenter(), IsApproxEqual(geometry.getCenter(), 1e-12));
+        CHECK(program.getInsphereRadius() == Approx(geometry.getInsphereRadius()));
+        CHECK(program.getCircumsphereRadius() == Approx(geometry.getCircumsphereRadius()));
+    }
+}
+
+TEST_CASE("XCSupportProgram: primitive") {
+    auto geometry = build({"cuboid 1 2 3"});
+    XCSupportProgram program(geometry);
+
+    check_support_points(*geometry, program);
+    CHECK(program.getProgramSize() == 1);
+}
+
+TEST_CASE("XCSupportProgram: nested sums and differences are flattened") {
+    auto geometry = build({"sphere 0.5", "segment 2", "rot 30 0 45", "move 1 0 0", "sum", "move 0.5 0.5 0",
+                           "ellipsoid 1 2 3", "rot 0 20 0", "diff", "rot 10 10 10", "point 1 2 3", "sum"});
+    XCSupportProgram program(geometry);
+
+    check_support_points(*geometry, program);
+    // 4 leaves and a single sum
+    CHECK(program.getProgramSize() == 5);
+}
+
+TEST_CASE("XCSupportProgram: convex hulls") {
+    auto geometry = build({"segment 1", "move 0 0.5 0", "segment 1", "move -0.5 -0.5 0", "dup 1", "move 1 0 0",
+                           "rot 0 0 30", "wrap", "disk 0.3", "rot 90 0 0", "sum", "wrap", "saucer 1 0.4",
+                           "football 2 0.5", "rot 0 45 0", "move 0 0 1", "wrap 2", "sum"});
+    XCSupportProgram program(geometry);
+
+    check_support_points(*geometry, program);
+}
+
+TEST_CASE("XCSupportProgram: unknown geometry") {
+    auto sphere = std::make_shared<XCSphere>(0.5);
+    auto adapter = std::make_shared<PolymorphicXCAdapter<XCEllipsoid>>(XCEllipsoid({1, 2, 3}));
+    auto geometry = std::make_shared<XCMax>(sphere, Vector<3>{0, 0, 3}, adapter, Vector<3>{0, 0, -1});
+    XCSupportProgram program(geometry);
+
+    check_support_points(*geometry, program);
+    CHECK(program.getNumberOfGenericLeaves() == 1);
+}
+
+TEST_CASE("XCSupportProgram: fitted bounding spheres") {
+    SECTION("shape far from the origin") {
+        auto geometry = build({"sphere 1", "move 3 0 0", "point 0 0 0", "sum"});
+        XCSupportProgram program(geometry);
+
+        Vector<3> center = program.fitBoundingSpheres();
+
+        CHECK_THAT(center, IsApproxEqual({3, 0, 0}, 1e-3));
+        CHECK(program.getCircumsphereRadius() == Approx(1).margin(0.01));
+        CHECK(program.getInsphereRadius() == Approx(1).margin(0.05));
+        CHECK(program.getInsphereRadius() <= 1);
+        CHECK(program.getCircumsphereRadius() >= 1);
+        CHECK_THAT(program.getSupportPoint({1, 0, 0}), IsApproxEqual(Vector<3>{4, 0, 0} - center, 1e-12));
+    }
+
+    SECTION("centered shape is not moved") {
+        auto geometry = build({"cuboid 1 2 3"});
+        XCSupportProgram program(geometry);
+
+        CHECK(program.fitBoundingSpheres() == Vector<3>{0, 0, 0});
+        check_support_points(*geometry, program);
+    }
+
+    SECTION("composite shape") {
+        auto geometry = build({"sphere 0.5", "move 0 0 -0.5", "cuboid 1 1 1", "rot 45 0 0", "move 0 0 0.5", "wrap",
+                               "segment 1", "sum", "move 0.3 0.2 0.7"});
+        XCSupportProgram program(geometry);
+
+        Vector<3> center = program.fitBoundingSpheres();
+
+        // The radii are at least as tight as the conservative ones and the bounds hold for all directions
+        CHECK(program.getCircumsphereRadius() < geometry->getCircumsphereRadius());
+        std::mt19937 mt(1234);
+        std::normal_distribution<double> dist;
+        for (std::size_t i{}; i < 1000; i++) {
+            Vector<3> n = Vector<3>{dist(mt), dist(mt), dist(mt)}.normalized();
+            Vector<3> support = program.getSupportPoint(n);
+            CHECK_THAT(support, IsApproxEqual(geometry->getSupportPoint(n) - center, 1e-12));
+            CHECK(support.norm() <= program.getCircumsphereRadius());
+            CHECK(support * n >= program.getInsphereRadius());
+        }
+    }
+
+    SECTION("directions between the fitting grid points") {
+        auto geometry = build({"segment 4", "rot 17 31 0", "move 1 0.5 0", "sphere 0.2", "sum"});
+        XCSupportProgram program(geometry);
+
+        program.fitBoundingSpheres();
+
+        // The fitting grid has 48 divisions per cube face, so the grid twice as dense contains all midpoints between
+        // the fitting directions, which are furthest from them
+        constexpr std::size_t k = 2 * 48;
+        for (std::size_t axis{}; axis < 3; axis++) {
+            for (double sign : {-1., 1.}) {
+                for (std::size_t i{}; i <= k; i++) {
+                    for (std::size_t j{}; j <= k; j++) {
+                        Vector<3> n;
+                        n[axis] = sign;
+                        n[(axis + 1) % 3] = -1 + 2. * static_cast<double>(i) / k;
+                        n[(axis + 2) % 3] = -1 + 2. * static_cast<double>(j) / k;
+                        n = n.normalized();
+                        Vector<3> support = program.getSupportPoint(n);
+                        REQUIRE(support.norm() <= program.getCircumsphereRadius());
+                        REQUIRE(support * n >= program.getInsphereRadius());
+                    }
+                }
+            }
+        }
+    }
+}
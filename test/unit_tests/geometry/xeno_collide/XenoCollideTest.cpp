@@ -0,0 +1,36 @@
+#include <catch2/catch.hpp>
+
+#include "geometry/xenocollide/XenoCollide.h"
+#include "geometry/xenocollide/XCPrimitives.h"
+
+
+TEST_CASE("XenoCollide: separating direction") {
+    using XC = XenoCollide<AbstractXCGeometry>;
+    XCCuboid cube({0.5, 0.5, 0.5});
+    auto identity = Matrix<3, 3>::identity();
+    Vector<3> pos1{0, 0, 0};
+    Vector<3> pos2{1.5, 0.2, 0.1};
+
+    Vector<3> separatingDirection;
+    REQUIRE_FALSE(XC::Intersect(cube, identity, pos1, cube, identity, pos2, 1e-12, &separatingDirection));
+
+    CHECK(separatingDirection != Vector<3>{});
+    CHECK(XC::AreSeparatedAlong(cube, identity, pos1, cube, identity, pos2, separatingDirection));
+    // Still separated after a small move
+    auto rotation = Matrix<3, 3>::rotation(0.05, 0.05, 0.05);
+    CHECK(XC::AreSeparatedAlong(cube, rotation, {0.05, 0, 0}, cube, identity, pos2, separatingDirection));
+    // Not separated after the overlap
+    CHECK_FALSE(XC::AreSeparatedAlong(cube, identity, {0.6, 0, 0}, cube, identity, pos2, separatingDirection));
+    // Not a separating direction
+    CHECK_FALSE(XC::AreSeparatedAlong(cube, identity, pos1, cube, identity, pos2, {0, 0, 1}));
+}
+
+TEST_CASE("XenoCollide: separating direction is not changed on hit") {
+    using XC = XenoCollide<AbstractXCGeometry>;
+    XCCuboid cube({0.5, 0.5, 0.5});
+    auto identity = Matrix<3, 3>::identity();
+    Vector<3> separatingDirection{1, 2, 3};
+
+    CHECK(XC::Intersect(cube, identity, {0, 0, 0}, cube, identity, {0.9, 0.3, 0}, 1e-12, &separatingDirection));
+    CHECK(separatingDirection == Vector<3>{1, 2, 3});
+}